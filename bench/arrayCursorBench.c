@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../cJSON/cJSON.h"
+
+// Walking a "people" array with cJSON_GetArrayItem(i) versus cJSON_ArrayCursor, and
+// with cJSON_GetArrayItem(i) again once cJSON_SetArrayIndexThreshold makes it O(1).
+// Usage: arrayCursorBench.exe [--full]
+// Without --full the plain indexed walk is skipped above 100k people, it is quadratic.
+
+#define ARRAY_INDEX_THRESHOLD 16
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Build {"people": [...]} with num_people records shaped like src/data.json
+static cJSON *makePeople(int num_people) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON *people = cJSON_AddArrayToObject(root, "people");
+    for (int i = 0; i < num_people; ++i) {
+        cJSON *person = cJSON_CreateObject();
+        cJSON_AddNumberToObject(person, "id", i + 1);
+        cJSON_AddStringToObject(person, "name", "Jane Doe");
+        cJSON_AddNumberToObject(person, "age", 20 + i % 50);
+        cJSON_AddStringToObject(person, "hobby", "programming");
+        cJSON_AddNumberToObject(person, "salary", 30000.5 + i);
+        cJSON_AddStringToObject(person, "job", "Programmer");
+        cJSON_AddStringToObject(person, "address", "Znojmo");
+        cJSON_AddItemToArray(people, person);
+    }
+    return root;
+}
+
+// The old loadData loop
+static long walkIndexed(const cJSON *people) {
+    long sum = 0;
+    int size = cJSON_GetArraySize(people);
+    for (int i = 0; i < size; ++i) {
+        cJSON *id = cJSON_GetObjectItem(cJSON_GetArrayItem(people, i), "id");
+        sum += id->valueint;
+    }
+    return sum;
+}
+
+// The new loadData loop
+static long walkCursor(const cJSON *people) {
+    long sum = 0;
+    cJSON_ArrayCursor cursor;
+    cJSON *person = NULL;
+    cJSON_ArrayCursorInit(&cursor, people);
+    while ((person = cJSON_ArrayCursorNext(&cursor)) != NULL) {
+        sum += cJSON_GetObjectItem(person, "id")->valueint;
+    }
+    return sum;
+}
+
+int main(int argc, char **argv) {
+    int full = argc > 1 && strcmp(argv[1], "--full") == 0;
+    const int sizes[] = { 10000, 100000, 1000000 };
+
+    printf("%10s %16s %16s %16s\n", "people", "GetArrayItem [s]", "cursor [s]", "vector [s]");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        cJSON *root = makePeople(sizes[s]);
+        const cJSON *people = cJSON_GetObjectItem(root, "people");
+
+        double start = now();
+        long cursor_sum = walkCursor(people);
+        double cursor_time = now() - start;
+
+        double indexed_time = -1.0;
+        if (sizes[s] <= 100000 || full) {
+            start = now();
+            long indexed_sum = walkIndexed(people);
+            indexed_time = now() - start;
+            if (indexed_sum != cursor_sum) {
+                fprintf(stderr, "Walks disagree.\n");
+                return 1;
+            }
+        }
+
+        // Last, the array keeps its vector. The first call builds it, so that is part of the time.
+        cJSON_SetArrayIndexThreshold(ARRAY_INDEX_THRESHOLD);
+        start = now();
+        long vector_sum = walkIndexed(people);
+        double vector_time = now() - start;
+        cJSON_SetArrayIndexThreshold(0);
+        if (vector_sum != cursor_sum) {
+            fprintf(stderr, "Walks disagree.\n");
+            return 1;
+        }
+
+        if (indexed_time >= 0.0) {
+            printf("%10d %16.4f %16.4f %16.4f\n", sizes[s], indexed_time, cursor_time, vector_time);
+        } else {
+            printf("%10d %16s %16.4f %16.4f\n", sizes[s], "skipped", cursor_time, vector_time);
+        }
+
+        cJSON_Delete(root);
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../cJSON/cJSON.h"
+#include "../inc/func.h"
+#include "../inc/keyTable.h"
+
+// Summing "salary" over every person: Person[] with findKeyValue versus a column.
+// Usage: columnScanBench.exe
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// One record shaped like src/data.json
+static cJSON *makePerson(int i) {
+    cJSON *person = cJSON_CreateObject();
+    cJSON_AddNumberToObject(person, "id", i + 1);
+    cJSON_AddStringToObject(person, "name", "Jane Doe");
+    cJSON_AddNumberToObject(person, "age", 20 + i % 50);
+    cJSON_AddStringToObject(person, "hobby", "programming");
+    cJSON_AddNumberToObject(person, "salary", 30000.5 + i);
+    cJSON_AddStringToObject(person, "job", "Programmer");
+    cJSON_AddStringToObject(person, "address", "Znojmo");
+    return person;
+}
+
+// Rows in the same order as the records, like loadData builds them
+static Person *makePeople(int num_people) {
+    Person *people = malloc((size_t)num_people * sizeof(Person));
+    for (int i = 0; i < num_people; ++i) {
+        cJSON *person_json = makePerson(i);
+        people[i].id = i + 1;
+        people[i].arena = NULL;
+        memset(&people[i].data, 0, sizeof(people[i].data));
+        for (cJSON *item = person_json->child->next; item; item = item->next) {
+            addTypedKeyValue(&people[i].data, item->string, valueFromJSON(person_json, item, NULL));
+        }
+        cJSON_Delete(person_json);
+    }
+    return people;
+}
+
+static ColumnStore *makeColumns(int num_people) {
+    ColumnStore *store = createColumnStore(num_people);
+    for (int i = 0; i < num_people; ++i) {
+        cJSON *person_json = makePerson(i);
+        columnStoreSetRow(store, i, person_json);
+        cJSON_Delete(person_json);
+    }
+    columnStoreFinish(store);
+    return store;
+}
+
+static double sumPeople(const Person *people, int num_people) {
+    double sum = 0;
+    int salary = findKeyID("salary");
+    for (int i = 0; i < num_people; ++i) {
+        const KeyValue *key_value = findKeyValue(&people[i].data, salary);
+        if (key_value && key_value->value.type == VALUE_DOUBLE) sum += key_value->value.as.number;
+        else if (key_value && key_value->value.type == VALUE_INT) sum += (double)key_value->value.as.integer;
+    }
+    return sum;
+}
+
+int main(void) {
+    const int sizes[] = { 100000, 1000000 };
+    const int rounds = 10;
+
+    printf("%10s %16s %16s\n", "people", "Person[] [s]", "column [s]");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        Person *people = makePeople(sizes[s]);
+        ColumnStore *store = makeColumns(sizes[s]);
+
+        double start = now();
+        double people_sum = 0;
+        for (int r = 0; r < rounds; ++r) people_sum += sumPeople(people, sizes[s]);
+        double people_time = (now() - start) / rounds;
+
+        start = now();
+        double column_sum = 0;
+        ColumnStats stats;
+        for (int r = 0; r < rounds; ++r) {
+            columnStats(store, "salary", &stats);
+            column_sum += stats.sum;
+        }
+        double column_time = (now() - start) / rounds;
+
+        if (people_sum != column_sum) {
+            fprintf(stderr, "Sums disagree.\n");
+            return 1;
+        }
+        printf("%10d %16.4f %16.4f\n", sizes[s], people_time, column_time);
+
+        for (int i = 0; i < sizes[s]; ++i) freeKeyValueList(&people[i].data);
+        free(people);
+        freeColumnStore(store);
+    }
+    freeKeyTable();
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../cJSON/cJSON.h"
+
+// Member lookups in objects of 8 to 1000 members: the linear scan of cJSON_GetObjectItem
+// against the hash index turned on with cJSON_SetObjectIndexThreshold, in ns per lookup.
+// "first" is a lookup on an object that has no index yet, so it includes building it.
+// Usage: objectLookupBench.exe [lookups]
+
+#define INDEX_THRESHOLD 16
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// An object with members "field_0" ... "field_<members-1>", like the wide records of a data export
+static cJSON *makeRecord(int members) {
+    char key[32];
+    cJSON *record = cJSON_CreateObject();
+    for (int i = 0; i < members; ++i) {
+        snprintf(key, sizeof(key), "field_%d", i);
+        cJSON_AddNumberToObject(record, key, i);
+    }
+    return record;
+}
+
+// ns per lookup of lookups random existing keys
+static double lookupTime(const cJSON *record, char (*keys)[32], int members, int lookups, int case_sensitive) {
+    unsigned int seed = 12345;
+    long sum = 0;
+    double start = now();
+    for (int i = 0; i < lookups; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        const char *key = keys[(seed >> 8) % (unsigned int)members];
+        cJSON *item = case_sensitive ? cJSON_GetObjectItemCaseSensitive(record, key) : cJSON_GetObjectItem(record, key);
+        sum += item->valueint;
+    }
+    double elapsed = now() - start;
+    if (sum < 0) {
+        fprintf(stderr, "Lookup failed.\n");
+        exit(1);
+    }
+    return elapsed / lookups * 1e9;
+}
+
+// ns for the first lookup on each of copies fresh objects
+static double firstLookupTime(int members, const char *key) {
+    const int copies = 200;
+    cJSON *records[200];
+    for (int i = 0; i < copies; ++i) {
+        records[i] = makeRecord(members);
+    }
+    double start = now();
+    for (int i = 0; i < copies; ++i) {
+        if (!cJSON_GetObjectItem(records[i], key)) {
+            fprintf(stderr, "Lookup failed.\n");
+            exit(1);
+        }
+    }
+    double elapsed = now() - start;
+    for (int i = 0; i < copies; ++i) {
+        cJSON_Delete(records[i]);
+    }
+    return elapsed / copies * 1e9;
+}
+
+int main(int argc, char **argv) {
+    int lookups = argc > 1 ? atoi(argv[1]) : 2000000;
+    const int sizes[] = { 8, 32, 200, 1000 };
+
+    printf("%8s %10s %10s %13s %13s %12s\n", "members", "scan [ns]", "index [ns]",
+           "scan CS [ns]", "index CS [ns]", "first [ns]");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        int members = sizes[s];
+        char (*keys)[32] = malloc(sizeof(*keys) * (size_t)members);
+        for (int i = 0; i < members; ++i) {
+            snprintf(keys[i], sizeof(keys[i]), "field_%d", i);
+        }
+        cJSON *record = makeRecord(members);
+
+        cJSON_SetObjectIndexThreshold(0);
+        double scan = lookupTime(record, keys, members, lookups, 0);
+        double scan_cs = lookupTime(record, keys, members, lookups, 1);
+
+        cJSON_SetObjectIndexThreshold(INDEX_THRESHOLD);
+        double index = lookupTime(record, keys, members, lookups, 0);
+        double index_cs = lookupTime(record, keys, members, lookups, 1);
+        double first = firstLookupTime(members, keys[members - 1]);
+
+        printf("%8d %10.1f %10.1f %13.1f %13.1f %12.1f\n", members, scan, index, scan_cs, index_cs, first);
+        cJSON_Delete(record);
+        free(keys);
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../cJSON/cJSON.h"
+#include "../inc/func.h"
+#include "../inc/keyTable.h"
+
+// Loading one big people file with loadDataParallel on 1, 2, 4, 8 and 16 threads.
+// Usage: parallelLoadBench.exe [people]
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Records shaped like src/data.json with a "note" of up to 300 bytes, so pieces differ in size
+static void writePeople(const char *path, int num_people) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        perror("Cannot write the benchmark file");
+        exit(1);
+    }
+    fprintf(file, "{\n\t\"people\":\t[");
+    for (int i = 0; i < num_people; ++i) {
+        fprintf(file, "%s{\n\t\t\t\"id\":\t%d,\n\t\t\t\"name\":\t\"Jane Doe\",\n\t\t\t\"age\":\t%d,\n"
+                      "\t\t\t\"hobby\":\t\"programming\",\n\t\t\t\"salary\":\t%.1f,\n"
+                      "\t\t\t\"job\":\t\"Programmer\",\n\t\t\t\"address\":\t\"Znojmo\",\n\t\t\t\"note\":\t\"%.*s\"\n\t\t}",
+                i == 0 ? "" : ", ", i + 1, 20 + i % 50, 30000.5 + i, i % 300,
+                "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore "
+                "et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut "
+                "aliquip ex ea commodo consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse cillum");
+    }
+    fprintf(file, "]\n}");
+    fclose(file);
+}
+
+int main(int argc, char **argv) {
+    int num_people = argc > 1 ? atoi(argv[1]) : 500000;
+    const char *path = "parallelLoadBench.json";
+    const int threads[] = { 1, 2, 4, 8, 16 };
+    double single = 0.0;
+
+    writePeople(path, num_people);
+    printf("%8s %10s %10s\n", "threads", "load [s]", "speedup");
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+        int count = 0;
+        double start = now();
+        Person *people = loadDataParallel(path, &count, threads[t]);
+        double elapsed = now() - start;
+        if (!people || count != num_people) {
+            fprintf(stderr, "Loading failed.\n");
+            return 1;
+        }
+        freePeople(people, count);
+        if (t == 0) single = elapsed;
+        printf("%8d %10.3f %10.2f\n", threads[t], elapsed, single / elapsed);
+    }
+
+    freeKeyTable();
+    remove(path);
+    return 0;
+}
@@ -0,0 +1,345 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../cJSON/cJSON.h"
+#include "../inc/jsonIndex.h"
+
+// Parse throughput in MB/s: cJSON_ParseWithLength for each SIMD level the CPU supports,
+// then cJSON against the two-stage parser of src/jsonIndex.c at the best level, arrays of
+// numbers as items and packed against converting the same numbers with strtod alone, indented against
+// compact text for parsing and cJSON_Minify, the cost of CJSON_PARSE_STRICT_UTF8, and
+// parsing and deleting with and without a cJSON_Context and in situ.
+// Usage: parseBench.exe [people]
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Text of {"people": [...]} with records shaped like src/data.json, plus a "note"
+// of note_length bytes; every escape_every-th note byte is a \n escape (0 for none)
+static char *makeDocument(int num_people, int note_length, int escape_every, size_t *length) {
+    char *note = malloc((size_t)note_length * 2 + 1);
+    int pos = 0;
+    for (int i = 0; i < note_length; ++i) {
+        if (escape_every > 0 && i % escape_every == escape_every - 1) {
+            note[pos++] = '\\';
+            note[pos++] = 'n';
+        } else {
+            note[pos++] = (char)('a' + i % 26);
+        }
+    }
+    note[pos] = '\0';
+
+    size_t capacity = (size_t)num_people * (200 + (size_t)pos) + 32;
+    char *text = malloc(capacity);
+    size_t used = (size_t)sprintf(text, "{\n\t\"people\":\t[");
+    for (int i = 0; i < num_people; ++i) {
+        used += (size_t)sprintf(text + used,
+                                "%s{\n\t\t\t\"id\":\t%d,\n\t\t\t\"name\":\t\"Jane Doe\",\n\t\t\t\"age\":\t%d,\n"
+                                "\t\t\t\"hobby\":\t\"programming\",\n\t\t\t\"salary\":\t%.1f,\n"
+                                "\t\t\t\"job\":\t\"Programmer\",\n\t\t\t\"address\":\t\"Znojmo\"",
+                                i == 0 ? "" : ", ", i + 1, 20 + i % 50, 30000.5 + i);
+        if (note_length > 0) {
+            used += (size_t)sprintf(text + used, ",\n\t\t\t\"note\":\t\"%s\"", note);
+        }
+        used += (size_t)sprintf(text + used, "\n\t\t}");
+    }
+    used += (size_t)sprintf(text + used, "]\n}");
+
+    free(note);
+    *length = used;
+    return text;
+}
+
+// Text of an array of count numbers: integers, prices with two decimals or doubles
+// printed with all 17 digits
+static char *makeNumbers(int count, int kind, size_t *length) {
+    char *text = malloc((size_t)count * 26 + 4);
+    size_t used = (size_t)sprintf(text, "[");
+    unsigned int seed = 12345;
+    for (int i = 0; i < count; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        if (kind == 0) {
+            used += (size_t)sprintf(text + used, "%s%u", i == 0 ? "" : ",", seed % 1000000);
+        } else if (kind == 1) {
+            used += (size_t)sprintf(text + used, "%s%u.%02u", i == 0 ? "" : ",", seed % 100000, seed % 97);
+        } else {
+            used += (size_t)sprintf(text + used, "%s%.17g", i == 0 ? "" : ",", (seed % 1000003) / 7.0 * (i % 2 ? 1e-5 : 1e12));
+        }
+    }
+    used += (size_t)sprintf(text + used, "]");
+    *length = used;
+    return text;
+}
+
+// Text of {"people": [...]} with an id and a note made of note repeated times times
+static char *makeNotes(int num_people, const char *note, int times, size_t *length) {
+    size_t note_length = strlen(note);
+    char *text = malloc((size_t)num_people * (note_length * (size_t)times + 32) + 32);
+    size_t used = (size_t)sprintf(text, "{\"people\":[");
+    for (int i = 0; i < num_people; ++i) {
+        used += (size_t)sprintf(text + used, "%s{\"id\":%d,\"note\":\"", i == 0 ? "" : ",", i + 1);
+        for (int t = 0; t < times; ++t) {
+            memcpy(text + used, note, note_length);
+            used += note_length;
+        }
+        used += (size_t)sprintf(text + used, "\"}");
+    }
+    used += (size_t)sprintf(text + used, "]}");
+    *length = used;
+    return text;
+}
+
+// Seconds for minifying a copy of text
+static double minifyTime(const char *text, size_t length, char *copy) {
+    memcpy(copy, text, length + 1);
+    double start = now();
+    cJSON_Minify(copy);
+    return now() - start;
+}
+
+// Seconds for converting every number of a makeNumbers text with strtod
+static double strtodTime(const char *text) {
+    double start = now();
+    double sum = 0.0;
+    const char *pos = text + 1;
+    char *end = NULL;
+    while (*pos != ']') {
+        sum += strtod(pos, &end);
+        pos = *end == ',' ? end + 1 : end;
+    }
+    double elapsed = now() - start;
+    if (sum == 42.0) printf(" ");
+    return elapsed;
+}
+
+enum { ENGINE_CJSON, ENGINE_STAGE1, ENGINE_INDEXED, ENGINE_STRICT, ENGINE_PACKED };
+
+// Seconds for one parse of text
+static double parseTime(int engine, const char *text, size_t length) {
+    double start = now();
+    double elapsed = 0.0;
+    size_t error_offset = 0;
+    cJSON *root = NULL;
+
+    if (engine == ENGINE_STAGE1) {
+        JsonIndex index;
+        int ok = buildJsonIndex(text, length, &index, &error_offset);
+        elapsed = now() - start;
+        freeJsonIndex(&index);
+        if (ok) return elapsed;
+    } else {
+        if (engine == ENGINE_CJSON) {
+            root = cJSON_ParseWithLength(text, length);
+        } else if (engine == ENGINE_STRICT) {
+            root = cJSON_ParseWithFlags(text, length, NULL, CJSON_PARSE_STRICT_UTF8);
+        } else if (engine == ENGINE_PACKED) {
+            root = cJSON_ParseWithFlags(text, length, NULL, CJSON_PARSE_PACK_NUMBERS);
+        } else {
+            root = parseJsonIndexed(text, length, &error_offset);
+        }
+        elapsed = now() - start;
+    }
+    if (!root) {
+        fprintf(stderr, "Parsing failed.\n");
+        exit(1);
+    }
+    cJSON_Delete(root);
+    return elapsed;
+}
+
+enum { PARSE_HEAP, PARSE_CONTEXT, PARSE_IN_SITU };
+
+// Seconds for parsing text and deleting the tree, on the heap or with a new context like
+// loadData, and in situ into a copy of text in scratch made before the clock starts
+static double parseDeleteTime(int mode, const char *text, size_t length, char *scratch) {
+    if (mode == PARSE_IN_SITU) {
+        memcpy(scratch, text, length);
+        text = scratch;
+    }
+    double start = now();
+    cJSON_Context *context = mode != PARSE_HEAP ? cJSON_CreateContext() : NULL;
+    cJSON *root = cJSON_ParseWithContext(context, text, length, NULL, mode == PARSE_IN_SITU ? CJSON_PARSE_IN_SITU : 0);
+    if (!root) {
+        fprintf(stderr, "Parsing failed.\n");
+        exit(1);
+    }
+    if (context) {
+        cJSON_DeleteContext(context);
+    } else {
+        cJSON_Delete(root);
+    }
+    return now() - start;
+}
+
+int main(int argc, char **argv) {
+    int num_people = argc > 1 ? atoi(argv[1]) : 100000;
+    const char *names[] = { "data.json records", "+ 400 byte note", "+ note, \\n every 40" };
+    const int note_lengths[] = { 0, 400, 400 };
+    const int escapes[] = { 0, 0, 40 };
+    const char *levels[] = { "scalar", "SSE2", "AVX2" };
+    const char *engines[] = { "cJSON", "index only", "indexed" };
+    int max_level = cJSON_GetSimdLevel();
+    char *texts[3];
+    size_t lengths[3];
+
+    for (int d = 0; d < 3; ++d) {
+        texts[d] = makeDocument(num_people, note_lengths[d], escapes[d], &lengths[d]);
+    }
+
+    // Best of 10 rounds; the contenders take turns so none of them gets a warmer heap
+    printf("%-22s %10s", "document", "size [MB]");
+    for (int level = 0; level <= max_level; ++level) {
+        printf(" %10s", levels[level]);
+    }
+    printf("   (cJSON, MB/s)\n");
+    for (int d = 0; d < 3; ++d) {
+        double best[3] = { 0.0, 0.0, 0.0 };
+        for (int round = 0; round < 10; ++round) {
+            for (int level = 0; level <= max_level; ++level) {
+                cJSON_SetSimdLevel(level);
+                double elapsed = parseTime(ENGINE_CJSON, texts[d], lengths[d]);
+                if (round == 0 || elapsed < best[level]) best[level] = elapsed;
+            }
+        }
+        printf("%-22s %10.1f", names[d], lengths[d] / 1e6);
+        for (int level = 0; level <= max_level; ++level) {
+            printf(" %10.1f", lengths[d] / best[level] / 1e6);
+        }
+        printf("\n");
+    }
+
+    cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
+    printf("\n%-22s %10s %10s %10s %10s   (%s, MB/s)\n", "document", "size [MB]",
+           engines[0], engines[1], engines[2], levels[max_level]);
+    for (int d = 0; d < 3; ++d) {
+        double best[3] = { 0.0, 0.0, 0.0 };
+        for (int round = 0; round < 10; ++round) {
+            for (int engine = 0; engine < 3; ++engine) {
+                double elapsed = parseTime(engine, texts[d], lengths[d]);
+                if (round == 0 || elapsed < best[engine]) best[engine] = elapsed;
+            }
+        }
+        printf("%-22s %10.1f", names[d], lengths[d] / 1e6);
+        for (int engine = 0; engine < 3; ++engine) {
+            printf(" %10.1f", lengths[d] / best[engine] / 1e6);
+        }
+        printf("\n");
+        free(texts[d]);
+    }
+
+    // Whitespace: the tab-indented records, the same records minified, and minifying them
+    size_t indented_length = 0;
+    char *indented = makeDocument(num_people, 0, 0, &indented_length);
+    char *compact = malloc(indented_length + 1);
+    memcpy(compact, indented, indented_length + 1);
+    cJSON_Minify(compact);
+    size_t compact_length = strlen(compact);
+    char *scratch = malloc(indented_length + 1);
+
+    printf("\n%-22s %10s", "whitespace", "size [MB]");
+    for (int level = 0; level <= max_level; ++level) {
+        printf(" %10s", levels[level]);
+    }
+    printf("   (MB/s)\n");
+    const char *tasks[] = { "parse, indented", "parse, compact", "minify, indented" };
+    for (int task = 0; task < 3; ++task) {
+        const char *text = task == 1 ? compact : indented;
+        size_t length = task == 1 ? compact_length : indented_length;
+        double best[3] = { 0.0, 0.0, 0.0 };
+        for (int round = 0; round < 10; ++round) {
+            for (int level = 0; level <= max_level; ++level) {
+                cJSON_SetSimdLevel(level);
+                double elapsed = task == 2 ? minifyTime(text, length, scratch) : parseTime(ENGINE_CJSON, text, length);
+                if (round == 0 || elapsed < best[level]) best[level] = elapsed;
+            }
+        }
+        printf("%-22s %10.1f", tasks[task], length / 1e6);
+        for (int level = 0; level <= max_level; ++level) {
+            printf(" %10.1f", length / best[level] / 1e6);
+        }
+        printf("\n");
+    }
+    cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
+    free(indented);
+    free(compact);
+    free(scratch);
+
+    const char *kinds[] = { "1M integers", "1M prices", "1M 17 digit doubles" };
+    printf("\n%-22s %10s %10s %10s %10s   (MB/s)\n", "document", "size [MB]", "cJSON", "packed", "strtod");
+    for (int kind = 0; kind < 3; ++kind) {
+        size_t length = 0;
+        char *text = makeNumbers(1000000, kind, &length);
+        double best[3] = { 0.0, 0.0, 0.0 };
+        for (int round = 0; round < 10; ++round) {
+            double elapsed = parseTime(ENGINE_CJSON, text, length);
+            if (round == 0 || elapsed < best[0]) best[0] = elapsed;
+            elapsed = parseTime(ENGINE_PACKED, text, length);
+            if (round == 0 || elapsed < best[1]) best[1] = elapsed;
+            elapsed = strtodTime(text);
+            if (round == 0 || elapsed < best[2]) best[2] = elapsed;
+        }
+        printf("%-22s %10.1f %10.1f %10.1f %10.1f\n", kinds[kind], length / 1e6, length / best[0] / 1e6,
+               length / best[1] / 1e6, length / best[2] / 1e6);
+        free(text);
+    }
+
+    // Parse and delete, one malloc per item and string against the chunks of a context
+    printf("\n%-22s %10s %10s %10s %10s   (parse + delete, MB/s)\n", "document", "size [MB]", "heap", "context", "in situ");
+    for (int d = 0; d < 3; ++d) {
+        size_t length = 0;
+        char *text = makeDocument(num_people, note_lengths[d], escapes[d], &length);
+        char *copy = malloc(length);
+        double best[3] = { 0.0, 0.0, 0.0 };
+        for (int round = 0; round < 10; ++round) {
+            for (int mode = PARSE_HEAP; mode <= PARSE_IN_SITU; ++mode) {
+                double elapsed = parseDeleteTime(mode, text, length, copy);
+                if (round == 0 || elapsed < best[mode]) best[mode] = elapsed;
+            }
+        }
+        printf("%-22s %10.1f", names[d], length / 1e6);
+        for (int mode = PARSE_HEAP; mode <= PARSE_IN_SITU; ++mode) {
+            printf(" %10.1f", length / best[mode] / 1e6);
+        }
+        printf("\n");
+        free(text);
+        free(copy);
+    }
+
+    // Strict UTF-8 against the default parse, which does not look at the bytes
+    const char *notes[] = { "plain ascii text, ", "pr\xC3\xADli\xC5\xA1 \xC5\xBElu\xC5\xA5ou\xC4\x8Dk\xC3\xBD k\xC5\xAF\xC5\x88 ",
+                            "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE6\x96\x87 ", "\xF0\x9F\x98\x80 mixed \xC3\xA9 \xE2\x82\xAC " };
+    const char *scripts[] = { "ASCII notes", "Czech notes", "Japanese notes", "emoji, mixed notes" };
+    printf("\n%-22s %10s %10s", "strict UTF-8", "size [MB]", "default");
+    for (int level = 0; level <= max_level; ++level) {
+        printf(" %10s", levels[level]);
+    }
+    printf("   (MB/s)\n");
+    for (int n = 0; n < 4; ++n) {
+        size_t length = 0;
+        char *text = makeNotes(num_people / 4, notes[n], 400 / (int)strlen(notes[n]), &length);
+        double best[4] = { 0.0, 0.0, 0.0, 0.0 };
+        for (int round = 0; round < 10; ++round) {
+            cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
+            double elapsed = parseTime(ENGINE_CJSON, text, length);
+            if (round == 0 || elapsed < best[0]) best[0] = elapsed;
+            for (int level = 0; level <= max_level; ++level) {
+                cJSON_SetSimdLevel(level);
+                elapsed = parseTime(ENGINE_STRICT, text, length);
+                if (round == 0 || elapsed < best[level + 1]) best[level + 1] = elapsed;
+            }
+        }
+        printf("%-22s %10.1f", scripts[n], length / 1e6);
+        for (int level = 0; level <= max_level + 1; ++level) {
+            printf(" %10.1f", length / best[level] / 1e6);
+        }
+        printf("\n");
+        free(text);
+    }
+    cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../cJSON/cJSON.h"
+
+// Print throughput in MB/s of output: cJSON_Print on people records, with and without
+// a long text, and on arrays of numbers as items and packed, and cJSON_PrintStreamed
+// in 64 KB pieces handed to a writer that drops them.
+// Usage: printBench.exe [people]
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Build {"people": [...]} with num_people records shaped like src/data.json, plus a
+// "note" of note_length bytes with a newline every escape_every bytes (0 for none)
+static cJSON *makePeople(int num_people, int note_length, int escape_every) {
+    char *note = malloc((size_t)note_length + 1);
+    for (int i = 0; i < note_length; ++i) {
+        note[i] = (escape_every > 0 && i % escape_every == escape_every - 1) ? '\n' : (char)('a' + i % 26);
+    }
+    note[note_length] = '\0';
+
+    cJSON *root = cJSON_CreateObject();
+    cJSON *people = cJSON_AddArrayToObject(root, "people");
+    for (int i = 0; i < num_people; ++i) {
+        cJSON *person = cJSON_CreateObject();
+        cJSON_AddNumberToObject(person, "id", i + 1);
+        cJSON_AddStringToObject(person, "name", "Jane Doe");
+        cJSON_AddNumberToObject(person, "age", 20 + i % 50);
+        cJSON_AddStringToObject(person, "hobby", "programming");
+        cJSON_AddNumberToObject(person, "salary", 30000.5 + i * 0.25);
+        cJSON_AddStringToObject(person, "job", "Programmer");
+        cJSON_AddStringToObject(person, "address", "Znojmo");
+        if (note_length > 0) {
+            cJSON_AddStringToObject(person, "note", note);
+        }
+        cJSON_AddItemToArray(people, person);
+    }
+    free(note);
+    return root;
+}
+
+// An array of count numbers: integers, prices with two decimals or doubles that need
+// all 17 digits
+static cJSON *makeNumbers(int count, int kind) {
+    cJSON *array = cJSON_CreateArray();
+    unsigned int seed = 12345;
+    for (int i = 0; i < count; ++i) {
+        double number;
+        seed = seed * 1103515245u + 12345u;
+        if (kind == 0) {
+            number = seed % 1000000;
+        } else if (kind == 1) {
+            number = (seed % 10000000) / 100.0;
+        } else {
+            number = (seed % 1000003) / 7.0 * (i % 2 ? 1e-5 : 1e12);
+        }
+        cJSON_AddItemToArray(array, cJSON_CreateNumber(number));
+    }
+    return array;
+}
+
+// Counts the streamed text instead of writing it anywhere
+static cJSON_bool countPiece(void *target, const char *text, size_t length) {
+    (void)text;
+    *(size_t *)target += length;
+    return 1;
+}
+
+// Best of 10 rounds in MB/s of printed text, printed at once or streamed
+static double printSpeed(const cJSON *root, int streamed) {
+    double best = 0.0;
+    size_t length = 0;
+    for (int round = 0; round < 10; ++round) {
+        int printed = 1;
+        length = 0;
+        double start = now();
+        if (streamed) {
+            printed = cJSON_PrintStreamed(root, 1, 64 * 1024, countPiece, &length);
+        } else {
+            char *text = cJSON_Print(root);
+            printed = text != NULL;
+            if (text) {
+                length = strlen(text);
+                cJSON_free(text);
+            }
+        }
+        double elapsed = now() - start;
+        if (!printed) {
+            fprintf(stderr, "Printing failed.\n");
+            exit(1);
+        }
+        if (round == 0 || elapsed < best) best = elapsed;
+    }
+    return length / best / 1e6;
+}
+
+int main(int argc, char **argv) {
+    int num_people = argc > 1 ? atoi(argv[1]) : 100000;
+    const char *names[] = { "data.json records", "+ 400 byte note", "+ note, \\n every 40" };
+    const int note_lengths[] = { 0, 400, 400 };
+    const int escapes[] = { 0, 0, 40 };
+    const char *kinds[] = { "1M integers", "1M prices", "1M 17 digit doubles" };
+
+    printf("%-22s %12s %15s %13s\n", "document", "cJSON [MB/s]", "streamed [MB/s]", "packed [MB/s]");
+
+    for (int d = 0; d < 3; ++d) {
+        cJSON *people = makePeople(num_people, note_lengths[d], escapes[d]);
+        printf("%-22s %12.1f %15.1f\n", names[d], printSpeed(people, 0), printSpeed(people, 1));
+        cJSON_Delete(people);
+    }
+
+    for (int kind = 0; kind < 3; ++kind) {
+        cJSON *numbers = makeNumbers(1000000, kind);
+        int count = cJSON_GetArraySize(numbers);
+        double *values = malloc(sizeof(double) * (size_t)count);
+        cJSON *number = NULL;
+        int i = 0;
+        cJSON_ArrayForEach(number, numbers) {
+            values[i++] = number->valuedouble;
+        }
+        cJSON *packed = cJSON_CreatePackedArray(values, count);
+        printf("%-22s %12.1f %15.1f %13.1f\n", kinds[kind], printSpeed(numbers, 0), printSpeed(numbers, 1),
+               printSpeed(packed, 0));
+        cJSON_Delete(packed);
+        cJSON_Delete(numbers);
+        free(values);
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../cJSON/cJSON.h"
+#include "../inc/func.h"
+#include "../inc/keyTable.h"
+#include "../inc/memTrack.h"
+
+// Saving people records: the cJSON tree saveData used to build and print, against
+// writePeopleJSON writing the same text straight from the key-value pairs. Time is the best
+// of 5 rounds, memory the peak on top of the loaded people.
+// Usage: saveBench.exe [people]
+
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// People shaped like src/data.json
+static Person *makePeople(int num_people) {
+    Person *people = memTrackMalloc(sizeof(Person) * (size_t)num_people);
+    memset(people, 0, sizeof(Person) * (size_t)num_people);
+    for (int i = 0; i < num_people; ++i) {
+        people[i].id = i + 1;
+        Value value;
+        stringValue("Jane Doe", &value);
+        addTypedKeyValue(&people[i].data, "name", value);
+        value = numberValue(20 + i % 50);
+        addTypedKeyValue(&people[i].data, "age", value);
+        stringValue("programming", &value);
+        addTypedKeyValue(&people[i].data, "hobby", value);
+        value = numberValue(30000.5 + i * 0.25);
+        addTypedKeyValue(&people[i].data, "salary", value);
+        stringValue("Programmer", &value);
+        addTypedKeyValue(&people[i].data, "job", value);
+        stringValue("Znojmo", &value);
+        addTypedKeyValue(&people[i].data, "address", value);
+    }
+    return people;
+}
+
+// The tree of valueToJSON items, printed into the file in chunks
+static int saveTree(FILE *file, const Person *people, int num_people) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON *array = cJSON_AddArrayToObject(root, "people");
+    for (int i = 0; i < num_people; ++i) {
+        cJSON *person_json = cJSON_CreateObject();
+        cJSON_AddNumberToObject(person_json, "id", people[i].id);
+        const KeyValueList *data = &people[i].data;
+        for (int j = 0; j < data->count; ++j) {
+            cJSON_AddItemToObjectCS(person_json, keyName(data->items[j].key_id), valueToJSON(&data->items[j].value));
+        }
+        cJSON_AddItemToArray(array, person_json);
+    }
+    int written = cJSON_PrintToFile(root, file, 1);
+    cJSON_Delete(root);
+    return written;
+}
+
+// Best time of 5 rounds, the peak bytes and the allocations of one round
+static double saveTime(const char *path, const Person *people, int num_people, int direct,
+                       size_t *peak, size_t *allocations) {
+    double best = 0.0;
+    for (int round = 0; round < 5; ++round) {
+        FILE *file = fopen(path, "w");
+        if (!file) {
+            perror("Cannot write the benchmark file");
+            exit(1);
+        }
+        MemTrackStats before = memTrackStats();
+        memTrackResetPeak();
+        double start = now();
+        int written = direct ? writePeopleJSON(file, NULL, people, num_people) : saveTree(file, people, num_people);
+        written = (fclose(file) == 0) && written;
+        double elapsed = now() - start;
+        if (!written) {
+            fprintf(stderr, "Saving failed.\n");
+            exit(1);
+        }
+        MemTrackStats after = memTrackStats();
+        *peak = after.peak_bytes - before.live_bytes;
+        *allocations = after.total_allocations - before.total_allocations;
+        if (round == 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+int main(int argc, char **argv) {
+    int num_people = argc > 1 ? atoi(argv[1]) : 1000000;
+    const char *path = "saveBench.json";
+    const char *names[] = { "cJSON tree", "writePeopleJSON" };
+
+    memTrackInstallHooks();
+    Person *people = makePeople(num_people);
+
+    printf("%-15s %10s %12s %12s\n", "save", "time [s]", "peak [MB]", "allocations");
+    for (int direct = 0; direct < 2; ++direct) {
+        size_t peak = 0;
+        size_t allocations = 0;
+        double elapsed = saveTime(path, people, num_people, direct, &peak, &allocations);
+        printf("%-15s %10.3f %12.1f %12zu\n", names[direct], elapsed, peak / 1e6, allocations);
+    }
+
+    remove(path);
+    freePeople(people, num_people);
+    freeKeyTable();
+    return 0;
+}
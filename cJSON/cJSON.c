@@ -44,6 +44,12 @@
 #include <limits.h>
 #include <ctype.h>
 #include <float.h>
+#include <errno.h>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #ifdef ENABLE_LOCALES
 #include <locale.h>
@@ -85,11 +91,22 @@
 #endif
 #endif
 
+/* the error position is kept per thread, so threads parsing at the same time do not overwrite each other's */
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define CJSON_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define CJSON_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define CJSON_THREAD_LOCAL __declspec(thread)
+#else
+#define CJSON_THREAD_LOCAL
+#endif
+
 typedef struct {
     const unsigned char *json;
     size_t position;
 } error;
-static error global_error = { NULL, 0 };
+static CJSON_THREAD_LOCAL error global_error = { NULL, 0 };
 
 CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void)
 {
@@ -185,6 +202,21 @@ static void * CJSON_CDECL internal_realloc(void *pointer, size_t size)
 
 static internal_hooks global_hooks = { internal_malloc, internal_free, internal_realloc };
 
+#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
+    #pragma GCC diagnostic push
+#endif
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wcast-qual"
+#endif
+/* helper function to cast away const */
+static void* cast_away_const(const void* string)
+{
+    return (void*)string;
+}
+#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
+    #pragma GCC diagnostic pop
+#endif
+
 static unsigned char* cJSON_strdup(const unsigned char* string, const internal_hooks * const hooks)
 {
     size_t length = 0;
@@ -250,6 +282,26 @@ static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
 }
 
 /* Delete a cJSON structure. */
+/* Lookup index of an object or array, see container_index, or the numbers of a packed array */
+typedef struct index_entry
+{
+    size_t hash;
+    cJSON *item; /* NULL in free slots */
+} index_entry;
+
+struct cJSON_Index
+{
+    cJSON_Context *context; /* owner of the memory, NULL when it came from the heap */
+    size_t mask; /* slots - 1, 0 until the index is built */
+    size_t count; /* members or items in the table */
+    union
+    {
+        index_entry entries[1]; /* objects: hash table of the members */
+        cJSON *items[1]; /* arrays: the items in order */
+        double numbers[1]; /* packed arrays: the numbers, count of them */
+    } table;
+};
+
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
 {
     cJSON *next = NULL;
@@ -268,11 +320,137 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
         {
             global_hooks.deallocate(item->string);
         }
-        global_hooks.deallocate(item);
+        if (!(item->type & cJSON_IsReference) && (item->index != NULL) && (item->index->context == NULL))
+        {
+            global_hooks.deallocate(item->index);
+        }
+        /* pooled items go with their context */
+        if (!(item->type & cJSON_IsPooled))
+        {
+            global_hooks.deallocate(item);
+        }
         item = next;
     }
 }
 
+/* Parse contexts: the items of a parse come from a node pool and their strings from
+ * a string arena, both lists of chunks that are freed as a whole. */
+#define CONTEXT_MIN_CHUNK_SIZE 4096
+#define CONTEXT_MAX_CHUNK_SIZE (16 * 1024 * 1024)
+
+typedef struct context_chunk
+{
+    struct context_chunk *next;
+    size_t size; /* bytes in data */
+    size_t used;
+    cJSON data[1]; /* aligned for nodes, string chunks use it as bytes */
+} context_chunk;
+
+struct cJSON_Context
+{
+    internal_hooks hooks;
+    context_chunk *nodes; /* current chunk first, also holds the indexes of pooled objects */
+    context_chunk *strings;
+    struct cJSON_Index index_stub; /* what pooled items point to until they have an index */
+};
+
+/* size bytes from the current chunk of a list, a new chunk twice as big as the last is
+ * started when they don't fit, so even large documents need a handful of chunks */
+static void *context_allocate(cJSON_Context * const context, context_chunk ** const chunks, size_t size)
+{
+    context_chunk *chunk = *chunks;
+    size_t chunk_size = 0;
+    void *memory = NULL;
+
+    if ((chunk == NULL) || ((chunk->size - chunk->used) < size))
+    {
+        chunk_size = (chunk == NULL) ? CONTEXT_MIN_CHUNK_SIZE : (chunk->size * 2);
+        if (chunk_size > CONTEXT_MAX_CHUNK_SIZE)
+        {
+            chunk_size = CONTEXT_MAX_CHUNK_SIZE;
+        }
+        if (chunk_size < size)
+        {
+            chunk_size = size;
+        }
+
+        chunk = (context_chunk*)context->hooks.allocate(offsetof(context_chunk, data) + chunk_size);
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+        chunk->next = *chunks;
+        chunk->size = chunk_size;
+        chunk->used = 0;
+        *chunks = chunk;
+    }
+
+    memory = (unsigned char*)chunk->data + chunk->used;
+    chunk->used += size;
+
+    return memory;
+}
+
+static void context_free_chunks(const internal_hooks * const hooks, context_chunk *chunk)
+{
+    context_chunk *next = NULL;
+    while (chunk != NULL)
+    {
+        next = chunk->next;
+        hooks->deallocate(chunk);
+        chunk = next;
+    }
+}
+
+CJSON_PUBLIC(cJSON_Context *) cJSON_CreateContext(void)
+{
+    cJSON_Context *context = (cJSON_Context*)global_hooks.allocate(sizeof(cJSON_Context));
+    if (context != NULL)
+    {
+        context->hooks = global_hooks;
+        context->nodes = NULL;
+        context->strings = NULL;
+        memset(&context->index_stub, '\0', sizeof(context->index_stub));
+        context->index_stub.context = context;
+    }
+
+    return context;
+}
+
+CJSON_PUBLIC(void) cJSON_ResetContext(cJSON_Context *context)
+{
+    if (context == NULL)
+    {
+        return;
+    }
+
+    /* keep the newest chunk of each list, it is the biggest one */
+    if (context->nodes != NULL)
+    {
+        context_free_chunks(&context->hooks, context->nodes->next);
+        context->nodes->next = NULL;
+        context->nodes->used = 0;
+    }
+    if (context->strings != NULL)
+    {
+        context_free_chunks(&context->hooks, context->strings->next);
+        context->strings->next = NULL;
+        context->strings->used = 0;
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteContext(cJSON_Context *context)
+{
+    if (context == NULL)
+    {
+        return;
+    }
+
+    context_free_chunks(&context->hooks, context->nodes);
+    context_free_chunks(&context->hooks, context->strings);
+    context->hooks.deallocate(context);
+}
+
 /* get the decimal point character of the current locale */
 static unsigned char get_decimal_point(void)
 {
@@ -291,6 +469,8 @@ typedef struct
     size_t offset;
     size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
     internal_hooks hooks;
+    int flags; /* CJSON_PARSE_* */
+    cJSON_Context *context; /* where items and strings come from, NULL for the heap */
 } parse_buffer;
 
 /* check if the given size is left to read in a given parse buffer (starting with 1) */
@@ -301,13 +481,408 @@ typedef struct
 /* get a pointer to the buffer at the position */
 #define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
 
+/* Constructor for parsed items, from the node pool when parsing with a context.
+ * Parsing adds the type to the flags set here. */
+static cJSON *parse_new_item(const parse_buffer * const input_buffer)
+{
+    cJSON *node = NULL;
+    if (input_buffer->context == NULL)
+    {
+        return cJSON_New_Item(&input_buffer->hooks);
+    }
+
+    node = (cJSON*)context_allocate(input_buffer->context, &input_buffer->context->nodes, sizeof(cJSON));
+    if (node)
+    {
+        memset(node, '\0', sizeof(cJSON));
+        node->type = cJSON_IsPooled;
+        node->index = &input_buffer->context->index_stub;
+    }
+
+    return node;
+}
+
+/* Locale independent fast path for parse_number.
+ * Plain integers of up to 19 digits are accumulated and converted in one step. Other
+ * numbers with up to 19 significant digits are converted exactly: by one multiplication
+ * or division when both the digits and the power of ten are exact doubles (Clinger), or
+ * with the Eisel-Lemire algorithm, which multiplies by a 128 bit approximation of the
+ * power of five and only needs the few powers from 5^-64 to 5^64 stored below.
+ * Everything else (more digits, larger exponents, unusual forms) goes to strtod, so the
+ * results are bit for bit the same as before. */
+#if (defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L)) || defined(_MSC_VER)
+#define CJSON_FAST_NUMBERS
+#include <stdint.h>
+
+#define FAST_NUMBER_MIN_POWER (-64)
+#define FAST_NUMBER_MAX_POWER 64
+
+/* 5^q for q in [-64, 64], normalised so the top bit is set and truncated to 128 bits
+ * (negative powers rounded up), as { high word, low word } */
+static const uint64_t powers_of_five_128[FAST_NUMBER_MAX_POWER - FAST_NUMBER_MIN_POWER + 1][2] =
+{
+    { 0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL }, /* 5^-64 */
+    { 0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL }, /* 5^-63 */
+    { 0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL }, /* 5^-62 */
+    { 0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL }, /* 5^-61 */
+    { 0xCDB02555653131B6ULL, 0x3792F412CB06794DULL }, /* 5^-60 */
+    { 0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL }, /* 5^-59 */
+    { 0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL }, /* 5^-58 */
+    { 0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL }, /* 5^-57 */
+    { 0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL }, /* 5^-56 */
+    { 0x9CED737BB6C4183DULL, 0x55464DD69685606BULL }, /* 5^-55 */
+    { 0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL }, /* 5^-54 */
+    { 0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL }, /* 5^-53 */
+    { 0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL }, /* 5^-52 */
+    { 0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL }, /* 5^-51 */
+    { 0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL }, /* 5^-50 */
+    { 0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL }, /* 5^-49 */
+    { 0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL }, /* 5^-48 */
+    { 0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL }, /* 5^-47 */
+    { 0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL }, /* 5^-46 */
+    { 0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL }, /* 5^-45 */
+    { 0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL }, /* 5^-44 */
+    { 0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL }, /* 5^-43 */
+    { 0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL }, /* 5^-42 */
+    { 0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL }, /* 5^-41 */
+    { 0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL }, /* 5^-40 */
+    { 0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL }, /* 5^-39 */
+    { 0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL }, /* 5^-38 */
+    { 0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL }, /* 5^-37 */
+    { 0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL }, /* 5^-36 */
+    { 0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL }, /* 5^-35 */
+    { 0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL }, /* 5^-34 */
+    { 0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL }, /* 5^-33 */
+    { 0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL }, /* 5^-32 */
+    { 0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL }, /* 5^-31 */
+    { 0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL }, /* 5^-30 */
+    { 0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL }, /* 5^-29 */
+    { 0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL }, /* 5^-28 */
+    { 0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL }, /* 5^-27 */
+    { 0xC612062576589DDAULL, 0x95364AFE032A819EULL }, /* 5^-26 */
+    { 0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL }, /* 5^-25 */
+    { 0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL }, /* 5^-24 */
+    { 0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL }, /* 5^-23 */
+    { 0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL }, /* 5^-22 */
+    { 0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL }, /* 5^-21 */
+    { 0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL }, /* 5^-20 */
+    { 0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL }, /* 5^-19 */
+    { 0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL }, /* 5^-18 */
+    { 0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL }, /* 5^-17 */
+    { 0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL }, /* 5^-16 */
+    { 0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL }, /* 5^-15 */
+    { 0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL }, /* 5^-14 */
+    { 0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL }, /* 5^-13 */
+    { 0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL }, /* 5^-12 */
+    { 0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL }, /* 5^-11 */
+    { 0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL }, /* 5^-10 */
+    { 0x89705F4136B4A597ULL, 0x31680A88F8953031ULL }, /* 5^-9 */
+    { 0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL }, /* 5^-8 */
+    { 0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL }, /* 5^-7 */
+    { 0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL }, /* 5^-6 */
+    { 0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL }, /* 5^-5 */
+    { 0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL }, /* 5^-4 */
+    { 0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL }, /* 5^-3 */
+    { 0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL }, /* 5^-2 */
+    { 0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL }, /* 5^-1 */
+    { 0x8000000000000000ULL, 0x0000000000000000ULL }, /* 5^0 */
+    { 0xA000000000000000ULL, 0x0000000000000000ULL }, /* 5^1 */
+    { 0xC800000000000000ULL, 0x0000000000000000ULL }, /* 5^2 */
+    { 0xFA00000000000000ULL, 0x0000000000000000ULL }, /* 5^3 */
+    { 0x9C40000000000000ULL, 0x0000000000000000ULL }, /* 5^4 */
+    { 0xC350000000000000ULL, 0x0000000000000000ULL }, /* 5^5 */
+    { 0xF424000000000000ULL, 0x0000000000000000ULL }, /* 5^6 */
+    { 0x9896800000000000ULL, 0x0000000000000000ULL }, /* 5^7 */
+    { 0xBEBC200000000000ULL, 0x0000000000000000ULL }, /* 5^8 */
+    { 0xEE6B280000000000ULL, 0x0000000000000000ULL }, /* 5^9 */
+    { 0x9502F90000000000ULL, 0x0000000000000000ULL }, /* 5^10 */
+    { 0xBA43B74000000000ULL, 0x0000000000000000ULL }, /* 5^11 */
+    { 0xE8D4A51000000000ULL, 0x0000000000000000ULL }, /* 5^12 */
+    { 0x9184E72A00000000ULL, 0x0000000000000000ULL }, /* 5^13 */
+    { 0xB5E620F480000000ULL, 0x0000000000000000ULL }, /* 5^14 */
+    { 0xE35FA931A0000000ULL, 0x0000000000000000ULL }, /* 5^15 */
+    { 0x8E1BC9BF04000000ULL, 0x0000000000000000ULL }, /* 5^16 */
+    { 0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL }, /* 5^17 */
+    { 0xDE0B6B3A76400000ULL, 0x0000000000000000ULL }, /* 5^18 */
+    { 0x8AC7230489E80000ULL, 0x0000000000000000ULL }, /* 5^19 */
+    { 0xAD78EBC5AC620000ULL, 0x0000000000000000ULL }, /* 5^20 */
+    { 0xD8D726B7177A8000ULL, 0x0000000000000000ULL }, /* 5^21 */
+    { 0x878678326EAC9000ULL, 0x0000000000000000ULL }, /* 5^22 */
+    { 0xA968163F0A57B400ULL, 0x0000000000000000ULL }, /* 5^23 */
+    { 0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL }, /* 5^24 */
+    { 0x84595161401484A0ULL, 0x0000000000000000ULL }, /* 5^25 */
+    { 0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL }, /* 5^26 */
+    { 0xCECB8F27F4200F3AULL, 0x0000000000000000ULL }, /* 5^27 */
+    { 0x813F3978F8940984ULL, 0x4000000000000000ULL }, /* 5^28 */
+    { 0xA18F07D736B90BE5ULL, 0x5000000000000000ULL }, /* 5^29 */
+    { 0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL }, /* 5^30 */
+    { 0xFC6F7C4045812296ULL, 0x4D00000000000000ULL }, /* 5^31 */
+    { 0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL }, /* 5^32 */
+    { 0xC5371912364CE305ULL, 0x6C28000000000000ULL }, /* 5^33 */
+    { 0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL }, /* 5^34 */
+    { 0x9A130B963A6C115CULL, 0x3C7F400000000000ULL }, /* 5^35 */
+    { 0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL }, /* 5^36 */
+    { 0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL }, /* 5^37 */
+    { 0x96769950B50D88F4ULL, 0x1314448000000000ULL }, /* 5^38 */
+    { 0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL }, /* 5^39 */
+    { 0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL }, /* 5^40 */
+    { 0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL }, /* 5^41 */
+    { 0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL }, /* 5^42 */
+    { 0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL }, /* 5^43 */
+    { 0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL }, /* 5^44 */
+    { 0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL }, /* 5^45 */
+    { 0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL }, /* 5^46 */
+    { 0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL }, /* 5^47 */
+    { 0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL }, /* 5^48 */
+    { 0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL }, /* 5^49 */
+    { 0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL }, /* 5^50 */
+    { 0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL }, /* 5^51 */
+    { 0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL }, /* 5^52 */
+    { 0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL }, /* 5^53 */
+    { 0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL }, /* 5^54 */
+    { 0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL }, /* 5^55 */
+    { 0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL }, /* 5^56 */
+    { 0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL }, /* 5^57 */
+    { 0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL }, /* 5^58 */
+    { 0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL }, /* 5^59 */
+    { 0x9F4F2726179A2245ULL, 0x01D762422C946590ULL }, /* 5^60 */
+    { 0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL }, /* 5^61 */
+    { 0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL }, /* 5^62 */
+    { 0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL }, /* 5^63 */
+    { 0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL }, /* 5^64 */
+};
+
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+/* every power of ten up to 1e22 is exact as a double */
+static const double exact_powers_of_ten[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#endif
+
+/* high and low 64 bits of a * b */
+static void multiply_64(uint64_t a, uint64_t b, uint64_t *high, uint64_t *low)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (uint64_t)(product >> 64);
+    *low = (uint64_t)product;
+#else
+    uint64_t a_low = a & 0xFFFFFFFFU;
+    uint64_t a_high = a >> 32;
+    uint64_t b_low = b & 0xFFFFFFFFU;
+    uint64_t b_high = b >> 32;
+    uint64_t low_low = a_low * b_low;
+    uint64_t high_low = a_high * b_low;
+    uint64_t low_high = a_low * b_high;
+    uint64_t high_high = a_high * b_high;
+    uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFFU) + low_high;
+    *low = (middle << 32) | (low_low & 0xFFFFFFFFU);
+    *high = high_high + (high_low >> 32) + (middle >> 32);
+#endif
+}
+
+static int leading_zeros_64(uint64_t value)
+{
+#if defined(__GNUC__)
+    return __builtin_clzll(value);
+#else
+    int count = 0;
+    while ((value & ((uint64_t)1 << 63)) == 0)
+    {
+        value <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/* Eisel-Lemire: the double nearest to digits * 10^power for digits != 0 and power in
+ * [FAST_NUMBER_MIN_POWER, FAST_NUMBER_MAX_POWER]. The range keeps the result away from
+ * subnormals and infinity. Follows fast_float's compute_float. */
+static double eisel_lemire(uint64_t digits, int power, cJSON_bool negative)
+{
+    const uint64_t *power_of_five = powers_of_five_128[power - FAST_NUMBER_MIN_POWER];
+    uint64_t high = 0;
+    uint64_t low = 0;
+    uint64_t mantissa = 0;
+    uint64_t bits = 0;
+    int zeros = leading_zeros_64(digits);
+    int upper_bit = 0;
+    int shift = 0;
+    int binary_exponent = 0;
+    double result = 0;
+
+    digits <<= zeros;
+    multiply_64(digits, power_of_five[0], &high, &low);
+    /* the low word of the power only matters when the 55 bits we keep could still change */
+    if ((high & 0x1FF) == 0x1FF)
+    {
+        uint64_t second_high = 0;
+        uint64_t second_low = 0;
+        multiply_64(digits, power_of_five[1], &second_high, &second_low);
+        low += second_high;
+        if (second_high > low)
+        {
+            high++;
+        }
+    }
+
+    upper_bit = (int)(high >> 63);
+    shift = upper_bit + 64 - 52 - 3;
+    mantissa = high >> shift;
+    /* floor(log2(10^power)) + 63 + 1023, with floor for negative powers as well */
+    binary_exponent = ((power >= 0) ? ((217706 * power) >> 16) : -((-217706 * power + 65535) >> 16)) + 63 + upper_bit - zeros + 1023;
+
+    /* exactly halfway: round to even instead of up */
+    if ((low <= 1) && (power >= -4) && (power <= 23) && ((mantissa & 3) == 1) && ((mantissa << shift) == high))
+    {
+        mantissa &= ~(uint64_t)1;
+    }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= ((uint64_t)2 << 52))
+    {
+        mantissa = (uint64_t)1 << 52;
+        binary_exponent++;
+    }
+    mantissa &= ~((uint64_t)1 << 52);
+
+    bits = mantissa | ((uint64_t)binary_exponent << 52) | ((uint64_t)(negative ? 1 : 0) << 63);
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+/* Parse the number at input[0..length) if it has one of the usual forms
+ * -?digits(.digits)?([eE][+-]?digits)? and is followed by none of the characters the
+ * strtod path would look at. Returns false when strtod has to do it. */
+static cJSON_bool parse_number_fast(const unsigned char *input, size_t length, double *number, size_t *number_length)
+{
+    const unsigned char *pointer = input;
+    const unsigned char *end = input + length;
+    cJSON_bool negative = false;
+    uint64_t digits = 0;
+    int significant_digits = 0;
+    int power = 0;
+    int exponent = 0;
+    cJSON_bool exponent_negative = false;
+    cJSON_bool is_integer = true;
+
+    if ((pointer < end) && (*pointer == '-'))
+    {
+        negative = true;
+        pointer++;
+    }
+    if ((pointer >= end) || (*pointer < '0') || (*pointer > '9'))
+    {
+        return false;
+    }
+
+    /* integer part, leading zeros are not significant */
+    for (; (pointer < end) && (*pointer >= '0') && (*pointer <= '9'); pointer++)
+    {
+        if ((significant_digits > 0) || (*pointer != '0'))
+        {
+            digits = digits * 10 + (uint64_t)(*pointer - '0');
+            significant_digits++;
+        }
+    }
+
+    if ((pointer < end) && (*pointer == '.'))
+    {
+        pointer++;
+        is_integer = false;
+        if ((pointer >= end) || (*pointer < '0') || (*pointer > '9'))
+        {
+            return false;
+        }
+        for (; (pointer < end) && (*pointer >= '0') && (*pointer <= '9'); pointer++)
+        {
+            if ((significant_digits > 0) || (*pointer != '0'))
+            {
+                digits = digits * 10 + (uint64_t)(*pointer - '0');
+                significant_digits++;
+            }
+            power--;
+        }
+    }
+
+    if ((pointer < end) && ((*pointer == 'e') || (*pointer == 'E')))
+    {
+        pointer++;
+        is_integer = false;
+        if ((pointer < end) && ((*pointer == '+') || (*pointer == '-')))
+        {
+            exponent_negative = (*pointer == '-');
+            pointer++;
+        }
+        if ((pointer >= end) || (*pointer < '0') || (*pointer > '9'))
+        {
+            return false;
+        }
+        for (; (pointer < end) && (*pointer >= '0') && (*pointer <= '9'); pointer++)
+        {
+            if (exponent < 10000)
+            {
+                exponent = exponent * 10 + (*pointer - '0');
+            }
+        }
+        power += exponent_negative ? -exponent : exponent;
+    }
+
+    /* strtod would see more, and the old code cut numbers off after 63 characters */
+    if ((significant_digits > 19) || ((size_t)(pointer - input) >= 63))
+    {
+        return false;
+    }
+    if ((pointer < end) && ((*pointer == '.') || (*pointer == 'e') || (*pointer == 'E') || (*pointer == '+') || (*pointer == '-') || ((*pointer >= '0') && (*pointer <= '9'))))
+    {
+        return false;
+    }
+
+    if (digits == 0)
+    {
+        *number = negative ? -0.0 : 0.0;
+    }
+    else if (is_integer)
+    {
+        /* a single correctly rounded conversion, just like strtod */
+        *number = negative ? -(double)digits : (double)digits;
+    }
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+    else if ((digits <= ((uint64_t)1 << 53)) && (power >= -22) && (power <= 22))
+    {
+        /* both operands are exact, so the one rounding of the operation is the right one */
+        *number = (power < 0) ? ((double)digits / exact_powers_of_ten[-power]) : ((double)digits * exact_powers_of_ten[power]);
+        if (negative)
+        {
+            *number = -*number;
+        }
+    }
+#endif
+    else if ((power >= FAST_NUMBER_MIN_POWER) && (power <= FAST_NUMBER_MAX_POWER))
+    {
+        *number = eisel_lemire(digits, power, negative);
+    }
+    else
+    {
+        return false;
+    }
+
+    *number_length = (size_t)(pointer - input);
+    return true;
+}
+#endif
+
 /* Parse the input text to generate a number, and populate the result into item. */
 static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
 {
     double number = 0;
     unsigned char *after_end = NULL;
     unsigned char number_c_string[64];
-    unsigned char decimal_point = get_decimal_point();
+    unsigned char decimal_point = 0;
+    size_t number_length = 0;
     size_t i = 0;
 
     if ((input_buffer == NULL) || (input_buffer->content == NULL))
@@ -315,6 +890,15 @@ static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_bu
         return false;
     }
 
+#ifdef CJSON_FAST_NUMBERS
+    if (parse_number_fast(buffer_at_offset(input_buffer), input_buffer->length - input_buffer->offset, &number, &number_length))
+    {
+        goto number_done;
+    }
+#endif
+
+    decimal_point = get_decimal_point();
+
     /* copy the number into a temporary buffer and replace '.' with the decimal point
      * of the current locale (for strtod)
      * This also takes care of '\0' not necessarily being available for marking the end of the input */
@@ -355,7 +939,11 @@ loop_end:
     {
         return false; /* parse_error */
     }
+    number_length = (size_t)(after_end - number_c_string);
 
+#ifdef CJSON_FAST_NUMBERS
+number_done:
+#endif
     item->valuedouble = number;
 
     /* use saturation in case of overflow */
@@ -372,9 +960,9 @@ loop_end:
         item->valueint = (int)number;
     }
 
-    item->type = cJSON_Number;
+    item->type |= cJSON_Number;
 
-    input_buffer->offset += (size_t)(after_end - number_c_string);
+    input_buffer->offset += number_length;
     return true;
 }
 
@@ -400,8 +988,9 @@ CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
 CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
 {
     char *copy = NULL;
-    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
-    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring,
+     * except for a pooled item whose string is in the arena of its context */
+    if ((object == NULL) || !(object->type & cJSON_String) || ((object->type & (cJSON_IsReference | cJSON_IsPooled)) == cJSON_IsReference))
     {
         return NULL;
     }
@@ -420,11 +1009,12 @@ CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
     {
         return NULL;
     }
-    if (object->valuestring != NULL)
+    if ((object->valuestring != NULL) && !(object->type & cJSON_IsReference))
     {
         cJSON_free(object->valuestring);
     }
     object->valuestring = copy;
+    object->type &= ~cJSON_IsReference;
 
     return copy;
 }
@@ -438,6 +1028,8 @@ typedef struct
     cJSON_bool noalloc;
     cJSON_bool format; /* is this print a formatted print */
     internal_hooks hooks;
+    cJSON_WriteFunction flush; /* when set, full buffers are handed to it instead of growing */
+    void *target;
 } printbuffer;
 
 /* realloc printbuffer if necessary to have at least "needed" bytes more */
@@ -457,7 +1049,7 @@ static unsigned char* ensure(printbuffer * const p, size_t needed)
         return NULL;
     }
 
-    if (needed > INT_MAX)
+    if ((needed > INT_MAX) && (p->flush == NULL))
     {
         /* sizes bigger than INT_MAX are currently not supported */
         return NULL;
@@ -469,12 +1061,28 @@ static unsigned char* ensure(printbuffer * const p, size_t needed)
         return p->buffer + p->offset;
     }
 
-    if (p->noalloc) {
+    if (p->flush != NULL)
+    {
+        /* everything before the offset is final, write it out and start over at the front */
+        if ((p->offset > 0) && !p->flush(p->target, (const char*)p->buffer, p->offset))
+        {
+            return NULL;
+        }
+        needed -= p->offset;
+        p->offset = 0;
+        if (needed <= p->length)
+        {
+            return p->buffer;
+        }
+        /* a single piece longer than the buffer, grow just enough for it */
+        newsize = needed;
+    }
+    else if (p->noalloc)
+    {
         return NULL;
     }
-
     /* calculate new buffer size */
-    if (needed > (INT_MAX / 2))
+    else if (needed > (INT_MAX / 2))
     {
         /* overflow of int, use INT_MAX if possible */
         if (needed <= INT_MAX)
@@ -546,123 +1154,799 @@ static cJSON_bool compare_double(double a, double b)
     return (fabs(a - b) <= maxVal * DBL_EPSILON);
 }
 
-/* Render the number nicely from the given item into a string. */
-static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+#ifdef CJSON_FAST_NUMBERS
+/* Shortest round trip formatting of doubles with the Ryu algorithm (Ulf Adams, 2018).
+ * It finds the shortest decimal in the interval of values that parse back to the same
+ * double, and of those the one closest to it, using 128 bit approximations of powers of
+ * five. When 15 digits are enough, the digits are the same as "%1.15g" gives. */
+#define RYU_POW5_INV_BITCOUNT 125
+#define RYU_POW5_BITCOUNT 125
+
+/* ceil(2^(bitlength(5^i) - 1 + 125) / 5^i) for i in [0, 341], as { low word, high word } */
+static const uint64_t ryu_pow5_inv_split[342][2] =
 {
-    unsigned char *output_pointer = NULL;
-    double d = item->valuedouble;
-    int length = 0;
-    size_t i = 0;
-    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
-    unsigned char decimal_point = get_decimal_point();
-    double test = 0.0;
+    { 0x0000000000000001ULL, 0x2000000000000000ULL }, { 0x999999999999999AULL, 0x1999999999999999ULL },
+    { 0x47AE147AE147AE15ULL, 0x147AE147AE147AE1ULL }, { 0x6C8B4395810624DEULL, 0x10624DD2F1A9FBE7ULL },
+    { 0x7A786C226809D496ULL, 0x1A36E2EB1C432CA5ULL }, { 0x61F9F01B866E43ABULL, 0x14F8B588E368F084ULL },
+    { 0xB4C7F34938583622ULL, 0x10C6F7A0B5ED8D36ULL }, { 0x87A6520EC08D236AULL, 0x1AD7F29ABCAF4857ULL },
+    { 0x9FB841A566D74F88ULL, 0x15798EE2308C39DFULL }, { 0xE62D01511F12A607ULL, 0x112E0BE826D694B2ULL },
+    { 0xD6AE6881CB5109A4ULL, 0x1B7CDFD9D7BDBAB7ULL }, { 0xDEF1ED34A2A73AEAULL, 0x15FD7FE17964955FULL },
+    { 0x7F27F0F6E885C8BBULL, 0x119799812DEA1119ULL }, { 0x650CB4BE40D60DF8ULL, 0x1C25C268497681C2ULL },
+    { 0xEA70909833DE7193ULL, 0x16849B86A12B9B01ULL }, { 0x21F3A6E0297EC143ULL, 0x1203AF9EE756159BULL },
+    { 0x6985D7CD0F313537ULL, 0x1CD2B297D889BC2BULL }, { 0x2137DFD73F5A90F9ULL, 0x170EF54646D49689ULL },
+    { 0xE75FE645CC4873FAULL, 0x12725DD1D243ABA0ULL }, { 0xA5663D3C7A0D865DULL, 0x1D83C94FB6D2AC34ULL },
+    { 0x511E976394D79EB1ULL, 0x179CA10C9242235DULL }, { 0xDA7EDF82DD794BC1ULL, 0x12E3B40A0E9B4F7DULL },
+    { 0x2A6498D1625BAC68ULL, 0x1E392010175EE596ULL }, { 0xEEB6E0A781E2F053ULL, 0x182DB34012B25144ULL },
+    { 0x58924D52CE4F26A9ULL, 0x1357C299A88EA76AULL }, { 0x27507BB7B07EA441ULL, 0x1EF2D0F5DA7DD8AAULL },
+    { 0x52A6C95FC0655034ULL, 0x18C240C4AECB13BBULL }, { 0x0EEBD44C99EAA690ULL, 0x13CE9A36F23C0FC9ULL },
+    { 0xB17953ADC3110A80ULL, 0x1FB0F6BE50601941ULL }, { 0xC12DDC8B02740867ULL, 0x195A5EFEA6B34767ULL },
+    { 0x3424B06F3529A052ULL, 0x14484BFEEBC29F86ULL }, { 0x901D59F290EE19DBULL, 0x1039D66589687F9EULL },
+    { 0x4CFBC31DB4B0295FULL, 0x19F623D5A8A73297ULL }, { 0x3D9635B15D59BAB2ULL, 0x14C4E977BA1F5BACULL },
+    { 0x97AB5E277DE16228ULL, 0x109D8792FB4C4956ULL }, { 0xF2ABC9D8C9689D0DULL, 0x1A95A5B7F87A0EF0ULL },
+    { 0x5BBCA17A3ABA173EULL, 0x154484932D2E725AULL }, { 0xAFCA1AC82EFB45CBULL, 0x11039D428A8B8EAEULL },
+    { 0xB2DCF7A6B1920945ULL, 0x1B38FB9DAA78E44AULL }, { 0xF57D92EBC141A104ULL, 0x15C72FB1552D836EULL },
+    { 0xC46475896767B403ULL, 0x116C262777579C58ULL }, { 0x6D6D88DBD8A5ECD2ULL, 0x1BE03D0BF225C6F4ULL },
+    { 0x8ABE071646EB23DBULL, 0x164CFDA3281E38C3ULL }, { 0x6EFE6C11D255B649ULL, 0x11D7314F534B609CULL },
+    { 0xB197134FB6EF8A0EULL, 0x1C8B821885456760ULL }, { 0x27AC0F72F8BFA1A5ULL, 0x16D601AD376AB91AULL },
+    { 0xB95672C260994E1EULL, 0x1244CE242C5560E1ULL }, { 0xF5571E03CDC21695ULL, 0x1D3AE36D13BBCE35ULL },
+    { 0x2AAC18030B01ABABULL, 0x17624F8A762FD82BULL }, { 0xBBBCE0026F348956ULL, 0x12B50C6EC4F31355ULL },
+    { 0x92C7CCD0B1EDA889ULL, 0x1DEE7A4AD4B81EEFULL }, { 0xDBD30A408E57BA07ULL, 0x17F1FB6F10934BF2ULL },
+    { 0x7CA8D50071DFC806ULL, 0x1327FC58DA0F6FF5ULL }, { 0xFAA7BB33E9660CD6ULL, 0x1EA6608E29B24CBBULL },
+    { 0x9552FC298784D711ULL, 0x18851A0B548EA3C9ULL }, { 0xAAA8C9BAD2D0AC0EULL, 0x139DAE6F76D88307ULL },
+    { 0xDDDADC5E1E1AACE3ULL, 0x1F62B0B257C0D1A5ULL }, { 0x7E48B04B4B488A4FULL, 0x191BC08EAC9A4151ULL },
+    { 0xCB6D59D5D5D3A1D9ULL, 0x141633A556E1CDDAULL }, { 0x3C577B1177DC817BULL, 0x1011C2EAABE7D7E2ULL },
+    { 0xC6F25E825960CF2AULL, 0x19B604AAACA62636ULL }, { 0x6BF518684780A5BBULL, 0x14919D5556EB51C5ULL },
+    { 0x232A79ED06008496ULL, 0x10747DDDDF22A7D1ULL }, { 0xD1DD8FE1A3340756ULL, 0x1A53FC9631D10C81ULL },
+    { 0xA7E4731AE8F66C45ULL, 0x150FFD44F4A73D34ULL }, { 0x531D28E253F8569EULL, 0x10D9976A5D52975DULL },
+    { 0xEB61DB03B98D5762ULL, 0x1AF5BF109550F22EULL }, { 0xBC4E48CFC7A445E8ULL, 0x159165A6DDDA5B58ULL },
+    { 0x6371D3D96C836B20ULL, 0x11411E1F17E1E2ADULL }, { 0x9F1C8628AD9F11CDULL, 0x1B9B6364F3030448ULL },
+    { 0xE5B06B53BE18DB0BULL, 0x1615E91D8F359D06ULL }, { 0xEAF3890FCB4715A2ULL, 0x11AB20E472914A6BULL },
+    { 0x44B8DB4C7871BC37ULL, 0x1C45016D841BAA46ULL }, { 0x03C715D6C6C1635FULL, 0x169D9ABE03495505ULL },
+    { 0x3638DE456BCDE919ULL, 0x1217AEFE69077737ULL }, { 0x56C163A2461641C1ULL, 0x1CF2B1970E725858ULL },
+    { 0xDF011C81D1AB67CEULL, 0x17288E1271F51379ULL }, { 0x7F3416CE4155ECA5ULL, 0x1286D80EC190DC61ULL },
+    { 0x6520247D3556476EULL, 0x1DA48CE468E7C702ULL }, { 0xEA801D30F7783925ULL, 0x17B6D71D20B96C01ULL },
+    { 0xBB99B0F3F92CFA84ULL, 0x12F8AC174D612334ULL }, { 0x5F5C4E532847F739ULL, 0x1E5AACF215683854ULL },
+    { 0x7F7D0B75B9D32C2EULL, 0x18488A5B44536043ULL }, { 0x9930D5F7C7DC2358ULL, 0x136D3B7C36A919CFULL },
+    { 0x8EB4898C72F9D226ULL, 0x1F152BF9F10E8FB2ULL }, { 0x722A07A38F2E41B8ULL, 0x18DDBCC7F40BA628ULL },
+    { 0xC1BB394FA5BE9AFAULL, 0x13E497065CD61E86ULL }, { 0x9C5EC2190930F7F6ULL, 0x1FD424D6FAF030D7ULL },
+    { 0x49E56814075A5FF8ULL, 0x197683DF2F268D79ULL }, { 0x6E51201005E1E660ULL, 0x145ECFE5BF520AC7ULL },
+    { 0xF1DA800CD181851AULL, 0x104BD984990E6F05ULL }, { 0x4FC400148268D4F5ULL, 0x1A12F5A0F4E3E4D6ULL },
+    { 0xD96999AA01ED772BULL, 0x14DBF7B3F71CB711ULL }, { 0xADEE1488018AC5BCULL, 0x10AFF95CC5B09274ULL },
+    { 0x497CEDA668DE092CULL, 0x1AB328946F80EA54ULL }, { 0x3ACA57B853E4D424ULL, 0x155C2076BF9A5510ULL },
+    { 0x623B7960431D7683ULL, 0x1116805EFFAEAA73ULL }, { 0x9D2BF566D1C8BD9EULL, 0x1B5733CB32B110B8ULL },
+    { 0x7DBCC452416D647FULL, 0x15DF5CA28EF40D60ULL }, { 0xCAFD69DB678AB6CCULL, 0x117F7D4ED8C33DE6ULL },
+    { 0xAB2F0FC572778ADFULL, 0x1BFF2EE48E052FD7ULL }, { 0x88F273045B92D580ULL, 0x1665BF1D3E6A8CACULL },
+    { 0xD3F528D049424466ULL, 0x11EAFF4A98553D56ULL }, { 0xB988414D4203A0A3ULL, 0x1CAB3210F3BB9557ULL },
+    { 0x6139CDD76802E6E9ULL, 0x16EF5B40C2FC7779ULL }, { 0xE761717920025254ULL, 0x125915CD68C9F92DULL },
+    { 0xA568B58E999D5086ULL, 0x1D5B561574765B7CULL }, { 0x5120913EE14AA6D2ULL, 0x177C44DDF6C515FDULL },
+    { 0xA74D40FF1AA21F0EULL, 0x12C9D0B1923744CAULL }, { 0x0BAECE64F769CB4AULL, 0x1E0FB44F50586E11ULL },
+    { 0x3C8BD850C5EE3C3BULL, 0x180C903F7379F1A7ULL }, { 0xCA0979DA37F1C9C9ULL, 0x133D4032C2C7F485ULL },
+    { 0xA9A8C2F6BFE942DBULL, 0x1EC866B79E0CBA6FULL }, { 0x2153CF2BCCBA9BE3ULL, 0x18A0522C7E709526ULL },
+    { 0x1AA9728970954982ULL, 0x13B374F06526DDB8ULL }, { 0xF775840F1A88759DULL, 0x1F8587E7083E2F8CULL },
+    { 0x5F9136727BA05E17ULL, 0x19379FEC0698260AULL }, { 0x1940F85B9619E4DFULL, 0x142C7FF0054684D5ULL },
+    { 0xE100C6AFAB47EA4CULL, 0x1023998CD1053710ULL }, { 0xCE67A44C453FDD47ULL, 0x19D28F47B4D524E7ULL },
+    { 0xD852E9D69DCCB106ULL, 0x14A8729FC3DDB71FULL }, { 0x79DBEE454B0A2738ULL, 0x1086C219697E2C19ULL },
+    { 0x295FE3A211A9D859ULL, 0x1A71368F0F30468FULL }, { 0xBAB31C81A7BB137AULL, 0x15275ED8D8F36BA5ULL },
+    { 0x6228E39AEC95A92FULL, 0x10EC4BE0AD8F8951ULL }, { 0x9D0E38F7E0EF7517ULL, 0x1B13AC9AAF4C0EE8ULL },
+    { 0xB0D82D931A592A79ULL, 0x15A956E225D67253ULL }, { 0x8D79BE0F4847552EULL, 0x11544581B7DEC1DCULL },
+    { 0x158F967EDA0BBB7CULL, 0x1BBA08CF8C979C94ULL }, { 0x77A611FF14D62F97ULL, 0x162E6D72D6DFB076ULL },
+    { 0xF951A7FF43DE8C79ULL, 0x11BEBDF578B2F391ULL }, { 0xC21C3FFED2FDAD8EULL, 0x1C6463225AB7EC1CULL },
+    { 0x01B0333242648AD8ULL, 0x16B6B5B5155FF017ULL }, { 0x0159C28E9B83A246ULL, 0x122BC490DDE659ACULL },
+    { 0xCEF604175F3903A3ULL, 0x1D12D41AFCA3C2ACULL }, { 0x725E69AC4C2D9C83ULL, 0x17424348CA1C9BBDULL },
+    { 0xF5185489D68AE39CULL, 0x129B69070816E2FDULL }, { 0xEE8D540FBDAB05C6ULL, 0x1DC574D80CF16B2FULL },
+    { 0xBED77672FE226B05ULL, 0x17D12A4670C1228CULL }, { 0xFF12C528CB4EBC04ULL, 0x130DBB6B8D674ED6ULL },
+    { 0xCB513B74787DF9A0ULL, 0x1E7C5F127BD87E24ULL }, { 0x090DC929F9FE614DULL, 0x18637F41FCAD31B7ULL },
+    { 0xA0D7D42194CB810AULL, 0x1382CC34CA2427C5ULL }, { 0x67BFB9CF5478CE77ULL, 0x1F37AD21436D0C6FULL },
+    { 0x1FCC94A5DD2D71F9ULL, 0x18F9574DCF8A7059ULL }, { 0x7FD6DD517DBDF4C7ULL, 0x13FAAC3E3FA1F37AULL },
+    { 0xFFBE2EE8C92FEE0BULL, 0x1FF779FD329CB8C3ULL }, { 0x6631BF20A0F324D6ULL, 0x1992C7FDC216FA36ULL },
+    { 0xB827CC1A1A5C1D78ULL, 0x14756CCB01ABFB5EULL }, { 0x935309AE7B7CE460ULL, 0x105DF0A267BCC918ULL },
+    { 0x1EEB42B0C594A099ULL, 0x1A2FE76A3F9474F4ULL }, { 0xE58902270476E6E1ULL, 0x14F31F8832DD2A5CULL },
+    { 0xB7A0CE859D2BEBE7ULL, 0x10C27FA028B0EEB0ULL }, { 0x59014A6F61DFDFD8ULL, 0x1AD0CC33744E4AB4ULL },
+    { 0xE0CDD525E7E64CADULL, 0x1573D68F903EA229ULL }, { 0x4D7177518651D6F1ULL, 0x11297872D9CBB4EEULL },
+    { 0x7BE8BEE8D6E957E8ULL, 0x1B758D848FAC54B0ULL }, { 0xFCBA3253DF211320ULL, 0x15F7A46A0C89DD59ULL },
+    { 0x63C8284318E74280ULL, 0x1192E9EE706E4AAEULL }, { 0x060D0D3827D86A66ULL, 0x1C1E43171A4A1117ULL },
+    { 0x6B3DA42CECAD21EBULL, 0x167E9C127B6E7412ULL }, { 0x88FE1CF0BD574E56ULL, 0x11FEE341FC585CDBULL },
+    { 0x419694B462254A23ULL, 0x1CCB0536608D615FULL }, { 0x67ABAA29E81DD4E9ULL, 0x1708D0F84D3DE77FULL },
+    { 0xB95621BB2017DD87ULL, 0x126D73F9D764B932ULL }, { 0xC223692B668C95A5ULL, 0x1D7BECC2F23AC1EAULL },
+    { 0xCE82BA891ED6DE1DULL, 0x179657025B6234BBULL }, { 0xA53562074BDF1818ULL, 0x12DEAC01E2B4F6FCULL },
+    { 0x3B889CD87964F359ULL, 0x1E3113363787F194ULL }, { 0xFC6D4A46C783F5E1ULL, 0x18274291C6065ADCULL },
+    { 0x30576E9F06032B1AULL, 0x13529BA7D19EAF17ULL }, { 0x1A257DCB3CD1DE90ULL, 0x1EEA92A61C311825ULL },
+    { 0x481DFE3C30A7E540ULL, 0x18BBA884E35A79B7ULL }, { 0xD34B31C9C0865100ULL, 0x13C9539D82AEC7C5ULL },
+    { 0x5211E942CDA3B4CDULL, 0x1FA885C8D117A609ULL }, { 0x74DB21023E1C90A4ULL, 0x19539E3A40DFB807ULL },
+    { 0xF715B401CB4A0D50ULL, 0x1442E4FB67196005ULL }, { 0xF8DE299B09080AA7ULL, 0x103583FC527AB337ULL },
+    { 0x8E304291A80CDDD7ULL, 0x19EF3993B72AB859ULL }, { 0x3E8D020E200A4B13ULL, 0x14BF6142F8EEF9E1ULL },
+    { 0x653D9B3E80083C0FULL, 0x10991A9BFA58C7E7ULL }, { 0x6EC8F864000D2CE4ULL, 0x1A8E90F9908E0CA5ULL },
+    { 0x8BD3F9E999A423EAULL, 0x153EDA614071A3B7ULL }, { 0x3CA994BAE1501CBBULL, 0x10FF151A99F482F9ULL },
+    { 0xC775BAC49BB3612BULL, 0x1B31BB5DC320D18EULL }, { 0xD2C4956A16291A89ULL, 0x15C162B168E70E0BULL },
+    { 0xDBD0778811BA7BA1ULL, 0x11678227871F3E6FULL }, { 0x2C80BF401C5D929BULL, 0x1BD8D03F3E9863E6ULL },
+    { 0xBD33CC3349E47549ULL, 0x16470CFF6546B651ULL }, { 0xCA8FD68F6E505DD4ULL, 0x11D270CC51055EA7ULL },
+    { 0x4419574BE3B3C953ULL, 0x1C83E7AD4E6EFDD9ULL }, { 0x0347790982F63AA9ULL, 0x16CFEC8AA52597E1ULL },
+    { 0xCF6C60D468C4FBBAULL, 0x123FF06EEA847980ULL }, { 0xE57A34870E07F92AULL, 0x1D331A4B10D3F59AULL },
+    { 0x512E906C0B399422ULL, 0x175C1508DA432AE2ULL }, { 0xDA8BA6BCD5C7A9B5ULL, 0x12B010D3E1CF5581ULL },
+    { 0x90DF712E22D90F87ULL, 0x1DE6815302E5559CULL }, { 0xDA4C5A8B4F140C6CULL, 0x17EB9AA8CF1DDE16ULL },
+    { 0xAEA37BA2A5A9A38AULL, 0x1322E220A5B17E78ULL }, { 0x7DD25F6AA2A905A9ULL, 0x1E9E369AA2B59727ULL },
+    { 0x97DB7F888220D154ULL, 0x187E92154EF7AC1FULL }, { 0x797C6606CE80A777ULL, 0x139874DDD8C6234CULL },
+    { 0x8F2D700AE4010BF1ULL, 0x1F5A549627A36BADULL }, { 0x0C2459A25000D65AULL, 0x191510781FB5EFBEULL },
+    { 0x701D1481D99A4515ULL, 0x1410D9F9B2F7F2FEULL }, { 0xC017439B147B6A77ULL, 0x100D7B2E28C65BFEULL },
+    { 0xCCF205C4ED9243F2ULL, 0x19AF2B7D0E0A2CCAULL }, { 0x0A5B37D0BE0E9CC2ULL, 0x148C22CA71A1BD6FULL },
+    { 0x0848F973CB3EE3CEULL, 0x10701BD527B4978CULL }, { 0xDA0E5BEC78649FB0ULL, 0x1A4CF9550C5425ACULL },
+    { 0x7B3EAFF060507FC0ULL, 0x150A6110D6A9B7BDULL }, { 0x95CBBFF380406633ULL, 0x10D51A73DEEE2C97ULL },
+    { 0xEFAC665266CD7052ULL, 0x1AEE90B964B04758ULL }, { 0x2623850EB8A459DBULL, 0x158BA6FAB6F36C47ULL },
+    { 0x1E82D0D893B6AE49ULL, 0x113C85955F29236CULL }, { 0xFD9E1AF41F8AB075ULL, 0x1B9408EEFEA838ACULL },
+    { 0x97B1AF29B2D559F7ULL, 0x16100725988693BDULL }, { 0xAC8E25BAF5777B2CULL, 0x11A66C1E139EDC97ULL },
+    { 0x7A7D092B2258C513ULL, 0x1C3D79C9B8FE2DBFULL }, { 0x61FDA0EF4EAD6A76ULL, 0x169794A160CB57CCULL },
+    { 0xE7FE1A590BBDEEC5ULL, 0x1212DD4DE7091309ULL }, { 0xA6635D5B45FCB13AULL, 0x1CEAFBAFD80E84DCULL },
+    { 0x851C4AAF6B308DC8ULL, 0x172262F3133ED0B0ULL }, { 0xD0E36EF2BC26D7D4ULL, 0x1281E8C275CBDA26ULL },
+    { 0xB49F17EAC6A48C86ULL, 0x1D9CA79D894629D7ULL }, { 0x2A18DFEF0550706BULL, 0x17B08617A104EE46ULL },
+    { 0x54E0B3259DD9F389ULL, 0x12F39E794D9D8B6BULL }, { 0x87CDEB6F62F65274ULL, 0x1E5297287C2F4578ULL },
+    { 0xD30B22BF825EA85DULL, 0x18421286C9BF6AC6ULL }, { 0x0F3C1BCC684BB9E4ULL, 0x13680ED23AFF889FULL },
+    { 0x18602C7A4079296DULL, 0x1F0CE4839198DA98ULL }, { 0x46B356C833942124ULL, 0x18D71D360E13E213ULL },
+    { 0x388F78A029434DB6ULL, 0x13DF4A91A4DCB4DCULL }, { 0x5A7F2766A86BAF8AULL, 0x1FCBAA82A1612160ULL },
+    { 0x153285EBB9EFBFA2ULL, 0x196FBB9BB44DB44DULL }, { 0xAA8ED189618C994EULL, 0x145962E2F6A4903DULL },
+    { 0xEED8A7A11AD6E10CULL, 0x1047824F2BB6D9CAULL }, { 0x7E27729B5E249B45ULL, 0x1A0C03B1DF8AF611ULL },
+    { 0xFE85F549181D4904ULL, 0x14D6695B193BF80DULL }, { 0xCB9E5DD4134AA0D0ULL, 0x10AB877C142FF9A4ULL },
+    { 0xDF63C9535211014DULL, 0x1AAC0BF9B9E65C3AULL }, { 0x191CA10F74DA6771ULL, 0x15566FFAFB1EB02FULL },
+    { 0xADB080D92A4852C1ULL, 0x1111F32F2F4BC025ULL }, { 0x15E7348EAA0D5134ULL, 0x1B4FEB7EB212CD09ULL },
+    { 0xAB1F5D3EEE710DC4ULL, 0x15D98932280F0A6DULL }, { 0xBC1917658B8DA49DULL, 0x117AD428200C0857ULL },
+    { 0x2CF4F23C127C3A94ULL, 0x1BF7B9D9CCE00D59ULL }, { 0xF0C3F4FCDB969543ULL, 0x165FC7E170B33DE0ULL },
+    { 0x5A365D9716121103ULL, 0x11E6398126F5CB1AULL }, { 0x9056FC24F01CE804ULL, 0x1CA38F350B22DE90ULL },
+    { 0xD9DF301D8CE3ECD0ULL, 0x16E93F5DA2824BA6ULL }, { 0xE17F59B13D8323DAULL, 0x125432B14ECEA2EBULL },
+    { 0x68CBC2B52F38395CULL, 0x1D53844EE47DD179ULL }, { 0x53D6355DBF602DE3ULL, 0x177603725064A794ULL },
+    { 0xA9782AB165E68B1CULL, 0x12C4CF8EA6B6EC76ULL }, { 0x0F26AAB56FD744FAULL, 0x1E07B27DD78B13F1ULL },
+    { 0x3F52222ABFDF6A62ULL, 0x18062864AC6F4327ULL }, { 0x65DB4E88997F884EULL, 0x1338205089F29C1FULL },
+    { 0x6FC54A7428CC0D4AULL, 0x1EC033B40FEA9365ULL }, { 0x596AA1F68709A43BULL, 0x1899C2F673220F84ULL },
+    { 0xADEEE7F86C07B696ULL, 0x13AE3591F5B4D936ULL }, { 0x497E3FF3E00C5756ULL, 0x1F7D228322BAF524ULL },
+    { 0xD464FFF64CD6AC45ULL, 0x1930E868E89590E9ULL }, { 0x4383FFF83D7889D1ULL, 0x14272053ED4473EEULL },
+    { 0xCF9CCCC69793A174ULL, 0x101F4D0FF1038FF1ULL }, { 0x7F6147A425B90252ULL, 0x19CBAE7FE805B31CULL },
+    { 0xCC4DD2E9B7C7350FULL, 0x14A2F1FFECD15C16ULL }, { 0x3D0B0F215FD290D9ULL, 0x10825B3323DAB012ULL },
+    { 0x61AB4B689950E7C1ULL, 0x1A6A2B85062AB350ULL }, { 0x4E22A2BA1440B967ULL, 0x1521BC6A6B555C40ULL },
+    { 0x0B4EE894DD009453ULL, 0x10E7C9EEBC4449CDULL }, { 0x1217DA87C800ED51ULL, 0x1B0C764AC6D3A948ULL },
+    { 0xDB46486CA000BDDAULL, 0x15A391D56BDC876CULL }, { 0x490506BD4CCD64AFULL, 0x114FA7DDEFE39F8AULL },
+    { 0xA8080AC87AE23AB1ULL, 0x1BB2A62FE638FF43ULL }, { 0x5339A239FBE82EF4ULL, 0x162884F31E93FF69ULL },
+    { 0x75C7B4FB2FECF25DULL, 0x11BA03F5B20FFF87ULL }, { 0x22D92191E647EA2EULL, 0x1C5CD322B67FFF3FULL },
+    { 0xB57A8141850654F2ULL, 0x16B0A8E891FFFF65ULL }, { 0xC4620101373843F5ULL, 0x1226ED86DB3332B7ULL },
+    { 0x3A366801F1F39FEEULL, 0x1D0B15A491EB8459ULL }, { 0xFB5EB99B27F6198BULL, 0x173C115074BC69E0ULL },
+    { 0x2F7EFAE2865E7AD6ULL, 0x129674405D6387E7ULL }, { 0xE597F7D0D6FD9156ULL, 0x1DBD86CD6238D971ULL },
+    { 0x8479930D78CADAABULL, 0x17CAD23DE82D7AC1ULL }, { 0xD06142712D6F1556ULL, 0x1308A831868AC89AULL },
+    { 0x4D686A4EAF182222ULL, 0x1E74404F3DAADA91ULL }, { 0xA453883EF279B4E8ULL, 0x185D003F6488AEDAULL },
+    { 0xE9DC6CFF28615D87ULL, 0x137D99CC506D58AEULL }, { 0xA960AE650D6895A4ULL, 0x1F2F5C7A1A488DE4ULL },
+    { 0xBAB3BEB73DED4483ULL, 0x18F2B061AEA07183ULL }, { 0x2EF6322C318A9D36ULL, 0x13F559E7BEE6C136ULL },
+    { 0xE4BD1D13827761F0ULL, 0x1FEEF63F97D79B89ULL }, { 0x83CA7DA9352C4E5AULL, 0x198BF832DFDFAFA1ULL },
+    { 0x9CA1FE20F756A515ULL, 0x146FF9C24CB2F2E7ULL }, { 0x4A1B31B3F9121DAAULL, 0x1059949B708F28B9ULL },
+    { 0x435EB5ECC1B695DDULL, 0x1A28EDC580E50DF5ULL }, { 0x35E55E57015EDE4AULL, 0x14ED8B04671DA4C4ULL },
+    { 0xC4B77EAC0118B1D5ULL, 0x10BE08D0527E1D69ULL }, { 0xA12597799B5AB622ULL, 0x1AC9A7B3B7302F0FULL },
+    { 0x4DB7AC6149155E81ULL, 0x156E1FC2F8F358D9ULL }, { 0xD7C6238107444B9BULL, 0x1124E63593F5E0ADULL },
+    { 0x593D059B3ED3AC2BULL, 0x1B6E3D2286563449ULL }, { 0xE0FD9E15CBDC89BCULL, 0x15F1CA820511C36DULL },
+    { 0xB3FE18116FE3A163ULL, 0x118E3B9B37416924ULL }, { 0x866359B57FD29BD1ULL, 0x1C16C5C525357507ULL },
+    { 0xD1E91491330EE30EULL, 0x16789E3750F790D2ULL }, { 0x74BA76DA8F3F1C0BULL, 0x11FA182C40C60D75ULL },
+    { 0xEDF72490E531C678ULL, 0x1CC359E067A348BBULL }, { 0x8B2C1D40B75B052DULL, 0x1702AE4D1FB5D3C9ULL },
+    { 0x6F567DCD5F7C0424ULL, 0x12688B70E62B0FD4ULL }, { 0x7EF0C94898C66D06ULL, 0x1D74124E3D11B2EDULL },
+    { 0x98C0A106E09EBD9FULL, 0x17900EA4FDA7C257ULL }, { 0x470080D24D4BCAE6ULL, 0x12D9A550CAEC9B79ULL },
+    { 0xD800CE1D487944A2ULL, 0x1E29088144ADC58EULL }, { 0x1333D8176D2DD082ULL, 0x1820D39A9D57D13FULL },
+    { 0xA8F646792424A6CEULL, 0x134D76154AACA765ULL }, { 0x74BD3D8EA03AA47DULL, 0x1EE25688777AA56FULL },
+    { 0x5D64313EE6955064ULL, 0x18B51206C5FBB78CULL }, { 0x4AB68DCBEBAAA6B7ULL, 0x13C40E6BD1962C70ULL },
+    { 0x1124161312AAA457ULL, 0x1FA01712E8F0471AULL }, { 0xDA8344DC0EEEE9DFULL, 0x194CDF4253F36C14ULL },
+    { 0xE2029D7CD8BF2180ULL, 0x143D7F6843292343ULL }, { 0x4E687DFD7A328133ULL, 0x103132B9CF541C36ULL },
+    { 0x4A40C9959050CEB8ULL, 0x19E851294BB9C6BDULL }, { 0x0833D477A6A70BC6ULL, 0x14B9DA876FC7D231ULL },
+    { 0xA02976C61EEC096BULL, 0x1094AED2BFD30E8DULL }, { 0x004257A364ACDBDFULL, 0x1A877E1DFFB81749ULL },
+    { 0xCD01DFB5EA23E319ULL, 0x153931B1996012A0ULL }, { 0x70CE4C91881CB5AEULL, 0x10FA8E27ADE6754DULL },
+    { 0x1AE3ADB5A69455E2ULL, 0x1B2A7D0C4970BBAFULL }, { 0x7BE957C4854377E8ULL, 0x15BB973D078D62F2ULL },
+    { 0xC987796A0435F987ULL, 0x1162DF64060AB58EULL }, { 0x75A58F1006BCC271ULL, 0x1BD1656CD67788E4ULL },
+    { 0xF7B7A5A66BCA3527ULL, 0x16411DF0AB92D3E9ULL }, { 0x5FC61E1EBCA1C41FULL, 0x11CDB18D560F0FEEULL },
+    { 0xFFA363646102D365ULL, 0x1C7C4F4889B1B316ULL }, { 0x32E91C504D9BDC51ULL, 0x16C9D906D48E28DFULL },
+    { 0x8F20E37371497D0EULL, 0x123B140576D820B2ULL }, { 0x7E9B0585820F2E7CULL, 0x1D2B533BF159CDEAULL },
+    { 0xCBAF379E01A5BECAULL, 0x1755DC2FF447D7EEULL }, { 0x0958F94B348498A1ULL, 0x12AB168CC36CACBFULL }
+};
+
+/* the top 125 bits of 5^i for i in [0, 325], as { low word, high word } */
+static const uint64_t ryu_pow5_split[326][2] =
+{
+    { 0x0000000000000000ULL, 0x1000000000000000ULL }, { 0x0000000000000000ULL, 0x1400000000000000ULL },
+    { 0x0000000000000000ULL, 0x1900000000000000ULL }, { 0x0000000000000000ULL, 0x1F40000000000000ULL },
+    { 0x0000000000000000ULL, 0x1388000000000000ULL }, { 0x0000000000000000ULL, 0x186A000000000000ULL },
+    { 0x0000000000000000ULL, 0x1E84800000000000ULL }, { 0x0000000000000000ULL, 0x1312D00000000000ULL },
+    { 0x0000000000000000ULL, 0x17D7840000000000ULL }, { 0x0000000000000000ULL, 0x1DCD650000000000ULL },
+    { 0x0000000000000000ULL, 0x12A05F2000000000ULL }, { 0x0000000000000000ULL, 0x174876E800000000ULL },
+    { 0x0000000000000000ULL, 0x1D1A94A200000000ULL }, { 0x0000000000000000ULL, 0x12309CE540000000ULL },
+    { 0x0000000000000000ULL, 0x16BCC41E90000000ULL }, { 0x0000000000000000ULL, 0x1C6BF52634000000ULL },
+    { 0x0000000000000000ULL, 0x11C37937E0800000ULL }, { 0x0000000000000000ULL, 0x16345785D8A00000ULL },
+    { 0x0000000000000000ULL, 0x1BC16D674EC80000ULL }, { 0x0000000000000000ULL, 0x1158E460913D0000ULL },
+    { 0x0000000000000000ULL, 0x15AF1D78B58C4000ULL }, { 0x0000000000000000ULL, 0x1B1AE4D6E2EF5000ULL },
+    { 0x0000000000000000ULL, 0x10F0CF064DD59200ULL }, { 0x0000000000000000ULL, 0x152D02C7E14AF680ULL },
+    { 0x0000000000000000ULL, 0x1A784379D99DB420ULL }, { 0x0000000000000000ULL, 0x108B2A2C28029094ULL },
+    { 0x0000000000000000ULL, 0x14ADF4B7320334B9ULL }, { 0x4000000000000000ULL, 0x19D971E4FE8401E7ULL },
+    { 0x8800000000000000ULL, 0x1027E72F1F128130ULL }, { 0xAA00000000000000ULL, 0x1431E0FAE6D7217CULL },
+    { 0xD480000000000000ULL, 0x193E5939A08CE9DBULL }, { 0xC9A0000000000000ULL, 0x1F8DEF8808B02452ULL },
+    { 0xBE04000000000000ULL, 0x13B8B5B5056E16B3ULL }, { 0xAD85000000000000ULL, 0x18A6E32246C99C60ULL },
+    { 0xD8E6400000000000ULL, 0x1ED09BEAD87C0378ULL }, { 0x878FE80000000000ULL, 0x13426172C74D822BULL },
+    { 0x6973E20000000000ULL, 0x1812F9CF7920E2B6ULL }, { 0x03D0DA8000000000ULL, 0x1E17B84357691B64ULL },
+    { 0x8262889000000000ULL, 0x12CED32A16A1B11EULL }, { 0x22FB2AB400000000ULL, 0x178287F49C4A1D66ULL },
+    { 0xABB9F56100000000ULL, 0x1D6329F1C35CA4BFULL }, { 0xCB54395CA0000000ULL, 0x125DFA371A19E6F7ULL },
+    { 0xBE2947B3C8000000ULL, 0x16F578C4E0A060B5ULL }, { 0x2DB399A0BA000000ULL, 0x1CB2D6F618C878E3ULL },
+    { 0xFC90400474400000ULL, 0x11EFC659CF7D4B8DULL }, { 0x7BB4500591500000ULL, 0x166BB7F0435C9E71ULL },
+    { 0xDAA16406F5A40000ULL, 0x1C06A5EC5433C60DULL }, { 0xA8A4DE8459868000ULL, 0x118427B3B4A05BC8ULL },
+    { 0xD2CE16256FE82000ULL, 0x15E531A0A1C872BAULL }, { 0x87819BAECBE22800ULL, 0x1B5E7E08CA3A8F69ULL },
+    { 0xF4B1014D3F6D5900ULL, 0x111B0EC57E6499A1ULL }, { 0x71DD41A08F48AF40ULL, 0x1561D276DDFDC00AULL },
+    { 0x0E549208B31ADB10ULL, 0x1ABA4714957D300DULL }, { 0x28F4DB456FF0C8EAULL, 0x10B46C6CDD6E3E08ULL },
+    { 0x33321216CBECFB24ULL, 0x14E1878814C9CD8AULL }, { 0xBFFE969C7EE839EDULL, 0x1A19E96A19FC40ECULL },
+    { 0xF7FF1E21CF512434ULL, 0x105031E2503DA893ULL }, { 0xF5FEE5AA43256D41ULL, 0x14643E5AE44D12B8ULL },
+    { 0x337E9F14D3EEC892ULL, 0x197D4DF19D605767ULL }, { 0x005E46DA08EA7AB6ULL, 0x1FDCA16E04B86D41ULL },
+    { 0xA03AEC4845928CB2ULL, 0x13E9E4E4C2F34448ULL }, { 0xC849A75A56F72FDEULL, 0x18E45E1DF3B0155AULL },
+    { 0x7A5C1130ECB4FBD6ULL, 0x1F1D75A5709C1AB1ULL }, { 0xEC798ABE93F11D65ULL, 0x13726987666190AEULL },
+    { 0xA797ED6E38ED64BFULL, 0x184F03E93FF9F4DAULL }, { 0x517DE8C9C728BDEFULL, 0x1E62C4E38FF87211ULL },
+    { 0xD2EEB17E1C7976B5ULL, 0x12FDBB0E39FB474AULL }, { 0x87AA5DDDA397D462ULL, 0x17BD29D1C87A191DULL },
+    { 0xE994F5550C7DC97BULL, 0x1DAC74463A989F64ULL }, { 0x11FD195527CE9DEDULL, 0x128BC8ABE49F639FULL },
+    { 0xD67C5FAA71C24568ULL, 0x172EBAD6DDC73C86ULL }, { 0x8C1B77950E32D6C2ULL, 0x1CFA698C95390BA8ULL },
+    { 0x57912ABD28DFC639ULL, 0x121C81F7DD43A749ULL }, { 0xAD75756C7317B7C8ULL, 0x16A3A275D494911BULL },
+    { 0x98D2D2C78FDDA5BAULL, 0x1C4C8B1349B9B562ULL }, { 0x9F83C3BCB9EA8794ULL, 0x11AFD6EC0E14115DULL },
+    { 0x0764B4ABE8652979ULL, 0x161BCCA7119915B5ULL }, { 0x493DE1D6E27E73D7ULL, 0x1BA2BFD0D5FF5B22ULL },
+    { 0x6DC6AD264D8F0866ULL, 0x1145B7E285BF98F5ULL }, { 0xC938586FE0F2CA80ULL, 0x159725DB272F7F32ULL },
+    { 0x7B866E8BD92F7D20ULL, 0x1AFCEF51F0FB5EFFULL }, { 0xAD34051767BDAE34ULL, 0x10DE1593369D1B5FULL },
+    { 0x9881065D41AD19C1ULL, 0x15159AF804446237ULL }, { 0x7EA147F492186032ULL, 0x1A5B01B605557AC5ULL },
+    { 0x6F24CCF8DB4F3C1FULL, 0x1078E111C3556CBBULL }, { 0x4AEE003712230B27ULL, 0x14971956342AC7EAULL },
+    { 0xDDA98044D6ABCDF0ULL, 0x19BCDFABC13579E4ULL }, { 0x0A89F02B062B60B6ULL, 0x10160BCB58C16C2FULL },
+    { 0xCD2C6C35C7B638E4ULL, 0x141B8EBE2EF1C73AULL }, { 0x8077874339A3C71DULL, 0x1922726DBAAE3909ULL },
+    { 0xE0956914080CB8E4ULL, 0x1F6B0F092959C74BULL }, { 0x6C5D61AC8507F38EULL, 0x13A2E965B9D81C8FULL },
+    { 0x4774BA17A649F072ULL, 0x188BA3BF284E23B3ULL }, { 0x1951E89D8FDC6C8FULL, 0x1EAE8CAEF261ACA0ULL },
+    { 0x0FD3316279E9C3D9ULL, 0x132D17ED577D0BE4ULL }, { 0x13C7FDBB186434CFULL, 0x17F85DE8AD5C4EDDULL },
+    { 0x58B9FD29DE7D4203ULL, 0x1DF67562D8B36294ULL }, { 0xB7743E3A2B0E4942ULL, 0x12BA095DC7701D9CULL },
+    { 0xE5514DC8B5D1DB92ULL, 0x17688BB5394C2503ULL }, { 0xDEA5A13AE3465277ULL, 0x1D42AEA2879F2E44ULL },
+    { 0x0B2784C4CE0BF38AULL, 0x1249AD2594C37CEBULL }, { 0xCDF165F6018EF06DULL, 0x16DC186EF9F45C25ULL },
+    { 0x416DBF7381F2AC88ULL, 0x1C931E8AB871732FULL }, { 0x88E497A83137ABD5ULL, 0x11DBF316B346E7FDULL },
+    { 0xEB1DBD923D8596CAULL, 0x1652EFDC6018A1FCULL }, { 0x25E52CF6CCE6FC7DULL, 0x1BE7ABD3781ECA7CULL },
+    { 0x97AF3C1A40105DCEULL, 0x1170CB642B133E8DULL }, { 0xFD9B0B20D0147542ULL, 0x15CCFE3D35D80E30ULL },
+    { 0x3D01CDE904199292ULL, 0x1B403DCC834E11BDULL }, { 0x462120B1A28FFB9BULL, 0x1108269FD210CB16ULL },
+    { 0xD7A968DE0B33FA82ULL, 0x154A3047C694FDDBULL }, { 0xCD93C3158E00F923ULL, 0x1A9CBC59B83A3D52ULL },
+    { 0xC07C59ED78C09BB6ULL, 0x10A1F5B813246653ULL }, { 0xB09B7068D6F0C2A3ULL, 0x14CA732617ED7FE8ULL },
+    { 0xDCC24C830CACF34CULL, 0x19FD0FEF9DE8DFE2ULL }, { 0xC9F96FD1E7EC180FULL, 0x103E29F5C2B18BEDULL },
+    { 0x3C77CBC661E71E13ULL, 0x144DB473335DEEE9ULL }, { 0x8B95BEB7FA60E598ULL, 0x1961219000356AA3ULL },
+    { 0x6E7B2E65F8F91EFEULL, 0x1FB969F40042C54CULL }, { 0xC50CFCFFBB9BB35FULL, 0x13D3E2388029BB4FULL },
+    { 0xB6503C3FAA82A037ULL, 0x18C8DAC6A0342A23ULL }, { 0xA3E44B4F95234844ULL, 0x1EFB1178484134ACULL },
+    { 0xE66EAF11BD360D2BULL, 0x135CEAEB2D28C0EBULL }, { 0xE00A5AD62C839075ULL, 0x183425A5F872F126ULL },
+    { 0x980CF18BB7A47493ULL, 0x1E412F0F768FAD70ULL }, { 0x5F0816F752C6C8DCULL, 0x12E8BD69AA19CC66ULL },
+    { 0xF6CA1CB527787B13ULL, 0x17A2ECC414A03F7FULL }, { 0xF47CA3E2715699D7ULL, 0x1D8BA7F519C84F5FULL },
+    { 0xF8CDE66D86D62026ULL, 0x127748F9301D319BULL }, { 0xF7016008E88BA830ULL, 0x17151B377C247E02ULL },
+    { 0xB4C1B80B22AE923CULL, 0x1CDA62055B2D9D83ULL }, { 0x50F91306F5AD1B65ULL, 0x12087D4358FC8272ULL },
+    { 0xE53757C8B318623FULL, 0x168A9C942F3BA30EULL }, { 0x9E852DBADFDE7ACFULL, 0x1C2D43B93B0A8BD2ULL },
+    { 0xA3133C94CBEB0CC1ULL, 0x119C4A53C4E69763ULL }, { 0x8BD80BB9FEE5CFF1ULL, 0x16035CE8B6203D3CULL },
+    { 0xAECE0EA87E9F43EEULL, 0x1B843422E3A84C8BULL }, { 0x4D40C9294F238A75ULL, 0x1132A095CE492FD7ULL },
+    { 0x2090FB73A2EC6D12ULL, 0x157F48BB41DB7BCDULL }, { 0x68B53A508BA78856ULL, 0x1ADF1AEA12525AC0ULL },
+    { 0x417144725748B536ULL, 0x10CB70D24B7378B8ULL }, { 0x51CD958EED1AE283ULL, 0x14FE4D06DE5056E6ULL },
+    { 0xE640FAF2A8619B24ULL, 0x1A3DE04895E46C9FULL }, { 0xEFE89CD7A93D00F7ULL, 0x1066AC2D5DAEC3E3ULL },
+    { 0xEBE2C40D938C4134ULL, 0x14805738B51A74DCULL }, { 0x26DB7510F86F5181ULL, 0x19A06D06E2611214ULL },
+    { 0x9849292A9B4592F1ULL, 0x100444244D7CAB4CULL }, { 0xBE5B73754216F7ADULL, 0x1405552D60DBD61FULL },
+    { 0xADF25052929CB598ULL, 0x1906AA78B912CBA7ULL }, { 0x996EE4673743E2FFULL, 0x1F485516E7577E91ULL },
+    { 0xFFE54EC0828A6DDFULL, 0x138D352E5096AF1AULL }, { 0xBFDEA270A32D0957ULL, 0x18708279E4BC5AE1ULL },
+    { 0x2FD64B0CCBF84BADULL, 0x1E8CA3185DEB719AULL }, { 0x5DE5EEE7FF7B2F4CULL, 0x1317E5EF3AB32700ULL },
+    { 0x755F6AA1FF59FB1FULL, 0x17DDDF6B095FF0C0ULL }, { 0x92B7454A7F3079E7ULL, 0x1DD55745CBB7ECF0ULL },
+    { 0x5BB28B4E8F7E4C30ULL, 0x12A5568B9F52F416ULL }, { 0xF29F2E22335DDF3CULL, 0x174EAC2E8727B11BULL },
+    { 0xEF46F9AAC035570BULL, 0x1D22573A28F19D62ULL }, { 0xD58C5C0AB8215667ULL, 0x123576845997025DULL },
+    { 0x4AEF730D6629AC01ULL, 0x16C2D4256FFCC2F5ULL }, { 0x9DAB4FD0BFB41701ULL, 0x1C73892ECBFBF3B2ULL },
+    { 0xA28B11E277D08E60ULL, 0x11C835BD3F7D784FULL }, { 0x8B2DD65B15C4B1F9ULL, 0x163A432C8F5CD663ULL },
+    { 0x6DF94BF1DB35DE77ULL, 0x1BC8D3F7B3340BFCULL }, { 0xC4BBCF772901AB0AULL, 0x115D847AD000877DULL },
+    { 0x35EAC354F34215CDULL, 0x15B4E5998400A95DULL }, { 0x8365742A30129B40ULL, 0x1B221EFFE500D3B4ULL },
+    { 0xD21F689A5E0BA108ULL, 0x10F5535FEF208450ULL }, { 0x06A742C0F58E894AULL, 0x1532A837EAE8A565ULL },
+    { 0x4851137132F22B9DULL, 0x1A7F5245E5A2CEBEULL }, { 0xED32AC26BFD75B42ULL, 0x108F936BAF85C136ULL },
+    { 0xA87F57306FCD3212ULL, 0x14B378469B673184ULL }, { 0xD29F2CFC8BC07E97ULL, 0x19E056584240FDE5ULL },
+    { 0xA3A37C1DD7584F1EULL, 0x102C35F729689EAFULL }, { 0x8C8C5B254D2E62E6ULL, 0x14374374F3C2C65BULL },
+    { 0x6FAF71EEA079FB9FULL, 0x1945145230B377F2ULL }, { 0x0B9B4E6A48987A87ULL, 0x1F965966BCE055EFULL },
+    { 0x674111026D5F4C94ULL, 0x13BDF7E0360C35B5ULL }, { 0xC111554308B71FBAULL, 0x18AD75D8438F4322ULL },
+    { 0x7155AA93CAE4E7A8ULL, 0x1ED8D34E547313EBULL }, { 0x26D58A9C5ECF10C9ULL, 0x13478410F4C7EC73ULL },
+    { 0xF08AED437682D4FBULL, 0x1819651531F9E78FULL }, { 0xECADA89454238A3AULL, 0x1E1FBE5A7E786173ULL },
+    { 0x73EC895CB4963664ULL, 0x12D3D6F88F0B3CE8ULL }, { 0x90E7ABB3E1BBC3FDULL, 0x1788CCB6B2CE0C22ULL },
+    { 0x352196A0DA2AB4FDULL, 0x1D6AFFE45F818F2BULL }, { 0x0134FE24885AB11EULL, 0x1262DFEEBBB0F97BULL },
+    { 0xC1823DADAA715D65ULL, 0x16FB97EA6A9D37D9ULL }, { 0x31E2CD19150DB4BFULL, 0x1CBA7DE5054485D0ULL },
+    { 0x1F2DC02FAD2890F7ULL, 0x11F48EAF234AD3A2ULL }, { 0xA6F9303B9872B535ULL, 0x1671B25AEC1D888AULL },
+    { 0x50B77C4A7E8F6282ULL, 0x1C0E1EF1A724EAADULL }, { 0x5272ADAE8F199D91ULL, 0x1188D357087712ACULL },
+    { 0x670F591A32E004F6ULL, 0x15EB082CCA94D757ULL }, { 0x40D32F60BF980633ULL, 0x1B65CA37FD3A0D2DULL },
+    { 0x4883FD9C77BF03E0ULL, 0x111F9E62FE44483CULL }, { 0x5AA4FD0395AEC4D8ULL, 0x156785FBBDD55A4BULL },
+    { 0x314E3C447B1A760EULL, 0x1AC1677AAD4AB0DEULL }, { 0xDED0E5AACCF089C9ULL, 0x10B8E0ACAC4EAE8AULL },
+    { 0x96851F15802CAC3BULL, 0x14E718D7D7625A2DULL }, { 0xFC2666DAE037D74AULL, 0x1A20DF0DCD3AF0B8ULL },
+    { 0x9D980048CC22E68EULL, 0x10548B68A044D673ULL }, { 0x84FE005AFF2BA032ULL, 0x1469AE42C8560C10ULL },
+    { 0xA63D8071BEF6883EULL, 0x198419D37A6B8F14ULL }, { 0xCFCCE08E2EB42A4EULL, 0x1FE52048590672D9ULL },
+    { 0x21E00C58DD309A70ULL, 0x13EF342D37A407C8ULL }, { 0x2A580F6F147CC10DULL, 0x18EB0138858D09BAULL },
+    { 0xB4EE134AD99BF150ULL, 0x1F25C186A6F04C28ULL }, { 0x7114CC0EC80176D2ULL, 0x137798F428562F99ULL },
+    { 0xCD59FF127A01D486ULL, 0x18557F31326BBB7FULL }, { 0xC0B07ED7188249A8ULL, 0x1E6ADEFD7F06AA5FULL },
+    { 0xD86E4F466F516E09ULL, 0x1302CB5E6F642A7BULL }, { 0xCE89E3180B25C98BULL, 0x17C37E360B3D351AULL },
+    { 0x822C5BDE0DEF3BEEULL, 0x1DB45DC38E0C8261ULL }, { 0xF15BB96AC8B58575ULL, 0x1290BA9A38C7D17CULL },
+    { 0x2DB2A7C57AE2E6D2ULL, 0x1734E940C6F9C5DCULL }, { 0x391F51B6D99BA086ULL, 0x1D022390F8B83753ULL },
+    { 0x03B3931248014454ULL, 0x1221563A9B732294ULL }, { 0x04A077D6DA019569ULL, 0x16A9ABC9424FEB39ULL },
+    { 0x45C895CC9081FAC3ULL, 0x1C5416BB92E3E607ULL }, { 0x8B9D5D9FDA513CBAULL, 0x11B48E353BCE6FC4ULL },
+    { 0xAE84B507D0E58BE8ULL, 0x1621B1C28AC20BB5ULL }, { 0x1A25E249C51EEEE3ULL, 0x1BAA1E332D728EA3ULL },
+    { 0xF057AD6E1B33554DULL, 0x114A52DFFC679925ULL }, { 0x6C6D98C9A2002AA1ULL, 0x159CE797FB817F6FULL },
+    { 0x4788FEFC0A803549ULL, 0x1B04217DFA61DF4BULL }, { 0x0CB59F5D8690214EULL, 0x10E294EEBC7D2B8FULL },
+    { 0xCFE30734E83429A1ULL, 0x151B3A2A6B9C7672ULL }, { 0x83DBC9022241340AULL, 0x1A6208B50683940FULL },
+    { 0xB2695DA15568C086ULL, 0x107D457124123C89ULL }, { 0x1F03B509AAC2F0A7ULL, 0x149C96CD6D16CBACULL },
+    { 0x26C4A24C1573ACD1ULL, 0x19C3BC80C85C7E97ULL }, { 0x783AE56F8D684C03ULL, 0x101A55D07D39CF1EULL },
+    { 0x16499ECB70C25F03ULL, 0x1420EB449C8842E6ULL }, { 0x9BDC067E4CF2F6C4ULL, 0x19292615C3AA539FULL },
+    { 0x82D3081DE02FB476ULL, 0x1F736F9B3494E887ULL }, { 0xB1C3E512AC1DD0C9ULL, 0x13A825C100DD1154ULL },
+    { 0xDE34DE57572544FCULL, 0x18922F31411455A9ULL }, { 0x55C215ED2CEE963BULL, 0x1EB6BAFD91596B14ULL },
+    { 0xB5994DB43C151DE5ULL, 0x133234DE7AD7E2ECULL }, { 0xE2FFA1214B1A655EULL, 0x17FEC216198DDBA7ULL },
+    { 0xDBBF89699DE0FEB6ULL, 0x1DFE729B9FF15291ULL }, { 0x2957B5E202AC9F31ULL, 0x12BF07A143F6D39BULL },
+    { 0xF3ADA35A8357C6FEULL, 0x176EC98994F48881ULL }, { 0x70990C31242DB8BDULL, 0x1D4A7BEBFA31AAA2ULL },
+    { 0x865FA79EB69C9376ULL, 0x124E8D737C5F0AA5ULL }, { 0xE7F791866443B854ULL, 0x16E230D05B76CD4EULL },
+    { 0xA1F575E7FD54A669ULL, 0x1C9ABD04725480A2ULL }, { 0xA53969B0FE54E801ULL, 0x11E0B622C774D065ULL },
+    { 0x0E87C41D3DEA2202ULL, 0x1658E3AB7952047FULL }, { 0xD229B5248D64AA82ULL, 0x1BEF1C9657A6859EULL },
+    { 0x435A1136D85EEA91ULL, 0x117571DDF6C81383ULL }, { 0x143095848E76A536ULL, 0x15D2CE55747A1864ULL },
+    { 0x193CBAE5B2144E83ULL, 0x1B4781EAD1989E7DULL }, { 0x2FC5F4CF8F4CB112ULL, 0x110CB132C2FF630EULL },
+    { 0xBBB77203731FDD56ULL, 0x154FDD7F73BF3BD1ULL }, { 0x2AA54E844FE7D4ACULL, 0x1AA3D4DF50AF0AC6ULL },
+    { 0xDAA75112B1F0E4EBULL, 0x10A6650B926D66BBULL }, { 0xD15125575E6D1E26ULL, 0x14CFFE4E7708C06AULL },
+    { 0x85A56EAD360865B0ULL, 0x1A03FDE214CAF085ULL }, { 0x7387652C41C53F8EULL, 0x10427EAD4CFED653ULL },
+    { 0x50693E7752368F71ULL, 0x14531E58A03E8BE8ULL }, { 0x64838E1526C4334EULL, 0x1967E5EEC84E2EE2ULL },
+    { 0xFDA4719A70754022ULL, 0x1FC1DF6A7A61BA9AULL }, { 0xDE86C70086494815ULL, 0x13D92BA28C7D14A0ULL },
+    { 0x162878C0A7DB9A1AULL, 0x18CF768B2F9C59C9ULL }, { 0x5BB296F0D1D280A1ULL, 0x1F03542DFB83703BULL },
+    { 0x194F9E5683239064ULL, 0x1362149CBD322625ULL }, { 0x5FA385EC23EC747EULL, 0x183A99C3EC7EAFAEULL },
+    { 0xF78C67672CE7919DULL, 0x1E494034E79E5B99ULL }, { 0x3AB7C0A07C10BB02ULL, 0x12EDC82110C2F940ULL },
+    { 0x4965B0C89B14E9C3ULL, 0x17A93A2954F3B790ULL }, { 0x5BBF1CFAC1DA2433ULL, 0x1D9388B3AA30A574ULL },
+    { 0xB957721CB92856A0ULL, 0x127C35704A5E6768ULL }, { 0xE7AD4EA3E7726C48ULL, 0x171B42CC5CF60142ULL },
+    { 0xA198A24CE14F075AULL, 0x1CE2137F74338193ULL }, { 0x44FF65700CD16498ULL, 0x120D4C2FA8A030FCULL },
+    { 0x563F3ECC1005BDBEULL, 0x16909F3B92C83D3BULL }, { 0x2BCF0E7F14072D2EULL, 0x1C34C70A777A4C8AULL },
+    { 0x5B61690F6C847C3DULL, 0x11A0FC668AAC6FD6ULL }, { 0xF239C35347A59B4CULL, 0x16093B802D578BCBULL },
+    { 0xEEC83428198F021FULL, 0x1B8B8A6038AD6EBEULL }, { 0x553D20990FF96153ULL, 0x1137367C236C6537ULL },
+    { 0x2A8C68BF53F7B9A8ULL, 0x1585041B2C477E85ULL }, { 0x752F82EF28F5A812ULL, 0x1AE64521F7595E26ULL },
+    { 0x093DB1D57999890BULL, 0x10CFEB353A97DAD8ULL }, { 0x0B8D1E4AD7FFEB4EULL, 0x1503E602893DD18EULL },
+    { 0x8E7065DD8DFFE622ULL, 0x1A44DF832B8D45F1ULL }, { 0xF9063FAA78BFEFD5ULL, 0x106B0BB1FB384BB6ULL },
+    { 0xB747CF9516EFEBCAULL, 0x1485CE9E7A065EA4ULL }, { 0xE519C37A5CABE6BDULL, 0x19A742461887F64DULL },
+    { 0xAF301A2C79EB7036ULL, 0x1008896BCF54F9F0ULL }, { 0xDAFC20B798664C43ULL, 0x140AABC6C32A386CULL },
+    { 0x11BB28E57E7FDF54ULL, 0x190D56B873F4C688ULL }, { 0x1629F31EDE1FD72AULL, 0x1F50AC6690F1F82AULL },
+    { 0x4DDA37F34AD3E67AULL, 0x13926BC01A973B1AULL }, { 0xE150C5F01D88E019ULL, 0x187706B0213D09E0ULL },
+    { 0x19A4F76C24EB181FULL, 0x1E94C85C298C4C59ULL }, { 0xB0071AA39712EF13ULL, 0x131CFD3999F7AFB7ULL },
+    { 0x9C08E14C7CD7AAD8ULL, 0x17E43C8800759BA5ULL }, { 0x030B199F9C0D958EULL, 0x1DDD4BAA0093028FULL },
+    { 0x61E6F003C1887D79ULL, 0x12AA4F4A405BE199ULL }, { 0xBA60AC04B1EA9CD7ULL, 0x1754E31CD072D9FFULL },
+    { 0xA8F8D705DE65440DULL, 0x1D2A1BE4048F907FULL }, { 0xC99B8663AAFF4A88ULL, 0x123A516E82D9BA4FULL },
+    { 0xBC0267FC95BF1D2AULL, 0x16C8E5CA239028E3ULL }, { 0xAB0301FBBB2EE474ULL, 0x1C7B1F3CAC74331CULL },
+    { 0xEAE1E13D54FD4EC9ULL, 0x11CCF385EBC89FF1ULL }, { 0x659A598CAA3CA27BULL, 0x1640306766BAC7EEULL },
+    { 0xFF00EFEFD4CBCB1AULL, 0x1BD03C81406979E9ULL }, { 0x3F6095F5E4FF5EF0ULL, 0x116225D0C841EC32ULL },
+    { 0xCF38BB735E3F36ACULL, 0x15BAAF44FA52673EULL }, { 0x8306EA5035CF0457ULL, 0x1B295B1638E7010EULL },
+    { 0x11E4527221A162B6ULL, 0x10F9D8EDE39060A9ULL }, { 0x565D670EAA09BB64ULL, 0x15384F295C7478D3ULL },
+    { 0x2BF4C0D2548C2A3DULL, 0x1A8662F3B3919708ULL }, { 0x1B78F88374D79A66ULL, 0x1093FDD8503AFE65ULL },
+    { 0x625736A4520D8100ULL, 0x14B8FD4E6449BDFEULL }, { 0xFAED044D6690E140ULL, 0x19E73CA1FD5C2D7DULL },
+    { 0xBCD422B0601A8CC8ULL, 0x103085E53E599C6EULL }, { 0x6C092B5C78212FFAULL, 0x143CA75E8DF0038AULL },
+    { 0x070B763396297BF8ULL, 0x194BD136316C046DULL }, { 0x48CE53C07BB3DAF6ULL, 0x1F9EC583BDC70588ULL },
+    { 0x2D80F4584D5068DAULL, 0x13C33B72569C6375ULL }, { 0x78E1316E60A48310ULL, 0x18B40A4EEC437C52ULL }
+};
+
+/* ceil(log2(5^e)) for e in [1, 3528], 1 for e == 0 */
+static int ryu_pow5_bits(int e)
+{
+    return ((e * 1217359) >> 19) + 1;
+}
 
-    if (output_buffer == NULL)
-    {
-        return false;
-    }
+/* floor(log10(2^e)) for e in [0, 1650] */
+static int ryu_log10_pow2(int e)
+{
+    return (e * 78913) >> 18;
+}
 
-    /* This checks for NaN and Infinity */
-    if (isnan(d) || isinf(d))
+/* floor(log10(5^e)) for e in [0, 2620] */
+static int ryu_log10_pow5(int e)
+{
+    return (e * 732923) >> 20;
+}
+
+static cJSON_bool ryu_multiple_of_pow5(uint64_t value, int power)
+{
+    int count = 0;
+    while ((value % 5) == 0)
     {
-        length = sprintf((char*)number_buffer, "null");
+        value /= 5;
+        count++;
     }
-	else if(d == (double)item->valueint)
-	{
-		length = sprintf((char*)number_buffer, "%d", item->valueint);
-	}
-    else
-    {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
+    return count >= power;
+}
 
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
-        {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
-        }
-    }
+static cJSON_bool ryu_multiple_of_pow2(uint64_t value, int power)
+{
+    return (value & (((uint64_t)1 << power) - 1)) == 0;
+}
 
-    /* sprintf failed or buffer overrun occurred */
-    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+/* (m * multiplier) >> shift, where multiplier is 128 bits and shift is in [64, 127] */
+static uint64_t ryu_mul_shift(uint64_t m, const uint64_t *multiplier, int shift)
+{
+    uint64_t high0 = 0;
+    uint64_t low0 = 0;
+    uint64_t high1 = 0;
+    uint64_t low1 = 0;
+    uint64_t sum = 0;
+
+    multiply_64(m, multiplier[0], &high0, &low0);
+    multiply_64(m, multiplier[1], &high1, &low1);
+    sum = high0 + low1;
+    if (sum < high0)
     {
-        return false;
+        high1++;
     }
+    shift -= 64;
+    return (shift == 0) ? sum : ((high1 << (64 - shift)) | (sum >> shift));
+}
 
-    /* reserve appropriate space in the output */
-    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
-    if (output_pointer == NULL)
+/* Shortest digits and decimal exponent of a finite, nonzero, positive double given by its
+ * IEEE mantissa and exponent bits: the value printed is *digits * 10^*exponent */
+static void ryu_shortest(uint64_t ieee_mantissa, int ieee_exponent, uint64_t *digits, int *exponent)
+{
+    int e2 = 0;
+    uint64_t m2 = 0;
+    cJSON_bool accept_bounds = false;
+    int mm_shift = 0;
+    uint64_t mv = 0;
+    uint64_t vr = 0;
+    uint64_t vp = 0;
+    uint64_t vm = 0;
+    int e10 = 0;
+    cJSON_bool vm_is_trailing_zeros = false;
+    cJSON_bool vr_is_trailing_zeros = false;
+    int removed = 0;
+    int last_removed_digit = 0;
+    uint64_t output = 0;
+
+    if (ieee_exponent == 0)
+    {
+        e2 = 1 - 1023 - 52 - 2;
+        m2 = ieee_mantissa;
+    }
+    else
     {
-        return false;
+        e2 = ieee_exponent - 1023 - 52 - 2;
+        m2 = ((uint64_t)1 << 52) | ieee_mantissa;
     }
+    /* with an even mantissa the bounds themselves parse back to the same double */
+    accept_bounds = (m2 & 1) == 0;
+
+    /* the interval is [4 * m2 - 1 - mm_shift, 4 * m2 + 2] * 2^e2, narrower below powers of two */
+    mv = 4 * m2;
+    mm_shift = ((ieee_mantissa != 0) || (ieee_exponent <= 1)) ? 1 : 0;
 
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
+    /* scale the interval by a power of ten so the candidates become integers */
+    if (e2 >= 0)
     {
-        if (number_buffer[i] == decimal_point)
+        int q = ryu_log10_pow2(e2) - ((e2 > 3) ? 1 : 0);
+        int k = RYU_POW5_INV_BITCOUNT + ryu_pow5_bits(q) - 1;
+        int i = -e2 + q + k;
+        e10 = q;
+        vr = ryu_mul_shift(4 * m2, ryu_pow5_inv_split[q], i);
+        vp = ryu_mul_shift(4 * m2 + 2, ryu_pow5_inv_split[q], i);
+        vm = ryu_mul_shift(4 * m2 - 1 - (uint64_t)mm_shift, ryu_pow5_inv_split[q], i);
+        if (q <= 21)
         {
-            output_pointer[i] = '.';
-            continue;
-        }
-
-        output_pointer[i] = number_buffer[i];
-    }
-    output_pointer[i] = '\0';
+            /* only then can the exact values end in zeros that the scaling dropped */
+            if ((mv % 5) == 0)
+            {
+                vr_is_trailing_zeros = ryu_multiple_of_pow5(mv, q);
+            }
+            else if (accept_bounds)
+            {
+                vm_is_trailing_zeros = ryu_multiple_of_pow5(mv - 1 - (uint64_t)mm_shift, q);
+            }
+            else
+            {
+                vp -= ryu_multiple_of_pow5(mv + 2, q) ? 1 : 0;
+            }
+        }
+    }
+    else
+    {
+        int q = ryu_log10_pow5(-e2) - ((-e2 > 1) ? 1 : 0);
+        int i = -e2 - q;
+        int k = ryu_pow5_bits(i) - RYU_POW5_BITCOUNT;
+        int j = q - k;
+        e10 = q + e2;
+        vr = ryu_mul_shift(4 * m2, ryu_pow5_split[i], j);
+        vp = ryu_mul_shift(4 * m2 + 2, ryu_pow5_split[i], j);
+        vm = ryu_mul_shift(4 * m2 - 1 - (uint64_t)mm_shift, ryu_pow5_split[i], j);
+        if (q <= 1)
+        {
+            vr_is_trailing_zeros = true;
+            if (accept_bounds)
+            {
+                vm_is_trailing_zeros = mm_shift == 1;
+            }
+            else
+            {
+                vp--;
+            }
+        }
+        else if (q < 63)
+        {
+            vr_is_trailing_zeros = ryu_multiple_of_pow2(mv, q);
+        }
+    }
 
-    output_buffer->offset += (size_t)length;
+    /* drop digits while the interval still holds a shorter number */
+    if (vm_is_trailing_zeros || vr_is_trailing_zeros)
+    {
+        while ((vp / 10) > (vm / 10))
+        {
+            vm_is_trailing_zeros = vm_is_trailing_zeros && ((vm % 10) == 0);
+            vr_is_trailing_zeros = vr_is_trailing_zeros && (last_removed_digit == 0);
+            last_removed_digit = (int)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_is_trailing_zeros)
+        {
+            while ((vm % 10) == 0)
+            {
+                vr_is_trailing_zeros = vr_is_trailing_zeros && (last_removed_digit == 0);
+                last_removed_digit = (int)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vr_is_trailing_zeros && (last_removed_digit == 5) && ((vr % 2) == 0))
+        {
+            /* exactly halfway, round to even */
+            last_removed_digit = 4;
+        }
+        output = vr + ((((vr == vm) && (!accept_bounds || !vm_is_trailing_zeros)) || (last_removed_digit >= 5)) ? 1 : 0);
+    }
+    else
+    {
+        cJSON_bool round_up = false;
+        if ((vp / 100) > (vm / 100))
+        {
+            round_up = (vr % 100) >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while ((vp / 10) > (vm / 10))
+        {
+            round_up = (vr % 10) >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (((vr == vm) || round_up) ? 1 : 0);
+    }
 
-    return true;
+    *digits = output;
+    *exponent = e10 + removed;
 }
 
-/* parse 4 digit hexadecimal number */
-static unsigned parse_hex4(const unsigned char * const input)
+/* Print a finite, nonzero double the way "%1.15g" does when that round trips and
+ * "%1.17g" would otherwise, but with the shortest digits. Returns the length. */
+static int print_double_shortest(double number, unsigned char *buffer)
 {
-    unsigned int h = 0;
-    size_t i = 0;
+    uint64_t bits = 0;
+    uint64_t digits = 0;
+    uint64_t remaining = 0;
+    int exponent = 0;
+    int digit_count = 0;
+    int decimal_exponent = 0;
+    unsigned char digit_text[20];
+    int length = 0;
+    int i = 0;
 
-    for (i = 0; i < 4; i++)
+    memcpy(&bits, &number, sizeof(bits));
+    if ((bits >> 63) != 0)
+    {
+        buffer[length++] = '-';
+    }
+    ryu_shortest(bits & (((uint64_t)1 << 52) - 1), (int)((bits >> 52) & 0x7FF), &digits, &exponent);
+
+    while ((digits % 10) == 0)
+    {
+        digits /= 10;
+        exponent++;
+    }
+    /* count the digits first, then write them from the last one down to digit_text[0] */
+    remaining = digits;
+    do
+    {
+        digit_count++;
+        remaining /= 10;
+    } while (remaining != 0);
+    i = digit_count;
+    do
+    {
+        digit_text[--i] = (unsigned char)('0' + (digits % 10));
+        digits /= 10;
+    } while (i > 0);
+    decimal_exponent = exponent + digit_count - 1;
+
+    if ((decimal_exponent < -4) || (decimal_exponent >= ((digit_count <= 15) ? 15 : 17)))
     {
-        /* parse digit */
-        if ((input[i] >= '0') && (input[i] <= '9'))
+        /* d.ddde+XX like %g */
+        unsigned int magnitude = (unsigned int)((decimal_exponent < 0) ? -decimal_exponent : decimal_exponent);
+        buffer[length++] = digit_text[0];
+        if (digit_count > 1)
         {
-            h += (unsigned int) input[i] - '0';
+            buffer[length++] = '.';
+            memcpy(buffer + length, digit_text + 1, (size_t)digit_count - 1);
+            length += digit_count - 1;
         }
-        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        buffer[length++] = 'e';
+        buffer[length++] = (unsigned char)((decimal_exponent < 0) ? '-' : '+');
+        if (magnitude >= 100)
         {
-            h += (unsigned int) 10 + input[i] - 'A';
+            buffer[length++] = (unsigned char)('0' + magnitude / 100);
         }
-        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+        buffer[length++] = (unsigned char)('0' + (magnitude / 10) % 10);
+        buffer[length++] = (unsigned char)('0' + magnitude % 10);
+    }
+    else if (decimal_exponent < 0)
+    {
+        buffer[length++] = '0';
+        buffer[length++] = '.';
+        for (i = -1; i > decimal_exponent; i--)
         {
-            h += (unsigned int) 10 + input[i] - 'a';
+            buffer[length++] = '0';
         }
-        else /* invalid */
+        memcpy(buffer + length, digit_text, (size_t)digit_count);
+        length += digit_count;
+    }
+    else
+    {
+        for (i = 0; (i < digit_count) || (i <= decimal_exponent); i++)
         {
-            return 0;
+            if (i == (decimal_exponent + 1))
+            {
+                buffer[length++] = '.';
+            }
+            buffer[length++] = (i < digit_count) ? digit_text[i] : (unsigned char)'0';
+        }
+    }
+
+    return length;
+}
+#endif
+
+/* Print an int in decimal. Returns the length. */
+static int print_int(int number, unsigned char *buffer)
+{
+    unsigned char digits[12];
+    unsigned int magnitude = (number < 0) ? (0U - (unsigned int)number) : (unsigned int)number;
+    int count = 0;
+    int length = 0;
+
+    do
+    {
+        digits[count++] = (unsigned char)('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (number < 0)
+    {
+        buffer[length++] = '-';
+    }
+    while (count > 0)
+    {
+        buffer[length++] = digits[--count];
+    }
+    return length;
+}
+
+/* Render the number nicely from the given item into a string. */
+static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    double d = item->valuedouble;
+    int length = 0;
+    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
+#ifndef CJSON_FAST_NUMBERS
+    size_t i = 0;
+    unsigned char decimal_point = get_decimal_point();
+    double test = 0.0;
+#endif
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* This checks for NaN and Infinity */
+    if (isnan(d) || isinf(d))
+    {
+        memcpy(number_buffer, "null", sizeof("null"));
+        length = sizeof("null") - 1;
+    }
+	else if(d == (double)item->valueint)
+	{
+		length = print_int(item->valueint, number_buffer);
+	}
+    else
+    {
+#ifdef CJSON_FAST_NUMBERS
+        length = print_double_shortest(d, number_buffer);
+#else
+        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
+        length = sprintf((char*)number_buffer, "%1.15g", d);
+
+        /* Check whether the original double can be recovered */
+        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
+        {
+            /* If not, print with 17 decimal places of precision */
+            length = sprintf((char*)number_buffer, "%1.17g", d);
         }
 
-        if (i < 3)
+        /* sprintf failed or buffer overrun occurred */
+        if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
         {
-            /* shift left to make place for the next nibble */
-            h = h << 4;
+            return false;
+        }
+
+        /* replace the locale dependent decimal point with '.' */
+        for (i = 0; i < ((size_t)length); i++)
+        {
+            if (number_buffer[i] == decimal_point)
+            {
+                number_buffer[i] = '.';
+            }
         }
+#endif
+    }
+
+    /* reserve appropriate space in the output */
+    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    memcpy(output_pointer, number_buffer, (size_t)length);
+    output_pointer[length] = '\0';
+
+    output_buffer->offset += (size_t)length;
+
+    return true;
+}
+
+/* value of every byte as a hexadecimal digit, 0x10 if it is none */
+static const unsigned char hex_digit_values[256] =
+{
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+};
+
+/* parse 4 digit hexadecimal number, false (and a code of 0) if a digit is invalid */
+static cJSON_bool parse_hex4(const unsigned char * const input, unsigned int * const code)
+{
+    unsigned int digit0 = hex_digit_values[input[0]];
+    unsigned int digit1 = hex_digit_values[input[1]];
+    unsigned int digit2 = hex_digit_values[input[2]];
+    unsigned int digit3 = hex_digit_values[input[3]];
+
+    if (((digit0 | digit1 | digit2 | digit3) & 0x10) != 0)
+    {
+        *code = 0;
+        return false;
     }
 
-    return h;
+    *code = (digit0 << 12) | (digit1 << 8) | (digit2 << 4) | digit3;
+    return true;
 }
 
 /* converts a UTF-16 literal to UTF-8
- * A literal can be one or two sequences of the form \uXXXX */
-static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+ * A literal can be one or two sequences of the form \uXXXX
+ * Invalid hex digits are read as 0 unless strict is set, then they are an error. */
+static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer, cJSON_bool strict)
 {
-    long unsigned int codepoint = 0;
+    unsigned long codepoint = 0;
     unsigned int first_code = 0;
     const unsigned char *first_sequence = input_pointer;
+    unsigned char *output = *output_pointer;
     unsigned char utf8_length = 0;
-    unsigned char utf8_position = 0;
     unsigned char sequence_length = 0;
-    unsigned char first_byte_mark = 0;
 
     if ((input_end - first_sequence) < 6)
     {
@@ -671,7 +1955,10 @@ static unsigned char utf16_literal_to_utf8(const unsigned char * const input_poi
     }
 
     /* get the first utf16 sequence */
-    first_code = parse_hex4(first_sequence + 2);
+    if (!parse_hex4(first_sequence + 2, &first_code) && strict)
+    {
+        goto fail;
+    }
 
     /* check that the code is valid */
     if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
@@ -699,7 +1986,10 @@ static unsigned char utf16_literal_to_utf8(const unsigned char * const input_poi
         }
 
         /* get the second utf16 sequence */
-        second_code = parse_hex4(second_sequence + 2);
+        if (!parse_hex4(second_sequence + 2, &second_code) && strict)
+        {
+            goto fail;
+        }
         /* check that the code is valid */
         if ((second_code < 0xDC00) || (second_code > 0xDFFF))
         {
@@ -707,7 +1997,6 @@ static unsigned char utf16_literal_to_utf8(const unsigned char * const input_poi
             goto fail;
         }
 
-
         /* calculate the unicode codepoint from the surrogate pair */
         codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
     }
@@ -717,53 +2006,36 @@ static unsigned char utf16_literal_to_utf8(const unsigned char * const input_poi
         codepoint = first_code;
     }
 
-    /* encode as UTF-8
-     * takes at maximum 4 bytes to encode:
-     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
+    /* encode as UTF-8, the codepoint is at most 0x10FFFF */
     if (codepoint < 0x80)
     {
         /* normal ascii, encoding 0xxxxxxx */
+        output[0] = (unsigned char)codepoint;
         utf8_length = 1;
     }
     else if (codepoint < 0x800)
     {
         /* two bytes, encoding 110xxxxx 10xxxxxx */
+        output[0] = (unsigned char)(0xC0 | (codepoint >> 6));
+        output[1] = (unsigned char)(0x80 | (codepoint & 0x3F));
         utf8_length = 2;
-        first_byte_mark = 0xC0; /* 11000000 */
     }
     else if (codepoint < 0x10000)
     {
         /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
+        output[0] = (unsigned char)(0xE0 | (codepoint >> 12));
+        output[1] = (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F));
+        output[2] = (unsigned char)(0x80 | (codepoint & 0x3F));
         utf8_length = 3;
-        first_byte_mark = 0xE0; /* 11100000 */
-    }
-    else if (codepoint <= 0x10FFFF)
-    {
-        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 4;
-        first_byte_mark = 0xF0; /* 11110000 */
-    }
-    else
-    {
-        /* invalid unicode codepoint */
-        goto fail;
-    }
-
-    /* encode as utf8 */
-    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
-    {
-        /* 10xxxxxx */
-        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
-        codepoint >>= 6;
-    }
-    /* encode first byte */
-    if (utf8_length > 1)
-    {
-        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
     }
     else
     {
-        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+        /* four bytes, encoding 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
+        output[0] = (unsigned char)(0xF0 | (codepoint >> 18));
+        output[1] = (unsigned char)(0x80 | ((codepoint >> 12) & 0x3F));
+        output[2] = (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F));
+        output[3] = (unsigned char)(0x80 | (codepoint & 0x3F));
+        utf8_length = 4;
     }
 
     *output_pointer += utf8_length;
@@ -774,1072 +2046,2691 @@ fail:
     return 0;
 }
 
-/* Parse the input text into an unescaped cinput, and populate item. */
-static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+/* Vectorised scanning of string literals.
+ * The scan_string kernels return the first '\"' or '\\' in [start, end), the scan_escape
+ * kernels the first byte that has to be escaped when printing ('\"', '\\' or a control
+ * character below 0x20) and the scan_whitespace kernels the first byte above ' ', or end
+ * if there is none.
+ * They never read outside of [start, end): whole 16/32 byte blocks are compared while
+ * they fit and the rest is done by the scalar loop. The best kernel the CPU supports is
+ * picked on first use, cJSON_SetSimdLevel can override that. */
+#if !defined(CJSON_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CJSON_X86_SIMD
+#include <immintrin.h>
+#include <stdint.h>
+#endif
+
+typedef const unsigned char *(*string_scanner)(const unsigned char *start, const unsigned char *end);
+
+static const unsigned char *scan_string_scalar(const unsigned char *start, const unsigned char *end)
 {
-    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
-    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
-    unsigned char *output_pointer = NULL;
-    unsigned char *output = NULL;
+    while ((start < end) && (*start != '\"') && (*start != '\\'))
+    {
+        start++;
+    }
 
-    /* not a string */
-    if (buffer_at_offset(input_buffer)[0] != '\"')
+    return start;
+}
+
+static const unsigned char *scan_escape_scalar(const unsigned char *start, const unsigned char *end)
+{
+    while ((start < end) && (*start >= 0x20) && (*start != '\"') && (*start != '\\'))
     {
-        goto fail;
+        start++;
     }
 
+    return start;
+}
+
+static const unsigned char *scan_whitespace_scalar(const unsigned char *start, const unsigned char *end)
+{
+    while ((start < end) && (*start <= 32))
     {
-        /* calculate approximate size of the output (overestimate) */
-        size_t allocation_length = 0;
-        size_t skipped_bytes = 0;
-        while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
+        start++;
+    }
+
+    return start;
+}
+
+/* UTF-8 validation: the validate_utf8 kernels check that [start, end) is well-formed
+ * UTF-8 as in RFC 3629, so no overlong forms, surrogates or codepoints above 0x10FFFF. */
+typedef cJSON_bool (*utf8_validator)(const unsigned char *start, const unsigned char *end);
+
+/* the end of the multi-byte sequence at start, NULL if it is invalid */
+static const unsigned char *utf8_sequence_end(const unsigned char *start, const unsigned char *end)
+{
+    unsigned char lead = start[0];
+    unsigned char second_min = 0x80;
+    unsigned char second_max = 0xBF;
+    size_t length = 0;
+    size_t i = 0;
+
+    if ((lead >= 0xC2) && (lead <= 0xDF))
+    {
+        length = 2;
+    }
+    else if ((lead >= 0xE0) && (lead <= 0xEF))
+    {
+        length = 3;
+        if (lead == 0xE0)
         {
-            /* is escape sequence */
-            if (input_end[0] == '\\')
-            {
-                if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
-                {
-                    /* prevent buffer overflow when last input character is a backslash */
-                    goto fail;
-                }
-                skipped_bytes++;
-                input_end++;
-            }
-            input_end++;
+            second_min = 0xA0; /* overlong */
         }
-        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
+        else if (lead == 0xED)
         {
-            goto fail; /* string ended unexpectedly */
+            second_max = 0x9F; /* surrogates */
+        }
+    }
+    else if ((lead >= 0xF0) && (lead <= 0xF4))
+    {
+        length = 4;
+        if (lead == 0xF0)
+        {
+            second_min = 0x90; /* overlong */
+        }
+        else if (lead == 0xF4)
+        {
+            second_max = 0x8F; /* above 0x10FFFF */
         }
+    }
+    else
+    {
+        return NULL;
+    }
 
-        /* This is at most how much we need for the output */
-        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
-        if (output == NULL)
+    if (((size_t)(end - start) < length) || (start[1] < second_min) || (start[1] > second_max))
+    {
+        return NULL;
+    }
+    for (i = 2; i < length; i++)
+    {
+        if ((start[i] & 0xC0) != 0x80)
         {
-            goto fail; /* allocation failure */
+            return NULL;
         }
     }
 
-    output_pointer = output;
-    /* loop through the string literal */
-    while (input_pointer < input_end)
+    return start + length;
+}
+
+static cJSON_bool validate_utf8_scalar(const unsigned char *start, const unsigned char *end)
+{
+    while (start < end)
     {
-        if (*input_pointer != '\\')
+        if (*start < 0x80)
         {
-            *output_pointer++ = *input_pointer++;
+            start++;
         }
-        /* escape sequence */
         else
         {
-            unsigned char sequence_length = 2;
-            if ((input_end - input_pointer) < 1)
+            start = utf8_sequence_end(start, end);
+            if (start == NULL)
             {
-                goto fail;
+                return false;
             }
-
-            switch (input_pointer[1])
-            {
-                case 'b':
-                    *output_pointer++ = '\b';
-                    break;
-                case 'f':
-                    *output_pointer++ = '\f';
-                    break;
-                case 'n':
-                    *output_pointer++ = '\n';
-                    break;
-                case 'r':
-                    *output_pointer++ = '\r';
-                    break;
-                case 't':
-                    *output_pointer++ = '\t';
-                    break;
-                case '\"':
-                case '\\':
-                case '/':
-                    *output_pointer++ = input_pointer[1];
-                    break;
-
-                /* UTF-16 literal */
-                case 'u':
-                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
-                    if (sequence_length == 0)
-                    {
-                        /* failed to convert UTF16-literal to UTF-8 */
-                        goto fail;
-                    }
-                    break;
-
-                default:
-                    goto fail;
-            }
-            input_pointer += sequence_length;
-        }
-    }
-
-    /* zero terminate the output */
-    *output_pointer = '\0';
-
-    item->type = cJSON_String;
-    item->valuestring = (char*)output;
-
-    input_buffer->offset = (size_t) (input_end - input_buffer->content);
-    input_buffer->offset++;
+        }
+    }
 
     return true;
+}
 
-fail:
-    if (output != NULL)
-    {
-        input_buffer->hooks.deallocate(output);
-    }
+#ifdef CJSON_X86_SIMD
+__attribute__((target("sse2")))
+static const unsigned char *scan_string_sse2(const unsigned char *start, const unsigned char *end)
+{
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
 
-    if (input_pointer != NULL)
+    while ((size_t)(end - start) >= 16)
     {
-        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+        __m128i block = _mm_loadu_si128((const __m128i*)(const void*)start);
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)));
+        if (mask != 0)
+        {
+            return start + __builtin_ctz((unsigned int)mask);
+        }
+        start += 16;
     }
 
-    return false;
+    return scan_string_scalar(start, end);
 }
 
-/* Render the cstring provided to an escaped version that can be printed. */
-static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+__attribute__((target("avx2")))
+static const unsigned char *scan_string_avx2(const unsigned char *start, const unsigned char *end)
 {
-    const unsigned char *input_pointer = NULL;
-    unsigned char *output = NULL;
-    unsigned char *output_pointer = NULL;
-    size_t output_length = 0;
-    /* numbers of additional characters needed for escaping */
-    size_t escape_characters = 0;
-
-    if (output_buffer == NULL)
-    {
-        return false;
-    }
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
 
-    /* empty string */
-    if (input == NULL)
+    while ((size_t)(end - start) >= 32)
     {
-        output = ensure(output_buffer, sizeof("\"\""));
-        if (output == NULL)
+        __m256i block = _mm256_loadu_si256((const __m256i*)(const void*)start);
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash)));
+        if (mask != 0)
         {
-            return false;
+            return start + __builtin_ctz(mask);
         }
-        strcpy((char*)output, "\"\"");
-
-        return true;
+        start += 32;
     }
-
-    /* set "flag" to 1 if something needs to be escaped */
-    for (input_pointer = input; *input_pointer; input_pointer++)
+    if ((size_t)(end - start) >= 16)
     {
-        switch (*input_pointer)
+        __m128i block = _mm_loadu_si128((const __m128i*)(const void*)start);
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, _mm256_castsi256_si128(quote)), _mm_cmpeq_epi8(block, _mm256_castsi256_si128(backslash))));
+        if (mask != 0)
         {
-            case '\"':
-            case '\\':
-            case '\b':
-            case '\f':
-            case '\n':
-            case '\r':
-            case '\t':
-                /* one character escape sequence */
-                escape_characters++;
-                break;
-            default:
-                if (*input_pointer < 32)
-                {
-                    /* UTF-16 escape sequence uXXXX */
-                    escape_characters += 5;
-                }
-                break;
+            return start + __builtin_ctz(mask);
         }
+        start += 16;
     }
-    output_length = (size_t)(input_pointer - input) + escape_characters;
 
-    output = ensure(output_buffer, output_length + sizeof("\"\""));
-    if (output == NULL)
+    return scan_string_scalar(start, end);
+}
+
+/* a byte is a control character if min(byte, 0x1F) is the byte itself */
+__attribute__((target("sse2")))
+static const unsigned char *scan_escape_sse2(const unsigned char *start, const unsigned char *end)
+{
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+
+    while ((size_t)(end - start) >= 16)
     {
-        return false;
+        __m128i block = _mm_loadu_si128((const __m128i*)(const void*)start);
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash));
+        int mask = _mm_movemask_epi8(_mm_or_si128(special, _mm_cmpeq_epi8(_mm_min_epu8(block, control), block)));
+        if (mask != 0)
+        {
+            return start + __builtin_ctz((unsigned int)mask);
+        }
+        start += 16;
     }
 
-    /* no characters have to be escaped */
-    if (escape_characters == 0)
-    {
-        output[0] = '\"';
-        memcpy(output + 1, input, output_length);
-        output[output_length + 1] = '\"';
-        output[output_length + 2] = '\0';
+    return scan_escape_scalar(start, end);
+}
 
-        return true;
-    }
+__attribute__((target("avx2")))
+static const unsigned char *scan_escape_avx2(const unsigned char *start, const unsigned char *end)
+{
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
 
-    output[0] = '\"';
-    output_pointer = output + 1;
-    /* copy the string */
-    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
+    while ((size_t)(end - start) >= 32)
     {
-        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
-        {
-            /* normal character, copy */
-            *output_pointer = *input_pointer;
-        }
-        else
+        __m256i block = _mm256_loadu_si256((const __m256i*)(const void*)start);
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_min_epu8(block, control), block)));
+        if (mask != 0)
         {
-            /* character needs to be escaped */
-            *output_pointer++ = '\\';
-            switch (*input_pointer)
-            {
-                case '\\':
-                    *output_pointer = '\\';
-                    break;
-                case '\"':
-                    *output_pointer = '\"';
-                    break;
-                case '\b':
-                    *output_pointer = 'b';
-                    break;
-                case '\f':
-                    *output_pointer = 'f';
-                    break;
-                case '\n':
-                    *output_pointer = 'n';
-                    break;
-                case '\r':
-                    *output_pointer = 'r';
-                    break;
-                case '\t':
-                    *output_pointer = 't';
-                    break;
-                default:
-                    /* escape and print as unicode codepoint */
-                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
-                    output_pointer += 4;
-                    break;
-            }
+            return start + __builtin_ctz(mask);
         }
+        start += 32;
     }
-    output[output_length + 1] = '\"';
-    output[output_length + 2] = '\0';
 
-    return true;
+    return scan_escape_sse2(start, end);
 }
 
-/* Invoke print_string_ptr (which is useful) on an item. */
-static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
+/* a byte is whitespace (or another control character) if max(byte, ' ') is ' ' */
+__attribute__((target("sse2")))
+static const unsigned char *scan_whitespace_sse2(const unsigned char *start, const unsigned char *end)
 {
-    return print_string_ptr((unsigned char*)item->valuestring, p);
-}
-
-/* Predeclare these prototypes. */
-static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
+    const __m128i space = _mm_set1_epi8(' ');
 
-/* Utility to jump whitespace and cr/lf */
-static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
-{
-    if ((buffer == NULL) || (buffer->content == NULL))
+    while ((size_t)(end - start) >= 16)
     {
-        return NULL;
+        __m128i block = _mm_loadu_si128((const __m128i*)(const void*)start);
+        unsigned int mask = ~(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(block, space), space)) & 0xFFFF;
+        if (mask != 0)
+        {
+            return start + __builtin_ctz(mask);
+        }
+        start += 16;
     }
 
-    if (cannot_access_at_index(buffer, 0))
-    {
-        return buffer;
-    }
+    return scan_whitespace_scalar(start, end);
+}
 
-    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
-    {
-       buffer->offset++;
-    }
+__attribute__((target("avx2")))
+static const unsigned char *scan_whitespace_avx2(const unsigned char *start, const unsigned char *end)
+{
+    const __m256i space = _mm256_set1_epi8(' ');
 
-    if (buffer->offset == buffer->length)
+    while ((size_t)(end - start) >= 32)
     {
-        buffer->offset--;
+        __m256i block = _mm256_loadu_si256((const __m256i*)(const void*)start);
+        unsigned int mask = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(block, space), space));
+        if (mask != 0)
+        {
+            return start + __builtin_ctz(mask);
+        }
+        start += 32;
     }
 
-    return buffer;
+    return scan_whitespace_sse2(start, end);
 }
 
-/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
-static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+/* Minifying in blocks of 64 bytes: the block is classified into bit masks, the quotes
+ * that are not escaped give the bytes inside strings, and every byte except the
+ * whitespace outside of strings is packed to the output. Comments are left to the
+ * scalar code, so the blocks stop at the first '/' outside of a string. */
+typedef struct
 {
-    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
-    {
-        return NULL;
-    }
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t whitespace; /* only ' ', '\t', '\r' and '\n' like cJSON_Minify */
+    uint64_t slash;
+} minify_masks;
+
+typedef void (*minify_classifier)(const unsigned char *block, minify_masks *masks);
+typedef unsigned char *(*minify_packer)(const unsigned char *block, uint64_t keep, unsigned char *output);
+
+/* bit i of the result is set if byte i of the four parts equals one of the characters */
+__attribute__((target("sse2")))
+static uint64_t minify_match_sse2(const __m128i *parts, char first, char second)
+{
+    uint64_t mask = 0;
+    int i = 0;
 
-    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+    for (i = 0; i < 4; i++)
     {
-        buffer->offset += 3;
+        __m128i matches = _mm_or_si128(_mm_cmpeq_epi8(parts[i], _mm_set1_epi8(first)), _mm_cmpeq_epi8(parts[i], _mm_set1_epi8(second)));
+        mask |= (uint64_t)(unsigned int)_mm_movemask_epi8(matches) << (16 * i);
     }
 
-    return buffer;
+    return mask;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+__attribute__((target("sse2")))
+static void minify_classify_sse2(const unsigned char *block, minify_masks *masks)
 {
-    size_t buffer_length;
+    __m128i parts[4];
+    int i = 0;
 
-    if (NULL == value)
+    for (i = 0; i < 4; i++)
     {
-        return NULL;
+        parts[i] = _mm_loadu_si128((const __m128i*)(const void*)(block + 16 * i));
     }
+    masks->quote = minify_match_sse2(parts, '\"', '\"');
+    masks->backslash = minify_match_sse2(parts, '\\', '\\');
+    masks->whitespace = minify_match_sse2(parts, ' ', '\t') | minify_match_sse2(parts, '\r', '\n');
+    masks->slash = minify_match_sse2(parts, '/', '/');
+}
 
-    /* Adding null character size due to require_null_terminated. */
-    buffer_length = strlen(value) + sizeof("");
+__attribute__((target("avx2")))
+static uint64_t minify_match_avx2(__m256i low, __m256i high, char first, char second)
+{
+    __m256i first_vector = _mm256_set1_epi8(first);
+    __m256i second_vector = _mm256_set1_epi8(second);
+    uint64_t low_mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(low, first_vector), _mm256_cmpeq_epi8(low, second_vector)));
+    uint64_t high_mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(high, first_vector), _mm256_cmpeq_epi8(high, second_vector)));
 
-    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
+    return low_mask | (high_mask << 32);
 }
 
-/* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+__attribute__((target("avx2")))
+static void minify_classify_avx2(const unsigned char *block, minify_masks *masks)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
-    cJSON *item = NULL;
+    __m256i low = _mm256_loadu_si256((const __m256i*)(const void*)block);
+    __m256i high = _mm256_loadu_si256((const __m256i*)(const void*)(block + 32));
 
-    /* reset error position */
-    global_error.json = NULL;
-    global_error.position = 0;
+    masks->quote = minify_match_avx2(low, high, '\"', '\"');
+    masks->backslash = minify_match_avx2(low, high, '\\', '\\');
+    masks->whitespace = minify_match_avx2(low, high, ' ', '\t') | minify_match_avx2(low, high, '\r', '\n');
+    masks->slash = minify_match_avx2(low, high, '/', '/');
+}
 
-    if (value == NULL || 0 == buffer_length)
+/* Copy block[i] for every bit i set in keep. The output never gets ahead of the bytes
+ * still to be read, so this also works in place. */
+static unsigned char *minify_pack_bits(const unsigned char *block, uint64_t keep, unsigned char *output)
+{
+    while (keep != 0)
     {
-        goto fail;
+        *output++ = block[__builtin_ctzll(keep)];
+        keep &= keep - 1;
     }
 
-    buffer.content = (const unsigned char*)value;
-    buffer.length = buffer_length;
-    buffer.offset = 0;
-    buffer.hooks = global_hooks;
-
-    item = cJSON_New_Item(&global_hooks);
-    if (item == NULL) /* memory fail */
-    {
-        goto fail;
-    }
+    return output;
+}
 
-    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
-    {
-        /* parse failure. ep is set. */
-        goto fail;
-    }
+/* for every byte value, the positions of its set bits */
+static const unsigned char minify_shuffles[256][8] =
+{
+    { 0, 0, 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0, 0, 0 }, { 1, 0, 0, 0, 0, 0, 0, 0 }, { 0, 1, 0, 0, 0, 0, 0, 0 },
+    { 2, 0, 0, 0, 0, 0, 0, 0 }, { 0, 2, 0, 0, 0, 0, 0, 0 }, { 1, 2, 0, 0, 0, 0, 0, 0 }, { 0, 1, 2, 0, 0, 0, 0, 0 },
+    { 3, 0, 0, 0, 0, 0, 0, 0 }, { 0, 3, 0, 0, 0, 0, 0, 0 }, { 1, 3, 0, 0, 0, 0, 0, 0 }, { 0, 1, 3, 0, 0, 0, 0, 0 },
+    { 2, 3, 0, 0, 0, 0, 0, 0 }, { 0, 2, 3, 0, 0, 0, 0, 0 }, { 1, 2, 3, 0, 0, 0, 0, 0 }, { 0, 1, 2, 3, 0, 0, 0, 0 },
+    { 4, 0, 0, 0, 0, 0, 0, 0 }, { 0, 4, 0, 0, 0, 0, 0, 0 }, { 1, 4, 0, 0, 0, 0, 0, 0 }, { 0, 1, 4, 0, 0, 0, 0, 0 },
+    { 2, 4, 0, 0, 0, 0, 0, 0 }, { 0, 2, 4, 0, 0, 0, 0, 0 }, { 1, 2, 4, 0, 0, 0, 0, 0 }, { 0, 1, 2, 4, 0, 0, 0, 0 },
+    { 3, 4, 0, 0, 0, 0, 0, 0 }, { 0, 3, 4, 0, 0, 0, 0, 0 }, { 1, 3, 4, 0, 0, 0, 0, 0 }, { 0, 1, 3, 4, 0, 0, 0, 0 },
+    { 2, 3, 4, 0, 0, 0, 0, 0 }, { 0, 2, 3, 4, 0, 0, 0, 0 }, { 1, 2, 3, 4, 0, 0, 0, 0 }, { 0, 1, 2, 3, 4, 0, 0, 0 },
+    { 5, 0, 0, 0, 0, 0, 0, 0 }, { 0, 5, 0, 0, 0, 0, 0, 0 }, { 1, 5, 0, 0, 0, 0, 0, 0 }, { 0, 1, 5, 0, 0, 0, 0, 0 },
+    { 2, 5, 0, 0, 0, 0, 0, 0 }, { 0, 2, 5, 0, 0, 0, 0, 0 }, { 1, 2, 5, 0, 0, 0, 0, 0 }, { 0, 1, 2, 5, 0, 0, 0, 0 },
+    { 3, 5, 0, 0, 0, 0, 0, 0 }, { 0, 3, 5, 0, 0, 0, 0, 0 }, { 1, 3, 5, 0, 0, 0, 0, 0 }, { 0, 1, 3, 5, 0, 0, 0, 0 },
+    { 2, 3, 5, 0, 0, 0, 0, 0 }, { 0, 2, 3, 5, 0, 0, 0, 0 }, { 1, 2, 3, 5, 0, 0, 0, 0 }, { 0, 1, 2, 3, 5, 0, 0, 0 },
+    { 4, 5, 0, 0, 0, 0, 0, 0 }, { 0, 4, 5, 0, 0, 0, 0, 0 }, { 1, 4, 5, 0, 0, 0, 0, 0 }, { 0, 1, 4, 5, 0, 0, 0, 0 },
+    { 2, 4, 5, 0, 0, 0, 0, 0 }, { 0, 2, 4, 5, 0, 0, 0, 0 }, { 1, 2, 4, 5, 0, 0, 0, 0 }, { 0, 1, 2, 4, 5, 0, 0, 0 },
+    { 3, 4, 5, 0, 0, 0, 0, 0 }, { 0, 3, 4, 5, 0, 0, 0, 0 }, { 1, 3, 4, 5, 0, 0, 0, 0 }, { 0, 1, 3, 4, 5, 0, 0, 0 },
+    { 2, 3, 4, 5, 0, 0, 0, 0 }, { 0, 2, 3, 4, 5, 0, 0, 0 }, { 1, 2, 3, 4, 5, 0, 0, 0 }, { 0, 1, 2, 3, 4, 5, 0, 0 },
+    { 6, 0, 0, 0, 0, 0, 0, 0 }, { 0, 6, 0, 0, 0, 0, 0, 0 }, { 1, 6, 0, 0, 0, 0, 0, 0 }, { 0, 1, 6, 0, 0, 0, 0, 0 },
+    { 2, 6, 0, 0, 0, 0, 0, 0 }, { 0, 2, 6, 0, 0, 0, 0, 0 }, { 1, 2, 6, 0, 0, 0, 0, 0 }, { 0, 1, 2, 6, 0, 0, 0, 0 },
+    { 3, 6, 0, 0, 0, 0, 0, 0 }, { 0, 3, 6, 0, 0, 0, 0, 0 }, { 1, 3, 6, 0, 0, 0, 0, 0 }, { 0, 1, 3, 6, 0, 0, 0, 0 },
+    { 2, 3, 6, 0, 0, 0, 0, 0 }, { 0, 2, 3, 6, 0, 0, 0, 0 }, { 1, 2, 3, 6, 0, 0, 0, 0 }, { 0, 1, 2, 3, 6, 0, 0, 0 },
+    { 4, 6, 0, 0, 0, 0, 0, 0 }, { 0, 4, 6, 0, 0, 0, 0, 0 }, { 1, 4, 6, 0, 0, 0, 0, 0 }, { 0, 1, 4, 6, 0, 0, 0, 0 },
+    { 2, 4, 6, 0, 0, 0, 0, 0 }, { 0, 2, 4, 6, 0, 0, 0, 0 }, { 1, 2, 4, 6, 0, 0, 0, 0 }, { 0, 1, 2, 4, 6, 0, 0, 0 },
+    { 3, 4, 6, 0, 0, 0, 0, 0 }, { 0, 3, 4, 6, 0, 0, 0, 0 }, { 1, 3, 4, 6, 0, 0, 0, 0 }, { 0, 1, 3, 4, 6, 0, 0, 0 },
+    { 2, 3, 4, 6, 0, 0, 0, 0 }, { 0, 2, 3, 4, 6, 0, 0, 0 }, { 1, 2, 3, 4, 6, 0, 0, 0 }, { 0, 1, 2, 3, 4, 6, 0, 0 },
+    { 5, 6, 0, 0, 0, 0, 0, 0 }, { 0, 5, 6, 0, 0, 0, 0, 0 }, { 1, 5, 6, 0, 0, 0, 0, 0 }, { 0, 1, 5, 6, 0, 0, 0, 0 },
+    { 2, 5, 6, 0, 0, 0, 0, 0 }, { 0, 2, 5, 6, 0, 0, 0, 0 }, { 1, 2, 5, 6, 0, 0, 0, 0 }, { 0, 1, 2, 5, 6, 0, 0, 0 },
+    { 3, 5, 6, 0, 0, 0, 0, 0 }, { 0, 3, 5, 6, 0, 0, 0, 0 }, { 1, 3, 5, 6, 0, 0, 0, 0 }, { 0, 1, 3, 5, 6, 0, 0, 0 },
+    { 2, 3, 5, 6, 0, 0, 0, 0 }, { 0, 2, 3, 5, 6, 0, 0, 0 }, { 1, 2, 3, 5, 6, 0, 0, 0 }, { 0, 1, 2, 3, 5, 6, 0, 0 },
+    { 4, 5, 6, 0, 0, 0, 0, 0 }, { 0, 4, 5, 6, 0, 0, 0, 0 }, { 1, 4, 5, 6, 0, 0, 0, 0 }, { 0, 1, 4, 5, 6, 0, 0, 0 },
+    { 2, 4, 5, 6, 0, 0, 0, 0 }, { 0, 2, 4, 5, 6, 0, 0, 0 }, { 1, 2, 4, 5, 6, 0, 0, 0 }, { 0, 1, 2, 4, 5, 6, 0, 0 },
+    { 3, 4, 5, 6, 0, 0, 0, 0 }, { 0, 3, 4, 5, 6, 0, 0, 0 }, { 1, 3, 4, 5, 6, 0, 0, 0 }, { 0, 1, 3, 4, 5, 6, 0, 0 },
+    { 2, 3, 4, 5, 6, 0, 0, 0 }, { 0, 2, 3, 4, 5, 6, 0, 0 }, { 1, 2, 3, 4, 5, 6, 0, 0 }, { 0, 1, 2, 3, 4, 5, 6, 0 },
+    { 7, 0, 0, 0, 0, 0, 0, 0 }, { 0, 7, 0, 0, 0, 0, 0, 0 }, { 1, 7, 0, 0, 0, 0, 0, 0 }, { 0, 1, 7, 0, 0, 0, 0, 0 },
+    { 2, 7, 0, 0, 0, 0, 0, 0 }, { 0, 2, 7, 0, 0, 0, 0, 0 }, { 1, 2, 7, 0, 0, 0, 0, 0 }, { 0, 1, 2, 7, 0, 0, 0, 0 },
+    { 3, 7, 0, 0, 0, 0, 0, 0 }, { 0, 3, 7, 0, 0, 0, 0, 0 }, { 1, 3, 7, 0, 0, 0, 0, 0 }, { 0, 1, 3, 7, 0, 0, 0, 0 },
+    { 2, 3, 7, 0, 0, 0, 0, 0 }, { 0, 2, 3, 7, 0, 0, 0, 0 }, { 1, 2, 3, 7, 0, 0, 0, 0 }, { 0, 1, 2, 3, 7, 0, 0, 0 },
+    { 4, 7, 0, 0, 0, 0, 0, 0 }, { 0, 4, 7, 0, 0, 0, 0, 0 }, { 1, 4, 7, 0, 0, 0, 0, 0 }, { 0, 1, 4, 7, 0, 0, 0, 0 },
+    { 2, 4, 7, 0, 0, 0, 0, 0 }, { 0, 2, 4, 7, 0, 0, 0, 0 }, { 1, 2, 4, 7, 0, 0, 0, 0 }, { 0, 1, 2, 4, 7, 0, 0, 0 },
+    { 3, 4, 7, 0, 0, 0, 0, 0 }, { 0, 3, 4, 7, 0, 0, 0, 0 }, { 1, 3, 4, 7, 0, 0, 0, 0 }, { 0, 1, 3, 4, 7, 0, 0, 0 },
+    { 2, 3, 4, 7, 0, 0, 0, 0 }, { 0, 2, 3, 4, 7, 0, 0, 0 }, { 1, 2, 3, 4, 7, 0, 0, 0 }, { 0, 1, 2, 3, 4, 7, 0, 0 },
+    { 5, 7, 0, 0, 0, 0, 0, 0 }, { 0, 5, 7, 0, 0, 0, 0, 0 }, { 1, 5, 7, 0, 0, 0, 0, 0 }, { 0, 1, 5, 7, 0, 0, 0, 0 },
+    { 2, 5, 7, 0, 0, 0, 0, 0 }, { 0, 2, 5, 7, 0, 0, 0, 0 }, { 1, 2, 5, 7, 0, 0, 0, 0 }, { 0, 1, 2, 5, 7, 0, 0, 0 },
+    { 3, 5, 7, 0, 0, 0, 0, 0 }, { 0, 3, 5, 7, 0, 0, 0, 0 }, { 1, 3, 5, 7, 0, 0, 0, 0 }, { 0, 1, 3, 5, 7, 0, 0, 0 },
+    { 2, 3, 5, 7, 0, 0, 0, 0 }, { 0, 2, 3, 5, 7, 0, 0, 0 }, { 1, 2, 3, 5, 7, 0, 0, 0 }, { 0, 1, 2, 3, 5, 7, 0, 0 },
+    { 4, 5, 7, 0, 0, 0, 0, 0 }, { 0, 4, 5, 7, 0, 0, 0, 0 }, { 1, 4, 5, 7, 0, 0, 0, 0 }, { 0, 1, 4, 5, 7, 0, 0, 0 },
+    { 2, 4, 5, 7, 0, 0, 0, 0 }, { 0, 2, 4, 5, 7, 0, 0, 0 }, { 1, 2, 4, 5, 7, 0, 0, 0 }, { 0, 1, 2, 4, 5, 7, 0, 0 },
+    { 3, 4, 5, 7, 0, 0, 0, 0 }, { 0, 3, 4, 5, 7, 0, 0, 0 }, { 1, 3, 4, 5, 7, 0, 0, 0 }, { 0, 1, 3, 4, 5, 7, 0, 0 },
+    { 2, 3, 4, 5, 7, 0, 0, 0 }, { 0, 2, 3, 4, 5, 7, 0, 0 }, { 1, 2, 3, 4, 5, 7, 0, 0 }, { 0, 1, 2, 3, 4, 5, 7, 0 },
+    { 6, 7, 0, 0, 0, 0, 0, 0 }, { 0, 6, 7, 0, 0, 0, 0, 0 }, { 1, 6, 7, 0, 0, 0, 0, 0 }, { 0, 1, 6, 7, 0, 0, 0, 0 },
+    { 2, 6, 7, 0, 0, 0, 0, 0 }, { 0, 2, 6, 7, 0, 0, 0, 0 }, { 1, 2, 6, 7, 0, 0, 0, 0 }, { 0, 1, 2, 6, 7, 0, 0, 0 },
+    { 3, 6, 7, 0, 0, 0, 0, 0 }, { 0, 3, 6, 7, 0, 0, 0, 0 }, { 1, 3, 6, 7, 0, 0, 0, 0 }, { 0, 1, 3, 6, 7, 0, 0, 0 },
+    { 2, 3, 6, 7, 0, 0, 0, 0 }, { 0, 2, 3, 6, 7, 0, 0, 0 }, { 1, 2, 3, 6, 7, 0, 0, 0 }, { 0, 1, 2, 3, 6, 7, 0, 0 },
+    { 4, 6, 7, 0, 0, 0, 0, 0 }, { 0, 4, 6, 7, 0, 0, 0, 0 }, { 1, 4, 6, 7, 0, 0, 0, 0 }, { 0, 1, 4, 6, 7, 0, 0, 0 },
+    { 2, 4, 6, 7, 0, 0, 0, 0 }, { 0, 2, 4, 6, 7, 0, 0, 0 }, { 1, 2, 4, 6, 7, 0, 0, 0 }, { 0, 1, 2, 4, 6, 7, 0, 0 },
+    { 3, 4, 6, 7, 0, 0, 0, 0 }, { 0, 3, 4, 6, 7, 0, 0, 0 }, { 1, 3, 4, 6, 7, 0, 0, 0 }, { 0, 1, 3, 4, 6, 7, 0, 0 },
+    { 2, 3, 4, 6, 7, 0, 0, 0 }, { 0, 2, 3, 4, 6, 7, 0, 0 }, { 1, 2, 3, 4, 6, 7, 0, 0 }, { 0, 1, 2, 3, 4, 6, 7, 0 },
+    { 5, 6, 7, 0, 0, 0, 0, 0 }, { 0, 5, 6, 7, 0, 0, 0, 0 }, { 1, 5, 6, 7, 0, 0, 0, 0 }, { 0, 1, 5, 6, 7, 0, 0, 0 },
+    { 2, 5, 6, 7, 0, 0, 0, 0 }, { 0, 2, 5, 6, 7, 0, 0, 0 }, { 1, 2, 5, 6, 7, 0, 0, 0 }, { 0, 1, 2, 5, 6, 7, 0, 0 },
+    { 3, 5, 6, 7, 0, 0, 0, 0 }, { 0, 3, 5, 6, 7, 0, 0, 0 }, { 1, 3, 5, 6, 7, 0, 0, 0 }, { 0, 1, 3, 5, 6, 7, 0, 0 },
+    { 2, 3, 5, 6, 7, 0, 0, 0 }, { 0, 2, 3, 5, 6, 7, 0, 0 }, { 1, 2, 3, 5, 6, 7, 0, 0 }, { 0, 1, 2, 3, 5, 6, 7, 0 },
+    { 4, 5, 6, 7, 0, 0, 0, 0 }, { 0, 4, 5, 6, 7, 0, 0, 0 }, { 1, 4, 5, 6, 7, 0, 0, 0 }, { 0, 1, 4, 5, 6, 7, 0, 0 },
+    { 2, 4, 5, 6, 7, 0, 0, 0 }, { 0, 2, 4, 5, 6, 7, 0, 0 }, { 1, 2, 4, 5, 6, 7, 0, 0 }, { 0, 1, 2, 4, 5, 6, 7, 0 },
+    { 3, 4, 5, 6, 7, 0, 0, 0 }, { 0, 3, 4, 5, 6, 7, 0, 0 }, { 1, 3, 4, 5, 6, 7, 0, 0 }, { 0, 1, 3, 4, 5, 6, 7, 0 },
+    { 2, 3, 4, 5, 6, 7, 0, 0 }, { 0, 2, 3, 4, 5, 6, 7, 0 }, { 1, 2, 3, 4, 5, 6, 7, 0 }, { 0, 1, 2, 3, 4, 5, 6, 7 }
+};
+
+/* Pack eight bytes at a time with a shuffle. Each store writes eight bytes, more than
+ * it keeps, but never past the end of the eight bytes that were just loaded. */
+__attribute__((target("avx2")))
+static unsigned char *minify_pack_shuffle(const unsigned char *block, uint64_t keep, unsigned char *output)
+{
+    int i = 0;
 
-    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
-    if (require_null_terminated)
+    if (keep == ~(uint64_t)0)
     {
-        buffer_skip_whitespace(&buffer);
-        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
-        {
-            goto fail;
-        }
+        memmove(output, block, 64);
+        return output + 64;
     }
-    if (return_parse_end)
+    for (i = 0; i < 8; i++)
     {
-        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+        unsigned int bits = (unsigned int)(keep >> (8 * i)) & 0xFF;
+        __m128i bytes = _mm_loadl_epi64((const __m128i*)(const void*)(block + 8 * i));
+        __m128i shuffle = _mm_loadl_epi64((const __m128i*)(const void*)minify_shuffles[bits]);
+        _mm_storel_epi64((__m128i*)(void*)output, _mm_shuffle_epi8(bytes, shuffle));
+        output += __builtin_popcount(bits);
     }
 
-    return item;
+    return output;
+}
 
-fail:
-    if (item != NULL)
-    {
-        cJSON_Delete(item);
-    }
+/* the escaped characters of a block, from the runs of backslashes with an odd length */
+static uint64_t minify_find_escaped(uint64_t backslash, uint64_t *ends_odd_backslash)
+{
+    const uint64_t even_bits = 0x5555555555555555ULL;
+    uint64_t start_edges = backslash & ~(backslash << 1);
+    uint64_t even_start_mask = even_bits ^ *ends_odd_backslash;
+    uint64_t even_carries = backslash + (start_edges & even_start_mask);
+    uint64_t odd_carries = backslash + (start_edges & ~even_start_mask);
+    uint64_t ends_odd = (odd_carries < backslash) ? 1 : 0;
 
-    if (value != NULL)
-    {
-        error local_error;
-        local_error.json = (const unsigned char*)value;
-        local_error.position = 0;
+    odd_carries |= *ends_odd_backslash;
+    *ends_odd_backslash = ends_odd;
 
-        if (buffer.offset < buffer.length)
+    return ((even_carries & ~backslash) & ~even_bits) | ((odd_carries & ~backslash) & even_bits);
+}
+
+/* Minify whole blocks from *input up to the first '/' outside of a string or the end.
+ * *input must be outside of a string. Backslashes are expected inside strings only, as
+ * in valid JSON; elsewhere they escape a quote here but not in the byte by byte loop. */
+static void minify_blocks(unsigned char **input, const unsigned char *end, unsigned char **output, minify_classifier classify, minify_packer pack)
+{
+    unsigned char *position = *input;
+    unsigned char *into = *output;
+    unsigned char tail[64];
+    uint64_t ends_odd_backslash = 0;
+    uint64_t in_string_carry = 0;
+
+    while (position < end)
+    {
+        const unsigned char *block = position;
+        size_t length = (size_t)(end - position);
+        uint64_t valid = ~(uint64_t)0;
+        uint64_t in_string = 0;
+        uint64_t keep = 0;
+        uint64_t comments = 0;
+        minify_masks masks;
+
+        if (length < 64)
         {
-            local_error.position = buffer.offset;
+            /* the last block is padded with spaces, which are dropped anyway */
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, position, length);
+            block = tail;
+            valid = ((uint64_t)1 << length) - 1;
         }
-        else if (buffer.length > 0)
+        else
         {
-            local_error.position = buffer.length - 1;
+            length = 64;
         }
 
-        if (return_parse_end != NULL)
+        classify(block, &masks);
+        /* bit i of in_string is the XOR of the quote bits up to i */
+        in_string = masks.quote & ~minify_find_escaped(masks.backslash, &ends_odd_backslash);
+        in_string ^= in_string << 1;
+        in_string ^= in_string << 2;
+        in_string ^= in_string << 4;
+        in_string ^= in_string << 8;
+        in_string ^= in_string << 16;
+        in_string ^= in_string << 32;
+        in_string ^= in_string_carry;
+        in_string_carry = 0 - (in_string >> 63);
+
+        keep = ~(masks.whitespace & ~in_string) & valid;
+        comments = masks.slash & ~in_string & valid;
+        if (comments != 0)
         {
-            *return_parse_end = (const char*)local_error.json + local_error.position;
+            length = (size_t)__builtin_ctzll(comments);
+            into = minify_pack_bits(block, keep & (((uint64_t)1 << length) - 1), into);
+            position += length;
+            break;
         }
 
-        global_error = local_error;
+        into = (length == 64) ? pack(block, keep, into) : minify_pack_bits(block, keep, into);
+        position += length;
     }
 
-    return NULL;
+    *input = position;
+    *output = into;
 }
 
-/* Default options for cJSON_Parse */
-CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+__attribute__((target("sse2")))
+static void minify_blocks_sse2(unsigned char **input, const unsigned char *end, unsigned char **output)
 {
-    return cJSON_ParseWithOpts(value, 0, 0);
+    minify_blocks(input, end, output, minify_classify_sse2, minify_pack_bits);
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+__attribute__((target("avx2")))
+static void minify_blocks_avx2(unsigned char **input, const unsigned char *end, unsigned char **output)
 {
-    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+    minify_blocks(input, end, output, minify_classify_avx2, minify_pack_shuffle);
 }
 
-#define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
-
-static unsigned char *print(const cJSON * const item, cJSON_bool format, const internal_hooks * const hooks)
+/* Mostly ASCII text: skip 16 byte blocks without a high bit, check the sequences
+ * found in between one by one. */
+__attribute__((target("sse2")))
+static cJSON_bool validate_utf8_sse2(const unsigned char *start, const unsigned char *end)
 {
-    static const size_t default_buffer_size = 256;
-    printbuffer buffer[1];
-    unsigned char *printed = NULL;
-
-    memset(buffer, 0, sizeof(buffer));
-
-    /* create buffer */
-    buffer->buffer = (unsigned char*) hooks->allocate(default_buffer_size);
-    buffer->length = default_buffer_size;
-    buffer->format = format;
-    buffer->hooks = *hooks;
-    if (buffer->buffer == NULL)
+    while (start < end)
     {
-        goto fail;
+        if ((size_t)(end - start) >= 16)
+        {
+            int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(const void*)start));
+            if (mask == 0)
+            {
+                start += 16;
+                continue;
+            }
+            start += __builtin_ctz((unsigned int)mask);
+        }
+        else if (*start < 0x80)
+        {
+            start++;
+            continue;
+        }
+
+        start = utf8_sequence_end(start, end);
+        if (start == NULL)
+        {
+            return false;
+        }
     }
 
-    /* print the value */
-    if (!print_value(item, buffer))
-    {
-        goto fail;
-    }
-    update_offset(buffer);
+    return true;
+}
 
-    /* check if reallocate is available */
-    if (hooks->reallocate != NULL)
+/* Lookup algorithm of Keiser and Lemire ("Validating UTF-8 in less than one instruction
+ * per byte", 2021): three table lookups on the nibbles of each byte and the byte before
+ * it find every error between two bytes, only the continuation bytes that a 3 or 4 byte
+ * lead asks for are checked against the bytes two and three back. */
+#define UTF8_TOO_SHORT 0x01      /* lead or ASCII byte followed by a lead byte */
+#define UTF8_TOO_LONG 0x02       /* ASCII byte followed by a continuation */
+#define UTF8_OVERLONG_3 0x04     /* 11100000 100_____ */
+#define UTF8_TOO_LARGE 0x08      /* 11110100 1001____ and above */
+#define UTF8_SURROGATE 0x10      /* 11101101 101_____ */
+#define UTF8_OVERLONG_2 0x20     /* 1100000_ 10______ */
+#define UTF8_TOO_LARGE_1000 0x40 /* 11110101 1000____ and above */
+#define UTF8_OVERLONG_4 0x40     /* 11110000 1000____ */
+#define UTF8_TWO_CONTINUATIONS 0x80
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTINUATIONS)
+
+/* bytes of input shifted by count, with the last bytes of previous in front */
+#define utf8_previous_avx2(input, previous, count) _mm256_alignr_epi8((input), _mm256_permute2x128_si256((previous), (input), 0x21), 16 - (count))
+
+__attribute__((target("avx2")))
+static __m256i utf8_block_errors_avx2(__m256i input, __m256i previous)
+{
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    const __m256i byte_1_high_table = _mm256_setr_epi8(
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        (char)UTF8_TWO_CONTINUATIONS, (char)UTF8_TWO_CONTINUATIONS, (char)UTF8_TWO_CONTINUATIONS, (char)UTF8_TWO_CONTINUATIONS,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2, UTF8_TOO_SHORT, UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        (char)UTF8_TWO_CONTINUATIONS, (char)UTF8_TWO_CONTINUATIONS, (char)UTF8_TWO_CONTINUATIONS, (char)UTF8_TWO_CONTINUATIONS,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2, UTF8_TOO_SHORT, UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4);
+    const __m256i byte_1_low_table = _mm256_setr_epi8(
+        (char)(UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4), (char)(UTF8_CARRY | UTF8_OVERLONG_2),
+        (char)UTF8_CARRY, (char)UTF8_CARRY, (char)(UTF8_CARRY | UTF8_TOO_LARGE),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000), (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000), (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000), (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000), (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000), (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4), (char)(UTF8_CARRY | UTF8_OVERLONG_2),
+        (char)UTF8_CARRY, (char)UTF8_CARRY, (char)(UTF8_CARRY | UTF8_TOO_LARGE),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000), (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000), (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000), (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000), (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000), (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000));
+    const __m256i byte_2_high_table = _mm256_setr_epi8(
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT);
+    __m256i previous1 = utf8_previous_avx2(input, previous, 1);
+    __m256i previous2 = utf8_previous_avx2(input, previous, 2);
+    __m256i previous3 = utf8_previous_avx2(input, previous, 3);
+    __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(previous1, 4), low_nibble));
+    __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(previous1, low_nibble));
+    __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+    __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+    /* only 111_____ two back or 1111____ three back keep their high bit */
+    __m256i must_be_continuation = _mm256_or_si256(_mm256_subs_epu8(previous2, _mm256_set1_epi8((char)(0xE0 - 0x80))),
+                                                   _mm256_subs_epu8(previous3, _mm256_set1_epi8((char)(0xF0 - 0x80))));
+
+    return _mm256_xor_si256(special_cases, _mm256_and_si256(must_be_continuation, _mm256_set1_epi8((char)0x80)));
+}
+
+__attribute__((target("avx2")))
+static cJSON_bool validate_utf8_avx2(const unsigned char *start, const unsigned char *end)
+{
+    /* a lead byte in the last three positions that wants more bytes than are left */
+    const __m256i incomplete_limits = _mm256_setr_epi8(
+        (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF,
+        (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF,
+        (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF,
+        (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    __m256i previous = _mm256_setzero_si256();
+    __m256i previous_incomplete = _mm256_setzero_si256();
+    __m256i errors = _mm256_setzero_si256();
+    unsigned char tail[32];
+    size_t length = 0;
+
+    for (;;)
     {
-        printed = (unsigned char*) hooks->reallocate(buffer->buffer, buffer->offset + 1);
-        if (printed == NULL) {
-            goto fail;
+        __m256i input;
+        length = (size_t)(end - start);
+        if (length >= 32)
+        {
+            input = _mm256_loadu_si256((const __m256i*)(const void*)start);
         }
-        buffer->buffer = NULL;
-    }
-    else /* otherwise copy the JSON over to a new buffer */
-    {
-        printed = (unsigned char*) hooks->allocate(buffer->offset + 1);
-        if (printed == NULL)
+        else
         {
-            goto fail;
+            /* the last block is padded with zeros, which also catches a sequence cut short */
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, start, length);
+            input = _mm256_loadu_si256((const __m256i*)(const void*)tail);
         }
-        memcpy(printed, buffer->buffer, cjson_min(buffer->length, buffer->offset + 1));
-        printed[buffer->offset] = '\0'; /* just to be sure */
-
-        /* free the buffer */
-        hooks->deallocate(buffer->buffer);
-    }
-
-    return printed;
 
-fail:
-    if (buffer->buffer != NULL)
-    {
-        hooks->deallocate(buffer->buffer);
-    }
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            /* ASCII only, but the block before may have ended in the middle of a sequence */
+            errors = _mm256_or_si256(errors, previous_incomplete);
+            previous_incomplete = _mm256_setzero_si256();
+        }
+        else
+        {
+            errors = _mm256_or_si256(errors, utf8_block_errors_avx2(input, previous));
+            previous_incomplete = _mm256_subs_epu8(input, incomplete_limits);
+        }
+        previous = input;
 
-    if (printed != NULL)
-    {
-        hooks->deallocate(printed);
+        if (length < 32)
+        {
+            break;
+        }
+        start += 32;
     }
 
-    return NULL;
+    return _mm256_testz_si256(errors, errors) != 0;
 }
+#endif
 
-/* Render a cJSON item/entity/structure to text. */
-CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item)
-{
-    return (char*)print(item, true, &global_hooks);
-}
+static int simd_level = -1;
+static string_scanner scan_string_kernel = NULL;
+static string_scanner scan_escape_kernel = NULL;
+static string_scanner scan_whitespace_kernel = NULL;
+typedef void (*whitespace_compactor)(unsigned char **input, const unsigned char *end, unsigned char **output);
+static whitespace_compactor compact_whitespace_kernel = NULL;
+static utf8_validator validate_utf8_kernel = NULL;
 
-CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item)
+static int supported_simd_level(void)
 {
-    return (char*)print(item, false, &global_hooks);
+#ifdef CJSON_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return CJSON_SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return CJSON_SIMD_SSE2;
+    }
+#endif
+    return CJSON_SIMD_SCALAR;
 }
 
-CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt)
+CJSON_PUBLIC(int) cJSON_SetSimdLevel(int level)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    int supported = supported_simd_level();
 
-    if (prebuffer < 0)
+    if ((level < 0) || (level > supported))
     {
-        return NULL;
+        level = supported;
     }
 
-    p.buffer = (unsigned char*)global_hooks.allocate((size_t)prebuffer);
-    if (!p.buffer)
+    switch (level)
     {
-        return NULL;
+#ifdef CJSON_X86_SIMD
+        case CJSON_SIMD_AVX2:
+            scan_string_kernel = scan_string_avx2;
+            scan_escape_kernel = scan_escape_avx2;
+            scan_whitespace_kernel = scan_whitespace_avx2;
+            compact_whitespace_kernel = minify_blocks_avx2;
+            validate_utf8_kernel = validate_utf8_avx2;
+            break;
+        case CJSON_SIMD_SSE2:
+            scan_string_kernel = scan_string_sse2;
+            scan_escape_kernel = scan_escape_sse2;
+            scan_whitespace_kernel = scan_whitespace_sse2;
+            compact_whitespace_kernel = minify_blocks_sse2;
+            validate_utf8_kernel = validate_utf8_sse2;
+            break;
+#endif
+        default:
+            level = CJSON_SIMD_SCALAR;
+            scan_string_kernel = scan_string_scalar;
+            scan_escape_kernel = scan_escape_scalar;
+            scan_whitespace_kernel = scan_whitespace_scalar;
+            /* cJSON_Minify keeps its byte by byte loop */
+            compact_whitespace_kernel = NULL;
+            validate_utf8_kernel = validate_utf8_scalar;
+            break;
     }
+    simd_level = level;
 
-    p.length = (size_t)prebuffer;
-    p.offset = 0;
-    p.noalloc = false;
-    p.format = fmt;
-    p.hooks = global_hooks;
+    return level;
+}
 
-    if (!print_value(item, &p))
+CJSON_PUBLIC(int) cJSON_GetSimdLevel(void)
+{
+    if (simd_level < 0)
     {
-        global_hooks.deallocate(p.buffer);
-        return NULL;
+        cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
     }
 
-    return (char*)p.buffer;
+    return simd_level;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format)
+static const unsigned char *scan_string(const unsigned char *start, const unsigned char *end)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
-
-    if ((length < 0) || (buffer == NULL))
+    if (scan_string_kernel == NULL)
     {
-        return false;
+        cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
     }
 
-    p.buffer = (unsigned char*)buffer;
-    p.length = (size_t)length;
-    p.offset = 0;
-    p.noalloc = true;
-    p.format = format;
-    p.hooks = global_hooks;
-
-    return print_value(item, &p);
+    return scan_string_kernel(start, end);
 }
 
-/* Parser core - when encountering text, process appropriately. */
-static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
+static const unsigned char *scan_escape(const unsigned char *start, const unsigned char *end)
 {
-    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    if (scan_escape_kernel == NULL)
     {
-        return false; /* no input */
+        cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
     }
 
-    /* parse the different types of values */
-    /* null */
-    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
-    {
-        item->type = cJSON_NULL;
-        input_buffer->offset += 4;
-        return true;
-    }
-    /* false */
-    if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
-    {
-        item->type = cJSON_False;
-        input_buffer->offset += 5;
-        return true;
-    }
-    /* true */
-    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
-    {
-        item->type = cJSON_True;
-        item->valueint = 1;
-        input_buffer->offset += 4;
-        return true;
-    }
-    /* string */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
+    return scan_escape_kernel(start, end);
+}
+
+static const unsigned char *scan_whitespace(const unsigned char *start, const unsigned char *end)
+{
+    if (scan_whitespace_kernel == NULL)
     {
-        return parse_string(item, input_buffer);
+        cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
     }
-    /* number */
-    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9'))))
+
+    return scan_whitespace_kernel(start, end);
+}
+
+static cJSON_bool validate_utf8(const unsigned char *start, const unsigned char *end)
+{
+    if (validate_utf8_kernel == NULL)
     {
-        return parse_number(item, input_buffer);
+        cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
     }
-    /* array */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '['))
+
+    return validate_utf8_kernel(start, end);
+}
+
+/* Minify whole blocks, if there is a kernel for the SIMD level. */
+static void compact_whitespace(unsigned char **input, const unsigned char *end, unsigned char **output)
+{
+    if (simd_level < 0)
     {
-        return parse_array(item, input_buffer);
+        cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
     }
-    /* object */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '{'))
+
+    if (compact_whitespace_kernel != NULL)
     {
-        return parse_object(item, input_buffer);
+        compact_whitespace_kernel(input, end, output);
     }
-
-    return false;
 }
 
-/* Render a value to text. */
-static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer)
+/* Parse the input text into an unescaped cinput, and populate item. */
+static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
 {
+    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
+    unsigned char *output_pointer = NULL;
     unsigned char *output = NULL;
 
-    if ((item == NULL) || (output_buffer == NULL))
+    /* not a string */
+    if (buffer_at_offset(input_buffer)[0] != '\"')
     {
-        return false;
+        goto fail;
     }
 
-    switch ((item->type) & 0xFF)
     {
-        case cJSON_NULL:
-            output = ensure(output_buffer, 5);
-            if (output == NULL)
-            {
-                return false;
-            }
-            strcpy((char*)output, "null");
-            return true;
-
-        case cJSON_False:
-            output = ensure(output_buffer, 6);
-            if (output == NULL)
+        /* calculate approximate size of the output (overestimate) */
+        size_t allocation_length = 0;
+        size_t skipped_bytes = 0;
+        const unsigned char *buffer_end = input_buffer->content + input_buffer->length;
+        for (;;)
+        {
+            /* jump over the run without quotes and escapes */
+            input_end = scan_string(input_end, buffer_end);
+            if ((input_end >= buffer_end) || (*input_end == '\"'))
             {
-                return false;
+                break;
             }
-            strcpy((char*)output, "false");
-            return true;
 
-        case cJSON_True:
-            output = ensure(output_buffer, 5);
-            if (output == NULL)
+            /* is escape sequence */
+            if ((input_end + 1) >= buffer_end)
             {
-                return false;
+                /* prevent buffer overflow when last input character is a backslash */
+                goto fail;
             }
-            strcpy((char*)output, "true");
-            return true;
+            skipped_bytes++;
+            input_end += 2;
+        }
+        if ((input_end >= buffer_end) || (*input_end != '\"'))
+        {
+            goto fail; /* string ended unexpectedly */
+        }
 
-        case cJSON_Number:
-            return print_number(item, output_buffer);
+        /* \u escapes are checked while decoding, the rest of the literal here */
+        if (((input_buffer->flags & CJSON_PARSE_STRICT_UTF8) != 0) && !validate_utf8(input_pointer, input_end))
+        {
+            goto fail;
+        }
 
-        case cJSON_Raw:
+        /* in situ the literal is the string, terminated where its closing quote was */
+        if (((input_buffer->flags & CJSON_PARSE_IN_SITU) != 0) && (skipped_bytes == 0))
         {
-            size_t raw_length = 0;
-            if (item->valuestring == NULL)
-            {
-                return false;
-            }
+            output = (unsigned char*)cast_away_const(input_pointer);
+            output[input_end - input_pointer] = '\0';
+            item->type |= cJSON_String | cJSON_IsReference;
+            item->valuestring = (char*)output;
+
+            input_buffer->offset = (size_t) (input_end - input_buffer->content);
+            input_buffer->offset++;
 
-            raw_length = strlen(item->valuestring) + sizeof("");
-            output = ensure(output_buffer, raw_length);
-            if (output == NULL)
-            {
-                return false;
-            }
-            memcpy(output, item->valuestring, raw_length);
             return true;
         }
 
-        case cJSON_String:
-            return print_string(item, output_buffer);
-
-        case cJSON_Array:
-            return print_array(item, output_buffer);
-
-        case cJSON_Object:
-            return print_object(item, output_buffer);
+        /* This is at most how much we need for the output */
+        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
+        if (input_buffer->context != NULL)
+        {
+            output = (unsigned char*)context_allocate(input_buffer->context, &input_buffer->context->strings, allocation_length + sizeof(""));
+        }
+        else
+        {
+            output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+        }
+        if (output == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+        output_pointer = output;
 
-        default:
-            return false;
+        /* without escape sequences the literal is the output */
+        if (skipped_bytes == 0)
+        {
+            memcpy(output_pointer, input_pointer, (size_t)(input_end - input_pointer));
+            output_pointer += input_end - input_pointer;
+            input_pointer = input_end;
+        }
     }
-}
 
-/* Build an array from input text. */
-static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer)
-{
-    cJSON *head = NULL; /* head of the linked list */
-    cJSON *current_item = NULL;
+    /* loop through the string literal */
+    while (input_pointer < input_end)
+    {
+        /* copy the run up to the next escape sequence in one go,
+         * the only quotes before input_end are escaped ones */
+        const unsigned char *run_end = scan_string(input_pointer, input_end);
+        if (run_end != input_pointer)
+        {
+            memcpy(output_pointer, input_pointer, (size_t)(run_end - input_pointer));
+            output_pointer += run_end - input_pointer;
+            input_pointer = run_end;
+        }
+        /* escape sequence */
+        if (input_pointer < input_end)
+        {
+            unsigned char sequence_length = 2;
+            if ((input_end - input_pointer) < 1)
+            {
+                goto fail;
+            }
+
+            switch (input_pointer[1])
+            {
+                case 'b':
+                    *output_pointer++ = '\b';
+                    break;
+                case 'f':
+                    *output_pointer++ = '\f';
+                    break;
+                case 'n':
+                    *output_pointer++ = '\n';
+                    break;
+                case 'r':
+                    *output_pointer++ = '\r';
+                    break;
+                case 't':
+                    *output_pointer++ = '\t';
+                    break;
+                case '\"':
+                case '\\':
+                case '/':
+                    *output_pointer++ = input_pointer[1];
+                    break;
+
+                /* UTF-16 literal */
+                case 'u':
+                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer, (input_buffer->flags & CJSON_PARSE_STRICT_UTF8) != 0);
+                    if (sequence_length == 0)
+                    {
+                        /* failed to convert UTF16-literal to UTF-8 */
+                        goto fail;
+                    }
+                    break;
+
+                default:
+                    goto fail;
+            }
+            input_pointer += sequence_length;
+        }
+    }
+
+    /* zero terminate the output */
+    *output_pointer = '\0';
+
+    /* a string from the arena of a context is not owned by the item, like a reference */
+    item->type |= (input_buffer->context != NULL) ? (cJSON_String | cJSON_IsReference) : cJSON_String;
+    item->valuestring = (char*)output;
+
+    input_buffer->offset = (size_t) (input_end - input_buffer->content);
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if ((output != NULL) && (input_buffer->context == NULL))
+    {
+        input_buffer->hooks.deallocate(output);
+    }
+
+    if (input_pointer != NULL)
+    {
+        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+    }
+
+    return false;
+}
+
+/* Render the cstring provided to an escaped version that can be printed. */
+static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+{
+    const unsigned char *input_pointer = NULL;
+    const unsigned char *input_end = NULL;
+    unsigned char *output = NULL;
+    unsigned char *output_pointer = NULL;
+    size_t input_length = 0;
+    size_t output_length = 0;
+    /* numbers of additional characters needed for escaping */
+    size_t escape_characters = 0;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* empty string */
+    if (input == NULL)
+    {
+        output = ensure(output_buffer, sizeof("\"\""));
+        if (output == NULL)
+        {
+            return false;
+        }
+        strcpy((char*)output, "\"\"");
+
+        return true;
+    }
+
+    /* find the first character that needs to be escaped, most strings have none */
+    input_length = strlen((const char*)input);
+    input_end = input + input_length;
+    input_pointer = scan_escape(input, input_end);
+    if (input_pointer == input_end)
+    {
+        output = ensure(output_buffer, input_length + sizeof("\"\""));
+        if (output == NULL)
+        {
+            return false;
+        }
+        output[0] = '\"';
+        memcpy(output + 1, input, input_length);
+        output[input_length + 1] = '\"';
+        output[input_length + 2] = '\0';
+
+        return true;
+    }
+
+    /* count the additional characters needed for escaping */
+    while (input_pointer < input_end)
+    {
+        switch (*input_pointer)
+        {
+            case '\"':
+            case '\\':
+            case '\b':
+            case '\f':
+            case '\n':
+            case '\r':
+            case '\t':
+                /* one character escape sequence */
+                escape_characters++;
+                break;
+            default:
+                /* UTF-16 escape sequence uXXXX */
+                escape_characters += 5;
+                break;
+        }
+        input_pointer = scan_escape(input_pointer + 1, input_end);
+    }
+    output_length = input_length + escape_characters;
+
+    output = ensure(output_buffer, output_length + sizeof("\"\""));
+    if (output == NULL)
+    {
+        return false;
+    }
+
+    output[0] = '\"';
+    output_pointer = output + 1;
+    /* copy the runs between escapes as a whole */
+    for (input_pointer = input; input_pointer < input_end; input_pointer++)
+    {
+        const unsigned char *run_end = scan_escape(input_pointer, input_end);
+        memcpy(output_pointer, input_pointer, (size_t)(run_end - input_pointer));
+        output_pointer += run_end - input_pointer;
+        input_pointer = run_end;
+        if (input_pointer == input_end)
+        {
+            break;
+        }
+
+        /* character needs to be escaped */
+        *output_pointer++ = '\\';
+        switch (*input_pointer)
+        {
+            case '\\':
+                *output_pointer++ = '\\';
+                break;
+            case '\"':
+                *output_pointer++ = '\"';
+                break;
+            case '\b':
+                *output_pointer++ = 'b';
+                break;
+            case '\f':
+                *output_pointer++ = 'f';
+                break;
+            case '\n':
+                *output_pointer++ = 'n';
+                break;
+            case '\r':
+                *output_pointer++ = 'r';
+                break;
+            case '\t':
+                *output_pointer++ = 't';
+                break;
+            default:
+                /* escape and print as unicode codepoint */
+                output_pointer[0] = 'u';
+                output_pointer[1] = '0';
+                output_pointer[2] = '0';
+                output_pointer[3] = (unsigned char)('0' + (*input_pointer >> 4));
+                output_pointer[4] = (unsigned char)"0123456789abcdef"[*input_pointer & 0x0F];
+                output_pointer += 5;
+                break;
+        }
+    }
+    output[output_length + 1] = '\"';
+    output[output_length + 2] = '\0';
+
+    return true;
+}
+
+/* Invoke print_string_ptr (which is useful) on an item. */
+static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
+{
+    return print_string_ptr((unsigned char*)item->valuestring, p);
+}
+
+/* Predeclare these prototypes. */
+static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool pack_numbers(cJSON * const array, const double * const numbers, size_t count);
+static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
+
+/* Utility to jump whitespace and cr/lf */
+static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL))
+    {
+        return NULL;
+    }
+
+    if (cannot_access_at_index(buffer, 0))
+    {
+        return buffer;
+    }
+
+    /* most runs are short, don't start a scan for none at all */
+    if (buffer_at_offset(buffer)[0] <= 32)
+    {
+        buffer->offset = (size_t)(scan_whitespace(buffer_at_offset(buffer), buffer->content + buffer->length) - buffer->content);
+    }
+
+    if (buffer->offset == buffer->length)
+    {
+        buffer->offset--;
+    }
+
+    return buffer;
+}
+
+/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
+static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
+    {
+        return NULL;
+    }
+
+    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+    {
+        buffer->offset += 3;
+    }
+
+    return buffer;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    size_t buffer_length;
+
+    if (NULL == value)
+    {
+        return NULL;
+    }
+
+    /* Adding null character size due to require_null_terminated. */
+    buffer_length = strlen(value) + sizeof("");
+
+    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
+}
+
+/* Parse an object - create a new root, and populate. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    return cJSON_ParseWithFlags(value, buffer_length, return_parse_end, require_null_terminated ? CJSON_PARSE_REQUIRE_NULL_TERMINATED : 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithFlags(const char *value, size_t buffer_length, const char **return_parse_end, int flags)
+{
+    return cJSON_ParseWithContext(NULL, value, buffer_length, return_parse_end, flags);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithContext(cJSON_Context *context, const char *value, size_t buffer_length, const char **return_parse_end, int flags)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, 0, NULL };
+    cJSON *item = NULL;
+
+    /* reset error position */
+    global_error.json = NULL;
+    global_error.position = 0;
+
+    if (value == NULL || 0 == buffer_length)
+    {
+        goto fail;
+    }
+
+    buffer.content = (const unsigned char*)value;
+    buffer.length = buffer_length;
+    buffer.offset = 0;
+    buffer.hooks = global_hooks;
+    buffer.flags = flags;
+    buffer.context = context;
+
+    item = parse_new_item(&buffer);
+    if (item == NULL) /* memory fail */
+    {
+        goto fail;
+    }
+
+    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    {
+        /* parse failure. ep is set. */
+        goto fail;
+    }
+
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if ((flags & CJSON_PARSE_REQUIRE_NULL_TERMINATED) != 0)
+    {
+        buffer_skip_whitespace(&buffer);
+        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        {
+            goto fail;
+        }
+    }
+    if (return_parse_end)
+    {
+        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+    }
+
+    return item;
+
+fail:
+    if (item != NULL)
+    {
+        cJSON_Delete(item);
+    }
+
+    if (value != NULL)
+    {
+        error local_error;
+        local_error.json = (const unsigned char*)value;
+        local_error.position = 0;
+
+        if (buffer.offset < buffer.length)
+        {
+            local_error.position = buffer.offset;
+        }
+        else if (buffer.length > 0)
+        {
+            local_error.position = buffer.length - 1;
+        }
+
+        if (return_parse_end != NULL)
+        {
+            *return_parse_end = (const char*)local_error.json + local_error.position;
+        }
+
+        global_error = local_error;
+    }
+
+    return NULL;
+}
+
+/* Default options for cJSON_Parse */
+CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+{
+    return cJSON_ParseWithOpts(value, 0, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+{
+    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+}
+
+#define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
+
+/* buffer size of cJSON_PrintToFile and cJSON_PrintToFd, the text is written whenever it fills up */
+static const size_t print_chunk_size = 64 * 1024;
+
+static unsigned char *print(const cJSON * const item, cJSON_bool format, const internal_hooks * const hooks)
+{
+    static const size_t default_buffer_size = 256;
+    printbuffer buffer[1];
+    unsigned char *printed = NULL;
+
+    memset(buffer, 0, sizeof(buffer));
+
+    /* create buffer */
+    buffer->buffer = (unsigned char*) hooks->allocate(default_buffer_size);
+    buffer->length = default_buffer_size;
+    buffer->format = format;
+    buffer->hooks = *hooks;
+    if (buffer->buffer == NULL)
+    {
+        goto fail;
+    }
+
+    /* print the value */
+    if (!print_value(item, buffer))
+    {
+        goto fail;
+    }
+    update_offset(buffer);
+
+    /* check if reallocate is available */
+    if (hooks->reallocate != NULL)
+    {
+        printed = (unsigned char*) hooks->reallocate(buffer->buffer, buffer->offset + 1);
+        if (printed == NULL) {
+            goto fail;
+        }
+        buffer->buffer = NULL;
+    }
+    else /* otherwise copy the JSON over to a new buffer */
+    {
+        printed = (unsigned char*) hooks->allocate(buffer->offset + 1);
+        if (printed == NULL)
+        {
+            goto fail;
+        }
+        memcpy(printed, buffer->buffer, cjson_min(buffer->length, buffer->offset + 1));
+        printed[buffer->offset] = '\0'; /* just to be sure */
+
+        /* free the buffer */
+        hooks->deallocate(buffer->buffer);
+    }
+
+    return printed;
+
+fail:
+    if (buffer->buffer != NULL)
+    {
+        hooks->deallocate(buffer->buffer);
+    }
+
+    if (printed != NULL)
+    {
+        hooks->deallocate(printed);
+    }
+
+    return NULL;
+}
+
+/* Render a cJSON item/entity/structure to text. */
+CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item)
+{
+    return (char*)print(item, true, &global_hooks);
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item)
+{
+    return (char*)print(item, false, &global_hooks);
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
+
+    if (prebuffer < 0)
+    {
+        return NULL;
+    }
+
+    p.buffer = (unsigned char*)global_hooks.allocate((size_t)prebuffer);
+    if (!p.buffer)
+    {
+        return NULL;
+    }
+
+    p.length = (size_t)prebuffer;
+    p.offset = 0;
+    p.noalloc = false;
+    p.format = fmt;
+    p.hooks = global_hooks;
+
+    if (!print_value(item, &p))
+    {
+        global_hooks.deallocate(p.buffer);
+        return NULL;
+    }
+
+    return (char*)p.buffer;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
+
+    if ((length < 0) || (buffer == NULL))
+    {
+        return false;
+    }
+
+    p.buffer = (unsigned char*)buffer;
+    p.length = (size_t)length;
+    p.offset = 0;
+    p.noalloc = true;
+    p.format = format;
+    p.hooks = global_hooks;
+
+    return print_value(item, &p);
+}
+
+static cJSON_bool print_streamed(const cJSON * const item, cJSON_bool format, size_t chunk_size, cJSON_WriteFunction write, void *target, const internal_hooks * const hooks)
+{
+    printbuffer buffer[1];
+    cJSON_bool success = false;
+
+    if ((item == NULL) || (write == NULL) || (chunk_size < 2))
+    {
+        return false;
+    }
+
+    memset(buffer, 0, sizeof(buffer));
+
+    buffer->buffer = (unsigned char*) hooks->allocate(chunk_size);
+    buffer->length = chunk_size;
+    buffer->format = format;
+    buffer->hooks = *hooks;
+    buffer->flush = write;
+    buffer->target = target;
+    if (buffer->buffer == NULL)
+    {
+        return false;
+    }
+
+    if (print_value(item, buffer))
+    {
+        /* write what is left in the buffer */
+        update_offset(buffer);
+        success = (buffer->offset == 0) || write(target, (const char*)buffer->buffer, buffer->offset);
+    }
+
+    /* ensure frees the buffer itself when growing it fails */
+    if (buffer->buffer != NULL)
+    {
+        hooks->deallocate(buffer->buffer);
+    }
+
+    return success;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintStreamed(const cJSON *item, cJSON_bool format, size_t chunk_size, cJSON_WriteFunction write, void *target)
+{
+    return print_streamed(item, format, chunk_size, write, target, &global_hooks);
+}
+
+static cJSON_bool write_to_file(void *target, const char *text, size_t length)
+{
+    return fwrite(text, 1, length, (FILE*)target) == length;
+}
+
+static cJSON_bool write_to_fd(void *target, const char *text, size_t length)
+{
+    const int fd = *(const int*)target;
+
+    /* write may take less than it was given */
+    while (length > 0)
+    {
+#if defined(_WIN32)
+        int written = _write(fd, text, (unsigned int)cjson_min(length, (size_t)INT_MAX));
+#else
+        ssize_t written = write(fd, text, length);
+#endif
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        text += written;
+        length -= (size_t)written;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToFile(const cJSON *item, FILE *file, cJSON_bool format)
+{
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    return print_streamed(item, format, print_chunk_size, write_to_file, file, &global_hooks);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToFd(const cJSON *item, int fd, cJSON_bool format)
+{
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    return print_streamed(item, format, print_chunk_size, write_to_fd, &fd, &global_hooks);
+}
+
+/* Parser core - when encountering text, process appropriately. */
+static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
+{
+    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    {
+        return false; /* no input */
+    }
+
+    /* parse the different types of values */
+    /* null */
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
+    {
+        item->type |= cJSON_NULL;
+        input_buffer->offset += 4;
+        return true;
+    }
+    /* false */
+    if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
+    {
+        item->type |= cJSON_False;
+        input_buffer->offset += 5;
+        return true;
+    }
+    /* true */
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
+    {
+        item->type |= cJSON_True;
+        item->valueint = 1;
+        input_buffer->offset += 4;
+        return true;
+    }
+    /* string */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
+    {
+        return parse_string(item, input_buffer);
+    }
+    /* number */
+    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9'))))
+    {
+        return parse_number(item, input_buffer);
+    }
+    /* array */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '['))
+    {
+        return parse_array(item, input_buffer);
+    }
+    /* object */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '{'))
+    {
+        return parse_object(item, input_buffer);
+    }
+
+    return false;
+}
+
+/* Render a value to text. */
+static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output = NULL;
+
+    if ((item == NULL) || (output_buffer == NULL))
+    {
+        return false;
+    }
+
+    switch ((item->type) & 0xFF)
+    {
+        case cJSON_NULL:
+            output = ensure(output_buffer, 5);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "null");
+            return true;
+
+        case cJSON_False:
+            output = ensure(output_buffer, 6);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "false");
+            return true;
+
+        case cJSON_True:
+            output = ensure(output_buffer, 5);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "true");
+            return true;
+
+        case cJSON_Number:
+            return print_number(item, output_buffer);
+
+        case cJSON_Raw:
+        {
+            size_t raw_length = 0;
+            if (item->valuestring == NULL)
+            {
+                return false;
+            }
+
+            raw_length = strlen(item->valuestring) + sizeof("");
+            output = ensure(output_buffer, raw_length);
+            if (output == NULL)
+            {
+                return false;
+            }
+            memcpy(output, item->valuestring, raw_length);
+            return true;
+        }
+
+        case cJSON_String:
+            return print_string(item, output_buffer);
+
+        case cJSON_Array:
+            return print_array(item, output_buffer);
+
+        case cJSON_Object:
+            return print_object(item, output_buffer);
+
+        default:
+            return false;
+    }
+}
+
+/* With CJSON_PARSE_PACK_NUMBERS: parse an array of nothing but numbers into a packed
+ * array. Returns false and leaves the offset at the '[' for anything else, including
+ * errors, which the plain parse then finds and reports. */
+static cJSON_bool parse_packed_array(cJSON * const item, parse_buffer * const input_buffer)
+{
+    size_t start = input_buffer->offset;
+    double *numbers = NULL;
+    double *bigger = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    cJSON number;
+    unsigned char c = 0;
+
+    input_buffer->offset++;
+    for (;;)
+    {
+        buffer_skip_whitespace(input_buffer);
+        if (cannot_access_at_index(input_buffer, 0))
+        {
+            goto not_packed;
+        }
+        c = buffer_at_offset(input_buffer)[0];
+        if ((c != '-') && ((c < '0') || (c > '9')))
+        {
+            goto not_packed;
+        }
+
+        memset(&number, '\0', sizeof(number));
+        if (!parse_number(&number, input_buffer))
+        {
+            goto not_packed;
+        }
+        if (count == capacity)
+        {
+            capacity = (capacity == 0) ? 16 : (capacity * 2);
+            bigger = (double*)input_buffer->hooks.allocate(capacity * sizeof(double));
+            if (bigger == NULL)
+            {
+                goto not_packed;
+            }
+            if (numbers != NULL)
+            {
+                memcpy(bigger, numbers, count * sizeof(double));
+                input_buffer->hooks.deallocate(numbers);
+            }
+            numbers = bigger;
+        }
+        numbers[count++] = number.valuedouble;
+
+        buffer_skip_whitespace(input_buffer);
+        if (cannot_access_at_index(input_buffer, 0))
+        {
+            goto not_packed;
+        }
+        c = buffer_at_offset(input_buffer)[0];
+        input_buffer->offset++;
+        if (c == ']')
+        {
+            break;
+        }
+        if (c != ',')
+        {
+            goto not_packed;
+        }
+    }
+
+    if (!pack_numbers(item, numbers, count))
+    {
+        goto not_packed;
+    }
+    input_buffer->hooks.deallocate(numbers);
+
+    return true;
+
+not_packed:
+    if (numbers != NULL)
+    {
+        input_buffer->hooks.deallocate(numbers);
+    }
+    input_buffer->offset = start;
+
+    return false;
+}
+
+/* Build an array from input text. */
+static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer)
+{
+    cJSON *head = NULL; /* head of the linked list */
+    cJSON *current_item = NULL;
+
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    {
+        return false; /* to deeply nested */
+    }
+    input_buffer->depth++;
+
+    if (buffer_at_offset(input_buffer)[0] != '[')
+    {
+        /* not an array */
+        goto fail;
+    }
+
+    if ((input_buffer->flags & CJSON_PARSE_PACK_NUMBERS) && parse_packed_array(item, input_buffer))
+    {
+        input_buffer->depth--;
+        return true;
+    }
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ']'))
+    {
+        /* empty array */
+        goto success;
+    }
+
+    /* check if we skipped to the end of the buffer */
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        input_buffer->offset--;
+        goto fail;
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    /* loop through the comma separated array elements */
+    do
+    {
+        /* allocate next item */
+        cJSON *new_item = parse_new_item(input_buffer);
+        if (new_item == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+
+        /* attach next item to list */
+        if (head == NULL)
+        {
+            /* start the linked list */
+            current_item = head = new_item;
+        }
+        else
+        {
+            /* add to the end and advance */
+            current_item->next = new_item;
+            new_item->prev = current_item;
+            current_item = new_item;
+        }
+
+        /* parse next value */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_value(current_item, input_buffer))
+        {
+            goto fail; /* failed to parse value */
+        }
+        buffer_skip_whitespace(input_buffer);
+    }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+
+    if (cannot_access_at_index(input_buffer, 0) || buffer_at_offset(input_buffer)[0] != ']')
+    {
+        goto fail; /* expected end of array */
+    }
+
+success:
+    input_buffer->depth--;
+
+    if (head != NULL) {
+        head->prev = current_item;
+    }
+
+    item->type |= cJSON_Array;
+    item->child = head;
+
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if (head != NULL)
+    {
+        cJSON_Delete(head);
+    }
+
+    return false;
+}
+
+/* Render the numbers of a packed array like the items of a plain one */
+static cJSON_bool print_packed_array(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    size_t length = (size_t) (output_buffer->format ? 2 : 1);
+    const struct cJSON_Index *block = item->index;
+    cJSON number;
+    size_t i = 0;
+
+    output_pointer = ensure(output_buffer, 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    *output_pointer = '[';
+    output_buffer->offset++;
+
+    memset(&number, '\0', sizeof(number));
+    number.type = cJSON_Number;
+    for (i = 0; i < block->count; i++)
+    {
+        cJSON_SetNumberHelper(&number, block->table.numbers[i]);
+        if (!print_number(&number, output_buffer))
+        {
+            return false;
+        }
+        update_offset(output_buffer);
+        if ((i + 1) < block->count)
+        {
+            output_pointer = ensure(output_buffer, length + 1);
+            if (output_pointer == NULL)
+            {
+                return false;
+            }
+            *output_pointer++ = ',';
+            if (output_buffer->format)
+            {
+                *output_pointer++ = ' ';
+            }
+            *output_pointer = '\0';
+            output_buffer->offset += length;
+        }
+    }
+
+    output_pointer = ensure(output_buffer, 2);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    *output_pointer++ = ']';
+    *output_pointer = '\0';
+
+    return true;
+}
+
+/* Render an array to text */
+static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    size_t length = 0;
+    cJSON *current_element = item->child;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    if (item->type & cJSON_IsPacked)
+    {
+        return print_packed_array(item, output_buffer);
+    }
+
+    /* Compose the output array. */
+    /* opening square bracket */
+    output_pointer = ensure(output_buffer, 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    *output_pointer = '[';
+    output_buffer->offset++;
+    output_buffer->depth++;
+
+    while (current_element != NULL)
+    {
+        if (!print_value(current_element, output_buffer))
+        {
+            return false;
+        }
+        update_offset(output_buffer);
+        if (current_element->next)
+        {
+            length = (size_t) (output_buffer->format ? 2 : 1);
+            output_pointer = ensure(output_buffer, length + 1);
+            if (output_pointer == NULL)
+            {
+                return false;
+            }
+            *output_pointer++ = ',';
+            if(output_buffer->format)
+            {
+                *output_pointer++ = ' ';
+            }
+            *output_pointer = '\0';
+            output_buffer->offset += length;
+        }
+        current_element = current_element->next;
+    }
+
+    output_pointer = ensure(output_buffer, 2);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    *output_pointer++ = ']';
+    *output_pointer = '\0';
+    output_buffer->depth--;
+
+    return true;
+}
+
+/* Build an object from the text. */
+static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer)
+{
+    cJSON *head = NULL; /* linked list head */
+    cJSON *current_item = NULL;
+
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    {
+        return false; /* to deeply nested */
+    }
+    input_buffer->depth++;
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '{'))
+    {
+        goto fail; /* not an object */
+    }
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '}'))
+    {
+        goto success; /* empty object */
+    }
+
+    /* check if we skipped to the end of the buffer */
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        input_buffer->offset--;
+        goto fail;
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    /* loop through the comma separated array elements */
+    do
+    {
+        /* allocate next item */
+        cJSON *new_item = parse_new_item(input_buffer);
+        if (new_item == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+
+        /* attach next item to list */
+        if (head == NULL)
+        {
+            /* start the linked list */
+            current_item = head = new_item;
+        }
+        else
+        {
+            /* add to the end and advance */
+            current_item->next = new_item;
+            new_item->prev = current_item;
+            current_item = new_item;
+        }
+
+        /* parse the name of the child */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_string(current_item, input_buffer))
+        {
+            goto fail; /* failed to parse name */
+        }
+        buffer_skip_whitespace(input_buffer);
+
+        /* swap valuestring and string, because we parsed the name,
+         * a name in a context or in the input is not owned by the item, like a constant one */
+        current_item->string = current_item->valuestring;
+        current_item->valuestring = NULL;
+        current_item->type = (current_item->type & cJSON_IsPooled) | ((current_item->type & cJSON_IsReference) ? cJSON_StringIsConst : cJSON_Invalid);
+
+        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+        {
+            goto fail; /* invalid object */
+        }
+
+        /* parse the value */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_value(current_item, input_buffer))
+        {
+            goto fail; /* failed to parse value */
+        }
+        buffer_skip_whitespace(input_buffer);
+    }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '}'))
+    {
+        goto fail; /* expected end of object */
+    }
+
+success:
+    input_buffer->depth--;
+
+    if (head != NULL) {
+        head->prev = current_item;
+    }
+
+    item->type |= cJSON_Object;
+    item->child = head;
+
+    input_buffer->offset++;
+    return true;
+
+fail:
+    if (head != NULL)
+    {
+        cJSON_Delete(head);
+    }
+
+    return false;
+}
+
+/* Render an object to text. */
+static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    size_t length = 0;
+    cJSON *current_item = item->child;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* Compose the output: */
+    length = (size_t) (output_buffer->format ? 2 : 1); /* fmt: {\n */
+    output_pointer = ensure(output_buffer, length + 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    *output_pointer++ = '{';
+    output_buffer->depth++;
+    if (output_buffer->format)
+    {
+        *output_pointer++ = '\n';
+    }
+    output_buffer->offset += length;
+
+    while (current_item)
+    {
+        if (output_buffer->format)
+        {
+            size_t i;
+            output_pointer = ensure(output_buffer, output_buffer->depth);
+            if (output_pointer == NULL)
+            {
+                return false;
+            }
+            for (i = 0; i < output_buffer->depth; i++)
+            {
+                *output_pointer++ = '\t';
+            }
+            output_buffer->offset += output_buffer->depth;
+        }
+
+        /* print key */
+        if (!print_string_ptr((unsigned char*)current_item->string, output_buffer))
+        {
+            return false;
+        }
+        update_offset(output_buffer);
+
+        length = (size_t) (output_buffer->format ? 2 : 1);
+        output_pointer = ensure(output_buffer, length);
+        if (output_pointer == NULL)
+        {
+            return false;
+        }
+        *output_pointer++ = ':';
+        if (output_buffer->format)
+        {
+            *output_pointer++ = '\t';
+        }
+        output_buffer->offset += length;
+
+        /* print value */
+        if (!print_value(current_item, output_buffer))
+        {
+            return false;
+        }
+        update_offset(output_buffer);
+
+        /* print comma if not last */
+        length = ((size_t)(output_buffer->format ? 1 : 0) + (size_t)(current_item->next ? 1 : 0));
+        output_pointer = ensure(output_buffer, length + 1);
+        if (output_pointer == NULL)
+        {
+            return false;
+        }
+        if (current_item->next)
+        {
+            *output_pointer++ = ',';
+        }
+
+        if (output_buffer->format)
+        {
+            *output_pointer++ = '\n';
+        }
+        *output_pointer = '\0';
+        output_buffer->offset += length;
+
+        current_item = current_item->next;
+    }
+
+    output_pointer = ensure(output_buffer, output_buffer->format ? (output_buffer->depth + 1) : 2);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    if (output_buffer->format)
+    {
+        size_t i;
+        for (i = 0; i < (output_buffer->depth - 1); i++)
+        {
+            *output_pointer++ = '\t';
+        }
+    }
+    *output_pointer++ = '}';
+    *output_pointer = '\0';
+    output_buffer->depth--;
+
+    return true;
+}
+
+/* Get Array size/item / object item. */
+/* Lookup indexes, built by the lookups and kept up to date or dropped when the members
+ * change. Objects with more members than object_index_threshold get a hash table of
+ * their members, arrays with more items than array_index_threshold a vector of their
+ * items. 0 turns either off. */
+static size_t object_index_threshold = 0;
+static size_t array_index_threshold = 0;
+
+CJSON_PUBLIC(void) cJSON_SetObjectIndexThreshold(int members)
+{
+    object_index_threshold = (members > 0) ? (size_t)members : 0;
+}
+
+CJSON_PUBLIC(void) cJSON_SetArrayIndexThreshold(int items)
+{
+    array_index_threshold = (items > 0) ? (size_t)items : 0;
+}
 
-    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+/* FNV-1a of the name with tolower applied to every byte. Names that only differ in case
+ * get the same hash, so one index serves the case sensitive and insensitive lookups. */
+static size_t object_index_hash(const unsigned char *name)
+{
+    size_t hash = 2166136261U;
+    for (; *name != '\0'; name++)
     {
-        return false; /* to deeply nested */
+        hash = (hash ^ (size_t)tolower(*name)) * 16777619U;
     }
-    input_buffer->depth++;
 
-    if (buffer_at_offset(input_buffer)[0] != '[')
-    {
-        /* not an array */
-        goto fail;
-    }
+    return hash;
+}
 
-    input_buffer->offset++;
-    buffer_skip_whitespace(input_buffer);
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ']'))
-    {
-        /* empty array */
-        goto success;
-    }
+/* Linear probing. Members are inserted in list order, so among equal hashes the probe
+ * meets them in list order too and finds the same member as the linear scan. */
+static void object_index_insert(struct cJSON_Index * const index, cJSON * const member)
+{
+    size_t hash = object_index_hash((const unsigned char*)member->string);
+    size_t slot = hash & index->mask;
 
-    /* check if we skipped to the end of the buffer */
-    if (cannot_access_at_index(input_buffer, 0))
+    while (index->table.entries[slot].item != NULL)
     {
-        input_buffer->offset--;
-        goto fail;
+        slot = (slot + 1) & index->mask;
     }
+    index->table.entries[slot].hash = hash;
+    index->table.entries[slot].item = member;
+    index->count++;
+}
 
-    /* step back to character in front of the first element */
-    input_buffer->offset--;
-    /* loop through the comma separated array elements */
-    do
-    {
-        /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
-        if (new_item == NULL)
-        {
-            goto fail; /* allocation failure */
-        }
+static cJSON *object_index_find(const struct cJSON_Index * const index, const char * const name, const cJSON_bool case_sensitive)
+{
+    size_t hash = object_index_hash((const unsigned char*)name);
+    size_t slot = hash & index->mask;
+    cJSON *member = NULL;
 
-        /* attach next item to list */
-        if (head == NULL)
+    for (; index->table.entries[slot].item != NULL; slot = (slot + 1) & index->mask)
+    {
+        if (index->table.entries[slot].hash != hash)
         {
-            /* start the linked list */
-            current_item = head = new_item;
+            continue;
         }
-        else
+        member = index->table.entries[slot].item;
+        if (case_sensitive ? (strcmp(name, member->string) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)member->string) == 0))
         {
-            /* add to the end and advance */
-            current_item->next = new_item;
-            new_item->prev = current_item;
-            current_item = new_item;
+            return member;
         }
+    }
 
-        /* parse next value */
-        input_buffer->offset++;
-        buffer_skip_whitespace(input_buffer);
-        if (!parse_value(current_item, input_buffer))
+    return NULL;
+}
+
+/* Take member out and shift the rest of its cluster back into the hole, as far as their
+ * home slots allow. That keeps the order of equal hashes. */
+static void object_index_remove(struct cJSON_Index * const index, const cJSON * const member)
+{
+    index_entry *entries = index->table.entries;
+    size_t slot = object_index_hash((const unsigned char*)member->string) & index->mask;
+    size_t next = 0;
+    size_t home = 0;
+
+    while (entries[slot].item != member)
+    {
+        if (entries[slot].item == NULL)
         {
-            goto fail; /* failed to parse value */
+            return;
         }
-        buffer_skip_whitespace(input_buffer);
+        slot = (slot + 1) & index->mask;
     }
-    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
 
-    if (cannot_access_at_index(input_buffer, 0) || buffer_at_offset(input_buffer)[0] != ']')
+    for (next = (slot + 1) & index->mask; entries[next].item != NULL; next = (next + 1) & index->mask)
     {
-        goto fail; /* expected end of array */
-    }
-
-success:
-    input_buffer->depth--;
-
-    if (head != NULL) {
-        head->prev = current_item;
+        home = entries[next].hash & index->mask;
+        /* the hole lies between the entry's home slot and the entry */
+        if (((next - home) & index->mask) >= ((next - slot) & index->mask))
+        {
+            entries[slot] = entries[next];
+            slot = next;
+        }
     }
+    entries[slot].item = NULL;
+    index->count--;
+}
 
-    item->type = cJSON_Array;
-    item->child = head;
-
-    input_buffer->offset++;
-
-    return true;
-
-fail:
-    if (head != NULL)
+/* Slots for count entries: a power of two, at least twice count so that hash tables stay
+ * at most half full and vectors have room to grow */
+static size_t index_slots(size_t count)
+{
+    size_t slots = 4;
+    while (slots < (count * 2))
     {
-        cJSON_Delete(head);
+        slots *= 2;
     }
 
-    return false;
+    return slots;
 }
 
-/* Render an array to text */
-static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer)
+/* An empty index with slots entries of entry_size bytes. Pooled containers take the
+ * memory from their context, which frees it with the nodes. */
+static struct cJSON_Index *index_allocate(const cJSON * const container, size_t slots, size_t entry_size)
 {
-    unsigned char *output_pointer = NULL;
-    size_t length = 0;
-    cJSON *current_element = item->child;
+    struct cJSON_Index *index = NULL;
+    cJSON_Context *context = NULL;
+    size_t size = offsetof(struct cJSON_Index, table) + (slots * entry_size);
 
-    if (output_buffer == NULL)
+    if (container->type & cJSON_IsPooled)
     {
-        return false;
+        if (container->index == NULL)
+        {
+            return NULL;
+        }
+        context = container->index->context;
+        /* keep the node pool aligned for the nodes that follow */
+        size = ((size + sizeof(cJSON) - 1) / sizeof(cJSON)) * sizeof(cJSON);
+        index = (struct cJSON_Index*)context_allocate(context, &context->nodes, size);
     }
-
-    /* Compose the output array. */
-    /* opening square bracket */
-    output_pointer = ensure(output_buffer, 1);
-    if (output_pointer == NULL)
+    else
     {
-        return false;
+        index = (struct cJSON_Index*)global_hooks.allocate(size);
+    }
+    if (index == NULL)
+    {
+        return NULL;
     }
 
-    *output_pointer = '[';
-    output_buffer->offset++;
-    output_buffer->depth++;
+    index->context = context;
+    index->mask = slots - 1;
+    index->count = 0;
+    memset(&index->table, '\0', slots * entry_size);
 
-    while (current_element != NULL)
+    return index;
+}
+
+/* Index the members of object, NULL when it has too few of them or memory runs out */
+static struct cJSON_Index *object_index_build(cJSON * const object)
+{
+    struct cJSON_Index *index = NULL;
+    cJSON *member = NULL;
+    size_t count = 0;
+
+    for (member = object->child; member != NULL; member = member->next)
     {
-        if (!print_value(current_element, output_buffer))
-        {
-            return false;
-        }
-        update_offset(output_buffer);
-        if (current_element->next)
+        /* the case sensitive scan stops at a member without a name, leave such objects to it */
+        if (member->string == NULL)
         {
-            length = (size_t) (output_buffer->format ? 2 : 1);
-            output_pointer = ensure(output_buffer, length + 1);
-            if (output_pointer == NULL)
-            {
-                return false;
-            }
-            *output_pointer++ = ',';
-            if(output_buffer->format)
-            {
-                *output_pointer++ = ' ';
-            }
-            *output_pointer = '\0';
-            output_buffer->offset += length;
+            return NULL;
         }
-        current_element = current_element->next;
+        count++;
+    }
+    if (count <= object_index_threshold)
+    {
+        return NULL;
     }
 
-    output_pointer = ensure(output_buffer, 2);
-    if (output_pointer == NULL)
+    index = index_allocate(object, index_slots(count), sizeof(index_entry));
+    if (index == NULL)
     {
-        return false;
+        return NULL;
     }
-    *output_pointer++ = ']';
-    *output_pointer = '\0';
-    output_buffer->depth--;
+    for (member = object->child; member != NULL; member = member->next)
+    {
+        object_index_insert(index, member);
+    }
+    object->index = index;
 
-    return true;
+    return index;
 }
 
-/* Build an object from the text. */
-static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer)
+/* Index the items of array, NULL when it has too few of them or memory runs out */
+static struct cJSON_Index *array_index_build(cJSON * const array)
 {
-    cJSON *head = NULL; /* linked list head */
-    cJSON *current_item = NULL;
+    struct cJSON_Index *index = NULL;
+    cJSON *item = NULL;
+    size_t count = 0;
 
-    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    for (item = array->child; item != NULL; item = item->next)
     {
-        return false; /* to deeply nested */
+        count++;
     }
-    input_buffer->depth++;
-
-    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '{'))
+    if (count <= array_index_threshold)
     {
-        goto fail; /* not an object */
+        return NULL;
     }
 
-    input_buffer->offset++;
-    buffer_skip_whitespace(input_buffer);
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '}'))
+    index = index_allocate(array, index_slots(count), sizeof(cJSON*));
+    if (index == NULL)
     {
-        goto success; /* empty object */
+        return NULL;
     }
-
-    /* check if we skipped to the end of the buffer */
-    if (cannot_access_at_index(input_buffer, 0))
+    for (item = array->child; item != NULL; item = item->next)
     {
-        input_buffer->offset--;
-        goto fail;
+        index->table.items[index->count++] = item;
     }
+    array->index = index;
 
-    /* step back to character in front of the first element */
-    input_buffer->offset--;
-    /* loop through the comma separated array elements */
-    do
-    {
-        /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
-        if (new_item == NULL)
-        {
-            goto fail; /* allocation failure */
-        }
+    return index;
+}
 
-        /* attach next item to list */
-        if (head == NULL)
-        {
-            /* start the linked list */
-            current_item = head = new_item;
-        }
-        else
-        {
-            /* add to the end and advance */
-            current_item->next = new_item;
-            new_item->prev = current_item;
-            current_item = new_item;
-        }
+/* The index of container if it has one, packed arrays keep their numbers there instead */
+static struct cJSON_Index *built_index(const cJSON * const container)
+{
+    struct cJSON_Index *index = container->index;
 
-        /* parse the name of the child */
-        input_buffer->offset++;
-        buffer_skip_whitespace(input_buffer);
-        if (!parse_string(current_item, input_buffer))
-        {
-            goto fail; /* failed to parse name */
-        }
-        buffer_skip_whitespace(input_buffer);
+    if ((index == NULL) || (index->mask == 0) || (container->type & cJSON_IsPacked))
+    {
+        return NULL;
+    }
 
-        /* swap valuestring and string, because we parsed the name */
-        current_item->string = current_item->valuestring;
-        current_item->valuestring = NULL;
+    return index;
+}
 
-        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
-        {
-            goto fail; /* invalid object */
-        }
+/* The index of container, built now if build is set and the container is big enough.
+ * NULL means walk the list. */
+static struct cJSON_Index *container_index(const cJSON * const container, const cJSON_bool build)
+{
+    struct cJSON_Index *index = NULL;
 
-        /* parse the value */
-        input_buffer->offset++;
-        buffer_skip_whitespace(input_buffer);
-        if (!parse_value(current_item, input_buffer))
-        {
-            goto fail; /* failed to parse value */
-        }
-        buffer_skip_whitespace(input_buffer);
+    /* references share their members with another container, which may change them behind their back */
+    if (container->type & (cJSON_IsReference | cJSON_IsPacked))
+    {
+        return NULL;
+    }
+    index = built_index(container);
+    if ((index != NULL) || !build)
+    {
+        return index;
     }
-    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
 
-    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '}'))
+    switch (container->type & 0xFF)
     {
-        goto fail; /* expected end of object */
+        case cJSON_Object:
+            return (object_index_threshold > 0) ? object_index_build((cJSON*)cast_away_const(container)) : NULL;
+        case cJSON_Array:
+            return (array_index_threshold > 0) ? array_index_build((cJSON*)cast_away_const(container)) : NULL;
+        default:
+            return NULL;
     }
+}
 
-success:
-    input_buffer->depth--;
+/* Forget the index of a container whose members changed, the next lookup builds it again */
+static void index_drop(cJSON * const container)
+{
+    struct cJSON_Index *index = built_index(container);
 
-    if (head != NULL) {
-        head->prev = current_item;
+    if (index == NULL)
+    {
+        return;
+    }
+    if (index->context == NULL)
+    {
+        global_hooks.deallocate(index);
+        container->index = NULL;
+    }
+    else
+    {
+        /* the memory goes with the context */
+        container->index = &index->context->index_stub;
     }
+}
 
-    item->type = cJSON_Object;
-    item->child = head;
+/* Keep the index of a container up to date when item is appended to it */
+static void index_append(cJSON * const container, cJSON * const item)
+{
+    struct cJSON_Index *index = built_index(container);
 
-    input_buffer->offset++;
-    return true;
+    if (index == NULL)
+    {
+        return;
+    }
 
-fail:
-    if (head != NULL)
+    if ((container->type & 0xFF) == cJSON_Array)
+    {
+        if (index->count > index->mask)
+        {
+            index_drop(container);
+            return;
+        }
+        index->table.items[index->count++] = item;
+    }
+    else
     {
-        cJSON_Delete(head);
+        if ((item->string == NULL) || (((index->count + 1) * 2) > (index->mask + 1)))
+        {
+            index_drop(container);
+            return;
+        }
+        object_index_insert(index, item);
     }
-
-    return false;
 }
 
-/* Render an object to text. */
-static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer)
+/* Keep the index of a container up to date when item is detached from it */
+static void index_detach(cJSON * const container, const cJSON * const item)
 {
-    unsigned char *output_pointer = NULL;
-    size_t length = 0;
-    cJSON *current_item = item->child;
+    struct cJSON_Index *index = built_index(container);
 
-    if (output_buffer == NULL)
+    if (index == NULL)
     {
-        return false;
+        return;
     }
 
-    /* Compose the output: */
-    length = (size_t) (output_buffer->format ? 2 : 1); /* fmt: {\n */
-    output_pointer = ensure(output_buffer, length + 1);
-    if (output_pointer == NULL)
+    if ((container->type & 0xFF) == cJSON_Array)
     {
-        return false;
+        /* only the last item leaves the others where they are */
+        if ((index->count > 0) && (index->table.items[index->count - 1] == item))
+        {
+            index->count--;
+            return;
+        }
+        index_drop(container);
+    }
+    else
+    {
+        object_index_remove(index, item);
     }
+}
 
-    *output_pointer++ = '{';
-    output_buffer->depth++;
-    if (output_buffer->format)
+/* Packed arrays keep count numbers in the table of their index block, which is freed
+ * and pooled like an index. Pooled arrays take the block from their context. */
+static cJSON_bool pack_numbers(cJSON * const array, const double * const numbers, size_t count)
+{
+    struct cJSON_Index *block = index_allocate(array, count, sizeof(double));
+    if (block == NULL)
     {
-        *output_pointer++ = '\n';
+        return false;
     }
-    output_buffer->offset += length;
 
-    while (current_item)
+    memcpy(block->table.numbers, numbers, count * sizeof(double));
+    block->count = count;
+    array->index = block;
+    array->child = NULL;
+    array->type |= cJSON_Array | cJSON_IsPacked;
+
+    return true;
+}
+
+/* Give a packed array an item for each of its numbers. Pooled arrays take the items from
+ * their context as well, so they still need no cJSON_Delete. */
+static cJSON_bool unpack_array(cJSON * const array)
+{
+    struct cJSON_Index *block = array->index;
+    cJSON_Context *context = (array->type & cJSON_IsPooled) ? block->context : NULL;
+    cJSON *head = NULL;
+    cJSON *current = NULL;
+    cJSON *item = NULL;
+    size_t i = 0;
+
+    for (i = 0; i < block->count; i++)
     {
-        if (output_buffer->format)
+        if (context != NULL)
         {
-            size_t i;
-            output_pointer = ensure(output_buffer, output_buffer->depth);
-            if (output_pointer == NULL)
-            {
-                return false;
-            }
-            for (i = 0; i < output_buffer->depth; i++)
+            item = (cJSON*)context_allocate(context, &context->nodes, sizeof(cJSON));
+            if (item != NULL)
             {
-                *output_pointer++ = '\t';
+                memset(item, '\0', sizeof(cJSON));
+                item->type = cJSON_IsPooled;
+                item->index = &context->index_stub;
             }
-            output_buffer->offset += output_buffer->depth;
-        }
-
-        /* print key */
-        if (!print_string_ptr((unsigned char*)current_item->string, output_buffer))
-        {
-            return false;
-        }
-        update_offset(output_buffer);
-
-        length = (size_t) (output_buffer->format ? 2 : 1);
-        output_pointer = ensure(output_buffer, length);
-        if (output_pointer == NULL)
-        {
-            return false;
         }
-        *output_pointer++ = ':';
-        if (output_buffer->format)
+        else
         {
-            *output_pointer++ = '\t';
+            item = cJSON_New_Item(&global_hooks);
         }
-        output_buffer->offset += length;
-
-        /* print value */
-        if (!print_value(current_item, output_buffer))
+        if (item == NULL)
         {
+            cJSON_Delete(head);
             return false;
         }
-        update_offset(output_buffer);
 
-        /* print comma if not last */
-        length = ((size_t)(output_buffer->format ? 1 : 0) + (size_t)(current_item->next ? 1 : 0));
-        output_pointer = ensure(output_buffer, length + 1);
-        if (output_pointer == NULL)
+        item->type |= cJSON_Number;
+        cJSON_SetNumberHelper(item, block->table.numbers[i]);
+        if (head == NULL)
         {
-            return false;
+            head = item;
         }
-        if (current_item->next)
+        else
         {
-            *output_pointer++ = ',';
+            current->next = item;
+            item->prev = current;
         }
+        current = item;
+    }
+    if (head != NULL)
+    {
+        head->prev = current;
+    }
 
-        if (output_buffer->format)
-        {
-            *output_pointer++ = '\n';
-        }
-        *output_pointer = '\0';
-        output_buffer->offset += length;
+    /* a reference leaves the block to its owner and owns the items it made */
+    if (!(array->type & cJSON_IsReference) && (block->context == NULL))
+    {
+        global_hooks.deallocate(block);
+    }
+    array->index = (context != NULL) ? &context->index_stub : NULL;
+    array->child = head;
+    array->type &= ~(cJSON_IsPacked | cJSON_IsReference);
 
-        current_item = current_item->next;
+    return true;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreatePackedArray(const double *numbers, int count)
+{
+    cJSON *array = NULL;
+
+    if ((count < 0) || (numbers == NULL))
+    {
+        return NULL;
     }
 
-    output_pointer = ensure(output_buffer, output_buffer->format ? (output_buffer->depth + 1) : 2);
-    if (output_pointer == NULL)
+    array = cJSON_CreateArray();
+    /* an empty array has nothing to pack */
+    if ((array != NULL) && (count > 0) && !pack_numbers(array, numbers, (size_t)count))
     {
-        return false;
+        cJSON_Delete(array);
+        return NULL;
     }
-    if (output_buffer->format)
+
+    return array;
+}
+
+CJSON_PUBLIC(double *) cJSON_GetPackedNumbers(const cJSON * const array, int *count)
+{
+    if ((array == NULL) || !(array->type & cJSON_IsPacked))
     {
-        size_t i;
-        for (i = 0; i < (output_buffer->depth - 1); i++)
-        {
-            *output_pointer++ = '\t';
-        }
+        return NULL;
     }
-    *output_pointer++ = '}';
-    *output_pointer = '\0';
-    output_buffer->depth--;
 
-    return true;
+    if (count != NULL)
+    {
+        *count = (int)array->index->count;
+    }
+
+    return array->index->table.numbers;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_UnpackArray(cJSON * const array)
+{
+    if (array == NULL)
+    {
+        return false;
+    }
+
+    return (array->type & cJSON_IsPacked) ? unpack_array(array) : true;
 }
 
-/* Get Array size/item / object item. */
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 {
     cJSON *child = NULL;
     size_t size = 0;
+    struct cJSON_Index *index = NULL;
 
     if (array == NULL)
     {
         return 0;
     }
 
+    if (array->type & cJSON_IsPacked)
+    {
+        return (int)array->index->count;
+    }
+
+    /* objects only for counting would not be worth their hash table */
+    index = container_index(array, (array->type & 0xFF) == cJSON_Array);
+    if (index != NULL)
+    {
+        return (int)index->count;
+    }
+
     child = array->child;
 
     while(child != NULL)
@@ -1856,12 +4747,31 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 static cJSON* get_array_item(const cJSON *array, size_t index)
 {
     cJSON *current_child = NULL;
+    struct cJSON_Index *vector = NULL;
 
     if (array == NULL)
     {
         return NULL;
     }
 
+    /* a packed array has no items until cJSON_UnpackArray gives it some,
+     * a const array is never changed here */
+    if (array->type & cJSON_IsPacked)
+    {
+        return NULL;
+    }
+
+    /* walks shorter than the threshold are not worth building the index for,
+     * which also keeps loops that detach the first item linear */
+    if (((array->type & 0xFF) == cJSON_Array) && (index >= array_index_threshold))
+    {
+        vector = container_index(array, true);
+        if (vector != NULL)
+        {
+            return (index < vector->count) ? vector->table.items[index] : NULL;
+        }
+    }
+
     current_child = array->child;
     while ((current_child != NULL) && (index > 0))
     {
@@ -1882,15 +4792,93 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
     return get_array_item(array, (size_t)index);
 }
 
+CJSON_PUBLIC(cJSON_bool) cJSON_ArrayCursorInit(cJSON_ArrayCursor * const cursor, const cJSON * const array)
+{
+    if (cursor == NULL)
+    {
+        return false;
+    }
+
+    cursor->array = array;
+    cursor->current = NULL;
+    cursor->index = -1;
+
+    /* the items of a packed array do not exist yet, the cursor stays empty */
+    if ((array != NULL) && (array->type & cJSON_IsPacked))
+    {
+        cursor->array = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ArrayCursorNext(cJSON_ArrayCursor * const cursor)
+{
+    if ((cursor == NULL) || (cursor->array == NULL))
+    {
+        return NULL;
+    }
+
+    if (cursor->index < 0)
+    {
+        /* first step */
+        cursor->current = cursor->array->child;
+    }
+    else if (cursor->current != NULL)
+    {
+        cursor->current = cursor->current->next;
+    }
+    else
+    {
+        /* already past the end */
+        return NULL;
+    }
+
+    cursor->index++;
+    return cursor->current;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ArrayCursorSeek(cJSON_ArrayCursor * const cursor, int index)
+{
+    if ((cursor == NULL) || (index < 0))
+    {
+        return NULL;
+    }
+
+    if ((cursor->current == NULL) || (index < cursor->index))
+    {
+        /* past the end or going backwards, start over from the head */
+        cJSON_ArrayCursorInit(cursor, cursor->array);
+    }
+
+    while ((cursor->index < index) && (cJSON_ArrayCursorNext(cursor) != NULL))
+    {
+        /* walk forward */
+    }
+
+    return (cursor->index == index) ? cursor->current : NULL;
+}
+
 static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
 {
     cJSON *current_element = NULL;
+    struct cJSON_Index *index = NULL;
 
     if ((object == NULL) || (name == NULL))
     {
         return NULL;
     }
 
+    if ((object->type & 0xFF) == cJSON_Object)
+    {
+        index = container_index(object, true);
+        if (index != NULL)
+        {
+            return object_index_find(index, name, case_sensitive);
+        }
+    }
+
     current_element = object->child;
     if (case_sensitive)
     {
@@ -1953,7 +4941,12 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
 
     memcpy(reference, item, sizeof(cJSON));
     reference->string = NULL;
-    reference->type |= cJSON_IsReference;
+    /* the reference itself is on the heap and gets no index of its own, only the numbers of a packed array */
+    reference->type = (item->type & ~cJSON_IsPooled) | cJSON_IsReference;
+    if (!(item->type & cJSON_IsPacked))
+    {
+        reference->index = NULL;
+    }
     reference->next = reference->prev = NULL;
     return reference;
 }
@@ -1967,6 +4960,11 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
         return false;
     }
 
+    if ((array->type & cJSON_IsPacked) && !unpack_array(array))
+    {
+        return false;
+    }
+
     child = array->child;
     /*
      * To find the last item in array quickly, we use prev in array
@@ -1977,6 +4975,7 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
         array->child = item;
         item->prev = item;
         item->next = NULL;
+        index_append(array, item);
     }
     else
     {
@@ -1985,6 +4984,7 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
         {
             suffix_object(child->prev, item);
             array->child->prev = item;
+            index_append(array, item);
         }
     }
 
@@ -1997,20 +4997,6 @@ CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToArray(cJSON *array, cJSON *item)
     return add_item_to_array(array, item);
 }
 
-#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
-    #pragma GCC diagnostic push
-#endif
-#ifdef __GNUC__
-#pragma GCC diagnostic ignored "-Wcast-qual"
-#endif
-/* helper function to cast away const */
-static void* cast_away_const(const void* string)
-{
-    return (void*)string;
-}
-#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
-    #pragma GCC diagnostic pop
-#endif
 
 
 static cJSON_bool add_item_to_object(cJSON * const object, const char * const string, cJSON * const item, const internal_hooks * const hooks, const cJSON_bool constant_key)
@@ -2196,6 +5182,8 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
         return NULL;
     }
 
+    index_detach(parent, item);
+
     if (item != parent->child)
     {
         /* not the first element */
@@ -2227,7 +5215,7 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
 
 CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromArray(cJSON *array, int which)
 {
-    if (which < 0)
+    if ((which < 0) || !cJSON_UnpackArray(array))
     {
         return NULL;
     }
@@ -2269,7 +5257,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
 {
     cJSON *after_inserted = NULL;
 
-    if (which < 0 || newitem == NULL)
+    if (which < 0 || newitem == NULL || !cJSON_UnpackArray(array))
     {
         return false;
     }
@@ -2296,6 +5284,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
     {
         newitem->prev->next = newitem;
     }
+    index_drop(array);
     return true;
 }
 
@@ -2343,6 +5332,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
 
     item->next = NULL;
     item->prev = NULL;
+    index_drop(parent);
     cJSON_Delete(item);
 
     return true;
@@ -2350,7 +5340,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
 
 CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON *newitem)
 {
-    if (which < 0)
+    if ((which < 0) || !cJSON_UnpackArray(array))
     {
         return false;
     }
@@ -2732,7 +5722,7 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
         goto fail;
     }
     /* Copy over all vars */
-    newitem->type = item->type & (~cJSON_IsReference);
+    newitem->type = item->type & ~(cJSON_IsReference | cJSON_IsPooled);
     newitem->valueint = item->valueint;
     newitem->valuedouble = item->valuedouble;
     if (item->valuestring)
@@ -2745,7 +5735,10 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
     }
     if (item->string)
     {
-        newitem->string = (item->type&cJSON_StringIsConst) ? item->string : (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
+        /* the copy owns its name, a constant one may be in the arena of a context or in
+         * the input of an in situ parse */
+        newitem->type &= ~cJSON_StringIsConst;
+        newitem->string = (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
         if (!newitem->string)
         {
             goto fail;
@@ -2754,8 +5747,13 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
     /* If non-recursive, then we're done! */
     if (!recurse)
     {
+        newitem->type &= ~cJSON_IsPacked;
         return newitem;
     }
+    if ((item->type & cJSON_IsPacked) && !pack_numbers(newitem, item->index->table.numbers, item->index->count))
+    {
+        goto fail;
+    }
     /* Walk the ->next chain for the child. */
     child = item->child;
     while (child != NULL)
@@ -2837,7 +5835,8 @@ static void minify_string(char **input, char **output) {
             *input += static_strlen("\"");
             *output += static_strlen("\"");
             return;
-        } else if (((*input)[0] == '\\') && ((*input)[1] == '\"')) {
+        } else if (((*input)[0] == '\\') && ((*input)[1] != '\0')) {
+            /* whatever is escaped, it doesn't end the string */
             (*output)[1] = (*input)[1];
             *input += static_strlen("\"");
             *output += static_strlen("\"");
@@ -2848,14 +5847,23 @@ static void minify_string(char **input, char **output) {
 CJSON_PUBLIC(void) cJSON_Minify(char *json)
 {
     char *into = json;
+    const char *end = NULL;
 
     if (json == NULL)
     {
         return;
     }
 
+    end = json + strlen(json);
     while (json[0] != '\0')
     {
+        /* whole blocks up to the next comment */
+        compact_whitespace((unsigned char**)&json, (const unsigned char*)end, (unsigned char**)&into);
+        if (json[0] == '\0')
+        {
+            break;
+        }
+
         switch (json[0])
         {
             case ' ':
@@ -2993,6 +6001,40 @@ CJSON_PUBLIC(cJSON_bool) cJSON_IsRaw(const cJSON * const item)
     return (item->type & 0xFF) == cJSON_Raw;
 }
 
+/* packed is a packed array, other any array */
+static cJSON_bool compare_packed_array(const cJSON * const packed, const cJSON * const other)
+{
+    const struct cJSON_Index *block = packed->index;
+    cJSON *element = other->child;
+    size_t i = 0;
+
+    if (other->type & cJSON_IsPacked)
+    {
+        if (other->index->count != block->count)
+        {
+            return false;
+        }
+        for (i = 0; i < block->count; i++)
+        {
+            if (!compare_double(block->table.numbers[i], other->index->table.numbers[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    for (i = 0; i < block->count; i++, element = element->next)
+    {
+        if ((element == NULL) || !cJSON_IsNumber(element) || !compare_double(block->table.numbers[i], element->valuedouble))
+        {
+            return false;
+        }
+    }
+
+    return element == NULL;
+}
+
 CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * const b, const cJSON_bool case_sensitive)
 {
     if ((a == NULL) || (b == NULL) || ((a->type & 0xFF) != (b->type & 0xFF)))
@@ -3056,6 +6098,11 @@ CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * cons
             cJSON *a_element = a->child;
             cJSON *b_element = b->child;
 
+            if ((a->type | b->type) & cJSON_IsPacked)
+            {
+                return compare_packed_array((a->type & cJSON_IsPacked) ? a : b, (a->type & cJSON_IsPacked) ? b : a);
+            }
+
             for (; (a_element != NULL) && (b_element != NULL);)
             {
                 if (!cJSON_Compare(a_element, b_element, case_sensitive))
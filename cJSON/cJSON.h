@@ -84,6 +84,7 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 #define CJSON_VERSION_PATCH 17
 
 #include <stddef.h>
+#include <stdio.h>
 
 /* cJSON Types: */
 #define cJSON_Invalid (0)
@@ -98,6 +99,8 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 
 #define cJSON_IsReference 256
 #define cJSON_StringIsConst 512
+#define cJSON_IsPooled 1024 /* the item lives in the node pool of a cJSON_Context */
+#define cJSON_IsPacked 2048 /* an array of numbers kept as one block of doubles, see cJSON_CreatePackedArray */
 
 /* The cJSON structure: */
 typedef struct cJSON
@@ -110,16 +113,21 @@ typedef struct cJSON
 
     /* The type of the item, as above. */
     int type;
+    /* writing to valueint is DEPRECATED, use cJSON_SetNumberValue instead */
+    int valueint;
 
     /* The item's string, if type==cJSON_String  and type == cJSON_Raw */
     char *valuestring;
-    /* writing to valueint is DEPRECATED, use cJSON_SetNumberValue instead */
-    int valueint;
     /* The item's number, if type==cJSON_Number */
     double valuedouble;
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+
+    /* Lookup index of an object or array, built by the lookups (see cJSON_SetObjectIndexThreshold and
+     * cJSON_SetArrayIndexThreshold). Keep it NULL.
+     * valueint sits next to type so that the item stays 64 bytes on 64 bit platforms. */
+    struct cJSON_Index *index;
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -131,6 +139,9 @@ typedef struct cJSON_Hooks
 
 typedef int cJSON_bool;
 
+/* Receives printed text in pieces, see cJSON_PrintStreamed. Returns 1 on success, 0 on failure. */
+typedef cJSON_bool (*cJSON_WriteFunction)(void *target, const char *text, size_t length);
+
 /* Limits how deeply nested arrays/objects can be before cJSON rejects to parse them.
  * This is to prevent stack overflows. */
 #ifndef CJSON_NESTING_LIMIT
@@ -140,6 +151,18 @@ typedef int cJSON_bool;
 /* returns the version of cJSON as a string */
 CJSON_PUBLIC(const char*) cJSON_Version(void);
 
+/* SIMD kernels used by the parser. CJSON_SIMD_AUTO picks the best one the CPU supports,
+ * which is also what happens when cJSON_SetSimdLevel is never called. Define CJSON_NO_SIMD
+ * when compiling cJSON to only build the scalar code. */
+#define CJSON_SIMD_AUTO (-1)
+#define CJSON_SIMD_SCALAR 0
+#define CJSON_SIMD_SSE2 1
+#define CJSON_SIMD_AVX2 2
+
+/* Select the kernels, levels the CPU does not support fall back to the best one it does. Returns the level now in use. */
+CJSON_PUBLIC(int) cJSON_SetSimdLevel(int level);
+CJSON_PUBLIC(int) cJSON_GetSimdLevel(void);
+
 /* Supply malloc, realloc and free functions to cJSON */
 CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks);
 
@@ -151,6 +174,29 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 /* If you supply a ptr in return_parse_end and parsing fails, then return_parse_end will contain a pointer to the error so will match cJSON_GetErrorPtr(). */
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+/* ParseWithFlags takes the options as CJSON_PARSE_* flags. CJSON_PARSE_STRICT_UTF8 rejects strings that are not
+ * well-formed UTF-8 (checked with SIMD where the CPU has it) and \u escapes with invalid hex digits.
+ * CJSON_PARSE_IN_SITU parses without copying the keys and strings that have no escapes: they point into value, which
+ * must be writable and outlive the tree, and the closing quote of each is overwritten by its terminator. Only strings
+ * with escapes are decoded onto the heap (or into the context). The items are references, as for cJSON_IsReference.
+ * CJSON_PARSE_PACK_NUMBERS makes every non-empty array of nothing but numbers a packed array. */
+#define CJSON_PARSE_REQUIRE_NULL_TERMINATED 1
+#define CJSON_PARSE_STRICT_UTF8 2
+#define CJSON_PARSE_IN_SITU 4
+#define CJSON_PARSE_PACK_NUMBERS 8
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithFlags(const char *value, size_t buffer_length, const char **return_parse_end, int flags);
+
+/* A parse context takes the items of a parse from a node pool and their keys and strings from an arena, so a
+ * parse makes a handful of large allocations. cJSON_DeleteContext frees every tree parsed with it at once, without
+ * walking them; cJSON_Delete on such a tree only frees items that were added to it later. Trees must not be used
+ * after their context is reset or deleted, cJSON_Duplicate makes a copy that is independent of it.
+ * ParseWithContext with a NULL context is ParseWithFlags. */
+typedef struct cJSON_Context cJSON_Context;
+CJSON_PUBLIC(cJSON_Context *) cJSON_CreateContext(void);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithContext(cJSON_Context *context, const char *value, size_t buffer_length, const char **return_parse_end, int flags);
+/* Free the trees of the context but keep some of its memory for the next parse. */
+CJSON_PUBLIC(void) cJSON_ResetContext(cJSON_Context *context);
+CJSON_PUBLIC(void) cJSON_DeleteContext(cJSON_Context *context);
 
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
@@ -161,17 +207,54 @@ CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON
 /* Render a cJSON entity to text using a buffer already allocated in memory with given length. Returns 1 on success and 0 on failure. */
 /* NOTE: cJSON is not always 100% accurate in estimating how much memory it will use, so to be safe allocate 5 bytes more than you actually need */
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format);
+/* Render a cJSON entity straight into an open file or file descriptor. The text goes out whenever a fixed-size buffer
+ * fills up, so it is never held in memory as a whole and its length is not limited to INT_MAX.
+ * Returns 1 on success and 0 on failure, the part printed until then may already be written. */
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToFile(const cJSON *item, FILE *file, cJSON_bool format);
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToFd(const cJSON *item, int fd, cJSON_bool format);
+/* The same with a buffer of chunk_size bytes handed to write each time it is full. A single string longer than
+ * the buffer makes it grow to fit. write returns 1 on success, 0 stops the print. */
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintStreamed(const cJSON *item, cJSON_bool format, size_t chunk_size, cJSON_WriteFunction write, void *target);
 /* Delete a cJSON entity and all subentities. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item);
 
 /* Returns the number of items in an array (or object). */
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array);
-/* Retrieve item number "index" from array "array". Returns NULL if unsuccessful. */
+/* Retrieve item number "index" from array "array". Returns NULL if unsuccessful, and for packed arrays, which are
+ * never changed by a read: use cJSON_GetPackedNumbers or cJSON_UnpackArray first. */
+/* NOTE: this walks the child list from the head on every call, use a cJSON_ArrayCursor when visiting items in order. */
 CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index);
+
+/* Cursor for visiting the items of an array (or object) in order with O(1) work per step. */
+typedef struct cJSON_ArrayCursor
+{
+    const cJSON *array;
+    /* the item the cursor is on, NULL before the first call to Next and after the end */
+    cJSON *current;
+    /* index of current, -1 before the first call to Next */
+    int index;
+} cJSON_ArrayCursor;
+
+/* Start before the first item. Returns false, with a cursor that visits nothing, for a packed array. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ArrayCursorInit(cJSON_ArrayCursor * const cursor, const cJSON * const array);
+/* Advance to the next item. Returns NULL at the end of the array. */
+CJSON_PUBLIC(cJSON *) cJSON_ArrayCursorNext(cJSON_ArrayCursor * const cursor);
+/* Move to item number "index". Walks forward from the current item when possible, so a loop over increasing indices is linear in total. */
+CJSON_PUBLIC(cJSON *) cJSON_ArrayCursorSeek(cJSON_ArrayCursor * const cursor, int index);
 /* Get item "string" from object. Case insensitive. */
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string);
+/* Objects with more than "members" members get a hash index at their first lookup, which then serves both
+ * GetObjectItem variants. Adding and detaching members keep it, other changes make the next lookup build it again.
+ * 0 (the default) turns indexing off. Building the index writes
+ * to the object, so threads that look up members of the same object need a lock while this is on. */
+CJSON_PUBLIC(void) cJSON_SetObjectIndexThreshold(int members);
+/* Arrays with more than "items" items get a vector of their items the first time cJSON_GetArraySize counts them or
+ * cJSON_GetArrayItem is asked for an item at least that far from the start. Both are O(1) from then on, appending
+ * and detaching the last item keep the vector, other changes make the next call build it again. 0 (the default)
+ * turns it off, the same locking applies. */
+CJSON_PUBLIC(void) cJSON_SetArrayIndexThreshold(int items);
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
 CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void);
 
@@ -218,6 +301,15 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateFloatArray(const float *numbers, int count);
 CJSON_PUBLIC(cJSON *) cJSON_CreateDoubleArray(const double *numbers, int count);
 CJSON_PUBLIC(cJSON *) cJSON_CreateStringArray(const char *const *strings, int count);
 
+/* A packed array keeps its numbers in one block of doubles instead of an item each, 8 bytes per number instead of
+ * sizeof(cJSON). It is an array for cJSON_IsArray, GetArraySize, Print, Duplicate and Compare, which read the block.
+ * Reading never changes it, so it has no items for GetArrayItem, the array cursor and cJSON_ArrayForEach until
+ * cJSON_UnpackArray gives it some. Adding, inserting, detaching and replacing items unpack it first. */
+CJSON_PUBLIC(cJSON *) cJSON_CreatePackedArray(const double *numbers, int count);
+/* The numbers of a packed array, NULL for anything else. They may be changed in place. */
+CJSON_PUBLIC(double *) cJSON_GetPackedNumbers(const cJSON * const array, int *count);
+CJSON_PUBLIC(cJSON_bool) cJSON_UnpackArray(cJSON * const array);
+
 /* Append item to the specified array/object. */
 CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToArray(cJSON *array, cJSON *item);
 CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToObject(cJSON *object, const char *string, cJSON *item);
@@ -286,7 +378,7 @@ CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
     cJSON_Invalid\
 )
 
-/* Macro for iterating over an array or object */
+/* Macro for iterating over an array or object. Packed arrays have no items to visit, see cJSON_UnpackArray. */
 #define cJSON_ArrayForEach(element, array) for(element = (array != NULL) ? (array)->child : NULL; element != NULL; element = element->next)
 
 /* malloc/free objects using the malloc/free functions that have been set with cJSON_InitHooks */
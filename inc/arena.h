@@ -0,0 +1,34 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+struct cJSON;
+
+// One block of arena memory, allocations are bumped out of data
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;
+    size_t size;        // usable bytes behind the header
+    size_t used;
+} ArenaChunk;
+
+// Bump allocator for everything one loaded dataset holds. Nothing is freed on its
+// own, the whole arena goes at once when the last person referring to it is dropped.
+typedef struct Arena {
+    ArenaChunk *chunks;         // current chunk first
+    size_t next_chunk_size;     // grows up to ARENA_MAX_CHUNK_SIZE
+    struct cJSON **trees;       // nested values, deleted with the arena
+    int num_trees;
+    int trees_capacity;
+    int refs;                   // people using the arena
+} Arena;
+
+Arena *arenaCreate(void);
+void *arenaAlloc(Arena *arena, size_t size);
+char *arenaStrdup(Arena *arena, const char *text);
+int arenaAdoptTree(Arena *arena, struct cJSON *tree);
+Arena *arenaRetain(Arena *arena);
+void arenaRelease(Arena *arena);
+void arenaDestroy(Arena *arena);
+
+#endif /* ARENA_H */
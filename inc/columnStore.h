@@ -0,0 +1,72 @@
+#ifndef COLUMN_STORE_H
+#define COLUMN_STORE_H
+
+#include <stddef.h>
+#include "value.h"
+
+struct cJSON;
+
+// How a column keeps its values
+typedef enum {
+    COLUMN_NUMBER,      // double per row
+    COLUMN_STRING,      // offsets into one byte blob
+    COLUMN_VALUE        // anything else (booleans, nested values, mixed types)
+} ColumnType;
+
+// All values of one key, row i belongs to the i-th person
+typedef struct {
+    int key_id;
+    ColumnType type;
+    unsigned char *valid;   // bit per row, 0 = missing or null
+    unsigned char *nulls;   // bit per row, 1 = an explicit null
+    double *numbers;        // COLUMN_NUMBER
+    size_t *offsets;        // COLUMN_STRING, row i is blob[offsets[i]] .. blob[offsets[i + 1]]
+    char *blob;             // COLUMN_STRING, every string NUL-terminated
+    size_t blob_length;
+    size_t blob_capacity;
+    int filled_rows;        // COLUMN_STRING, rows with offsets set so far
+    Value *values;          // COLUMN_VALUE
+} Column;
+
+// The people of a file stored column by column instead of person by person
+typedef struct {
+    int num_rows;
+    int *ids;
+    Column *columns;        // in order of first appearance of the key
+    int num_columns;
+    int columns_capacity;
+    int *column_of_key;     // key id -> index into columns, -1 = none
+    int keys_capacity;
+    // Key order of every row, so rows are saved the way they were loaded. Rows with the
+    // same order as the row before share its layout.
+    int *row_layout;        // row -> layout, -1 = no keys but the id
+    int *layout_columns;    // column indexes of all layouts, one after the other
+    int *layout_start;      // layout i is layout_columns[layout_start[i]] .. layout_columns[layout_start[i + 1]]
+    int num_layouts;
+    int layouts_capacity;
+    int layout_length;      // used entries of layout_columns
+    int layout_capacity;
+} ColumnStore;
+
+// Aggregates of a numeric column
+typedef struct {
+    int count;              // rows with a number
+    double sum;
+    double min;
+    double max;
+    double mean;
+} ColumnStats;
+
+ColumnStore *createColumnStore(int num_rows);
+int columnStoreSetRow(ColumnStore *store, int row, struct cJSON *person_json);
+void columnStoreFinish(ColumnStore *store);
+void freeColumnStore(ColumnStore *store);
+
+const Column *findColumn(const ColumnStore *store, const char *key);
+int columnIsValid(const Column *column, int row);
+int columnIsNull(const Column *column, int row);
+const char *columnString(const Column *column, int row);
+int columnStats(const ColumnStore *store, const char *key, ColumnStats *stats);
+int saveColumns(const char *filename, const ColumnStore *store);
+
+#endif /* COLUMN_STORE_H */
@@ -0,0 +1,16 @@
+#ifndef FILE_INPUT_H
+#define FILE_INPUT_H
+
+#include <stddef.h>
+
+// Whole content of an input file, either read into the heap or mapped
+typedef struct {
+    char *content;      // not NUL-terminated when mapped
+    size_t length;
+    int mapped;         // 1 = munmap on close, 0 = free on close
+} FileContent;
+
+int openFileContent(const char *filename, int use_mmap, FileContent *file);
+void closeFileContent(FileContent *file);
+
+#endif /* FILE_INPUT_H */
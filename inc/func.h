@@ -1,28 +1,69 @@
 #ifndef FUNC_H
 #define FUNC_H
 
-// Structure to represent dynamic key-value pairs
-typedef struct KeyValue {
-    char *key;
-    char *value;
-    struct KeyValue *next;
+#include "value.h"
+#include "arena.h"
+#include "columnStore.h"
+
+struct PersonIndex;
+
+// Structure to represent one key-value pair
+typedef struct {
+    int key_id;         // interned key, see keyName
+    Value value;
 } KeyValue;
 
+// Key-value pairs in insertion order, stored next to each other
+typedef struct {
+    KeyValue *items;
+    int count;
+    int capacity;
+} KeyValueList;
+
 // Structure to represent a person
 typedef struct {
     int id;         
-    KeyValue *data;  
+    KeyValueList data;  
+    Arena *arena;   // holds data for loaded people, NULL when data is on the heap
 } Person;
 
-int addKeyValue(KeyValue **list, const char *key, const char *value);
-void freeKeyValueList(KeyValue **list);
+// How loadData gets the file into memory
+typedef enum {
+    LOAD_INPUT_READ,    // malloc + fread of the whole file
+    LOAD_INPUT_MMAP     // map the file and parse it in place, pipes fall back to reading
+} LoadInput;
+
+// Which parser turns the file into a cJSON tree
+typedef enum {
+    LOAD_ENGINE_CJSON,          // cJSON's recursive descent
+    LOAD_ENGINE_INDEXED,        // structural index first, then the tree (src/jsonIndex.c)
+    LOAD_ENGINE_CJSON_IN_SITU   // cJSON with strings pointing into a heap copy of the file instead of copies
+} LoadEngine;
+
+// Options for loadDataWithOptions
+typedef struct {
+    LoadInput input;
+    LoadEngine engine;
+} LoadOptions;
+
+int addKeyValue(KeyValueList *list, const char *key, const char *value);
+int addKeyIDValue(KeyValueList *list, int key_id, Value value);
+KeyValue *findKeyValue(const KeyValueList *list, int key_id);
+int addPersonKeyValue(Person *person, int key_id, Value value);
+int addTypedKeyValue(KeyValueList *list, const char *key, Value value);
+void freeKeyValueList(KeyValueList *list);
 Person *loadData(const char *filename, int *num_people);
-void addNewData(Person **people, int *num_people);
+Person *loadDataWithOptions(const char *filename, int *num_people, const LoadOptions *options);
+Person *loadDataStreaming(const char *filename, int *num_people);
+Person *loadDataParallel(const char *filename, int *num_people, int num_threads);
+ColumnStore *loadDataColumnar(const char *filename);
+void addNewData(Person **people, int *num_people, struct PersonIndex *index);
 void printPersonData(const Person *person);
 void modifyPersonData(Person *person);
+int writePeopleJSON(FILE *file, FILE *echo, const Person *people, int num_people);
 void saveData(const char *filename, Person *people, int num_people);
 void freePeople(Person *people, int num_people);
-void modifyDataBasedOnID(Person *people, int num_people);
-void deletePersonByID(Person *people, int *num_people, int id);
+void modifyDataBasedOnID(Person *people, int num_people, struct PersonIndex *index);
+void deletePersonByID(Person *people, int *num_people, struct PersonIndex *index, int id);
 
 #endif /* FUNC_H */
@@ -0,0 +1,21 @@
+#ifndef JSON_INDEX_H
+#define JSON_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct cJSON;
+
+// Stage 1 output: offsets of every structural character ({ } [ ] : ,), every opening
+// quote and the first byte of every number or literal, in text order
+typedef struct {
+    uint32_t *positions;
+    size_t count;
+    size_t capacity;
+} JsonIndex;
+
+int buildJsonIndex(const char *json, size_t length, JsonIndex *index, size_t *error_offset);
+void freeJsonIndex(JsonIndex *index);
+struct cJSON *parseJsonIndexed(const char *json, size_t length, size_t *error_offset);
+
+#endif /* JSON_INDEX_H */
@@ -0,0 +1,51 @@
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+// Resumable state for finding where one JSON value ends
+typedef struct {
+    size_t position;    // bytes of the value scanned so far
+    int depth;          // open objects/arrays
+    int in_string;
+    int escaped;
+    int started;
+    int scalar;         // number or literal, ends at the first delimiter
+} JsonScanState;
+
+// A file read in chunks, the buffer only ever holds the value being returned
+typedef struct {
+    FILE *file;
+    char *buffer;
+    size_t capacity;
+    size_t start;       // first byte not consumed yet
+    size_t end;         // one past the last byte read
+    int eof;
+    int first;          // no element of the current array returned yet
+    int borrowed;       // buffer belongs to the caller (jsonStreamOpenMemory)
+} JsonStream;
+
+// Unescaped quotes and bracket balance of one piece of a document. Together with the
+// summaries of the pieces before it, this tells whether a piece starts inside a string
+// and how deep, so pieces can be scanned by different threads.
+typedef struct {
+    int quote_parity;       // 1 when the piece holds an odd number of unescaped quotes
+    long depth_change[2];   // opened minus closed brackets if the piece starts outside [0] or inside [1] a string
+    long min_depth[2];      // lowest running balance on the way, 0 or below, for the same two cases
+} JsonChunkSummary;
+
+void jsonScanInit(JsonScanState *state);
+int jsonScanValue(JsonScanState *state, const char *text, size_t length);
+
+void jsonSummarizeChunk(const char *text, size_t length, JsonChunkSummary *summary);
+long jsonFindSeparator(const char *text, size_t length, int in_string, long depth);
+long jsonFindArrayEnd(const char *text, size_t length, int in_string, long depth);
+
+int jsonStreamOpen(JsonStream *stream, const char *filename);
+void jsonStreamOpenMemory(JsonStream *stream, const char *text, size_t length);
+int jsonStreamEnterArray(JsonStream *stream, const char *key);
+int jsonStreamNextValue(JsonStream *stream, const char **value, size_t *length);
+void jsonStreamClose(JsonStream *stream);
+
+#endif /* JSON_STREAM_H */
@@ -0,0 +1,29 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct cJSON;
+
+// JSON text written into a fixed buffer that goes to the file whenever it is full.
+// Errors are remembered and reported by jsonWriterClose, so the write calls need no checks.
+typedef struct JsonWriter {
+    FILE *file;
+    FILE *echo;         // gets a copy of everything written, NULL for none
+    char *buffer;
+    size_t length;      // bytes waiting in the buffer
+    size_t capacity;
+    int failed;
+} JsonWriter;
+
+int jsonWriterOpen(JsonWriter *writer, FILE *file, FILE *echo);
+void jsonWriteRaw(JsonWriter *writer, const char *text, size_t length);
+void jsonWriteString(JsonWriter *writer, const char *text);
+void jsonWriteInteger(JsonWriter *writer, int64_t number);
+void jsonWriteDouble(JsonWriter *writer, double number);
+void jsonWriteTree(JsonWriter *writer, const struct cJSON *tree, int depth);
+int jsonWriterClose(JsonWriter *writer);
+
+#endif /* JSON_WRITER_H */
@@ -0,0 +1,29 @@
+#ifndef KEY_TABLE_H
+#define KEY_TABLE_H
+
+// Every distinct attribute key is stored once and referred to by a small id
+typedef struct {
+    char **names;       // id -> key string
+    int count;
+    int names_capacity;
+    int *slots;         // open addressing over the names, -1 = empty
+    int capacity;       // always a power of two
+} KeyTable;
+
+#define KEY_CACHE_SIZE 32
+
+// Keys one loader thread interned recently, by position in the record. Records of a file
+// mostly repeat the same keys in the same order, so most lookups skip the table's lock.
+typedef struct {
+    const char *names[KEY_CACHE_SIZE];  // owned by the key table
+    int ids[KEY_CACHE_SIZE];
+} KeyCache;
+
+int internKey(const char *key);
+int internKeyCached(KeyCache *cache, int position, const char *key);
+int findKeyID(const char *key);
+const char *keyName(int key_id);
+int keyCount(void);
+void freeKeyTable(void);
+
+#endif /* KEY_TABLE_H */
@@ -0,0 +1,26 @@
+#ifndef MEM_TRACK_H
+#define MEM_TRACK_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+// Allocation counters of the program and, once memTrackInstallHooks ran, of cJSON
+typedef struct {
+    size_t live_bytes;      // requested bytes not freed yet
+    size_t live_blocks;
+    size_t peak_bytes;
+    size_t total_allocations;
+} MemTrackStats;
+
+void *memTrackMalloc(size_t size);
+void *memTrackRealloc(void *ptr, size_t size);
+char *memTrackStrdup(const char *text);
+void memTrackFree(void *ptr);
+
+void memTrackInstallHooks(void);
+MemTrackStats memTrackStats(void);
+size_t memTrackLiveBytes(void);
+void memTrackResetPeak(void);
+void memTrackReport(FILE *stream, const char *label);
+
+#endif /* MEM_TRACK_H */
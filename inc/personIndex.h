@@ -0,0 +1,28 @@
+#ifndef PERSON_INDEX_H
+#define PERSON_INDEX_H
+
+#include "func.h"
+
+// One slot of the open-addressing table: person id -> position in the people array
+typedef struct {
+    int id;
+    int slot;       // -1 = empty, -2 = deleted (tombstone)
+} PersonIndexEntry;
+
+// Hash index over one people array. It is kept by whoever holds the array, passed to
+// the functions that look people up or change the array, and updated by them.
+typedef struct PersonIndex {
+    PersonIndexEntry *entries;
+    int capacity;               // always a power of two
+    int used;                   // live entries + tombstones
+    int has_duplicates;         // some id occurs more than once, removals rebuild the index
+} PersonIndex;
+
+int buildPersonIndex(PersonIndex *index, const Person *people, int num_people);
+int findPersonSlot(const PersonIndex *index, int id);
+int personIndexAppend(PersonIndex *index, const Person *people, int num_people);
+int personIndexRemove(PersonIndex *index, const Person *people, int num_people, int id, int slot);
+int personIndexChangeID(PersonIndex *index, const Person *people, int num_people, int slot, int old_id);
+void freePersonIndex(PersonIndex *index);
+
+#endif /* PERSON_INDEX_H */
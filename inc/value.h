@@ -0,0 +1,43 @@
+#ifndef VALUE_H
+#define VALUE_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+struct cJSON;
+struct Arena;
+struct JsonWriter;
+
+// Type of a stored attribute value
+typedef enum {
+    VALUE_NULL,
+    VALUE_BOOL,
+    VALUE_INT,
+    VALUE_DOUBLE,
+    VALUE_STRING,
+    VALUE_JSON      // nested object or array
+} ValueType;
+
+// Attribute value, stored as what it is instead of as printed JSON text
+typedef struct {
+    ValueType type;
+    union {
+        int boolean;
+        int64_t integer;
+        double number;
+        char *string;           // allocated with cJSON_malloc
+        struct cJSON *json;     // detached subtree, released with cJSON_Delete
+    } as;
+} Value;
+
+Value numberValue(double number);
+Value valueFromJSON(struct cJSON *parent, struct cJSON *item, struct Arena *arena);
+struct cJSON *valueToJSON(const Value *value);
+void writeValueJSON(struct JsonWriter *writer, const Value *value, int depth);
+int parseValueText(const char *text, Value *value);
+int stringValue(const char *text, Value *value);
+void printValue(FILE *stream, const Value *value);
+int moveValueToArena(struct Arena *arena, Value *value);
+void freeValue(Value *value);
+
+#endif /* VALUE_H */
@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../cJSON/cJSON.h"
+#include "../inc/arena.h"
+#include "../inc/memTrack.h"
+
+#define ARENA_FIRST_CHUNK_SIZE (64 * 1024)
+#define ARENA_MAX_CHUNK_SIZE (4 * 1024 * 1024)
+#define ARENA_ALIGNMENT 8
+
+// Chunk data starts behind the header, rounded up so it stays aligned
+#define CHUNK_HEADER_SIZE ((sizeof(ArenaChunk) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+#define CHUNK_DATA(chunk) ((char *)(chunk) + CHUNK_HEADER_SIZE)
+
+
+Arena *arenaCreate(void) {
+    Arena *arena = memTrackMalloc(sizeof(Arena));
+    if (!arena) {
+        perror("Memory allocation failed for arena");
+        return NULL;
+    }
+    memset(arena, 0, sizeof(*arena));
+    arena->next_chunk_size = ARENA_FIRST_CHUNK_SIZE;
+    return arena;
+}
+
+static ArenaChunk *newChunk(size_t size) {
+    ArenaChunk *chunk = memTrackMalloc(CHUNK_HEADER_SIZE + size);
+    if (!chunk) {
+        perror("Memory allocation failed for arena chunk");
+        return NULL;
+    }
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+    return chunk;
+}
+
+// Take size bytes from the current chunk, starting a new one when it is full
+static void *bump(Arena *arena, size_t size, size_t align) {
+    ArenaChunk *chunk = arena->chunks;
+    if (chunk) {
+        size_t start = (chunk->used + align - 1) & ~(align - 1);
+        if (start <= chunk->size && size <= chunk->size - start) {
+            chunk->used = start + size;
+            return CHUNK_DATA(chunk) + start;
+        }
+    }
+
+    // Blocks bigger than a quarter chunk get a chunk of their own behind the
+    // current one, so the space left in the current chunk is not thrown away
+    if (size > arena->next_chunk_size / 4) {
+        ArenaChunk *own = newChunk(size);
+        if (!own) return NULL;
+        own->used = size;
+        if (chunk) {
+            own->next = chunk->next;
+            chunk->next = own;
+        } else {
+            arena->chunks = own;
+        }
+        return CHUNK_DATA(own);
+    }
+
+    ArenaChunk *fresh = newChunk(arena->next_chunk_size);
+    if (!fresh) return NULL;
+    if (arena->next_chunk_size < ARENA_MAX_CHUNK_SIZE) {
+        arena->next_chunk_size *= 2;
+    }
+    fresh->next = chunk;
+    fresh->used = size;
+    arena->chunks = fresh;
+    return CHUNK_DATA(fresh);
+}
+
+// Memory for a structure, aligned for pointers, int64_t and double
+void *arenaAlloc(Arena *arena, size_t size) {
+    return bump(arena, size, ARENA_ALIGNMENT);
+}
+
+char *arenaStrdup(Arena *arena, const char *text) {
+    size_t length = strlen(text) + 1;
+    char *copy = bump(arena, length, 1);
+    if (copy) {
+        memcpy(copy, text, length);
+    }
+    return copy;
+}
+
+// Keep a cJSON tree until the arena is destroyed
+int arenaAdoptTree(Arena *arena, cJSON *tree) {
+    if (arena->num_trees == arena->trees_capacity) {
+        int capacity = arena->trees_capacity ? arena->trees_capacity * 2 : 16;
+        cJSON **trees = memTrackRealloc(arena->trees, (size_t)capacity * sizeof(cJSON *));
+        if (!trees) {
+            perror("Memory allocation failed for arena");
+            return 0;
+        }
+        arena->trees = trees;
+        arena->trees_capacity = capacity;
+    }
+    arena->trees[arena->num_trees++] = tree;
+    return 1;
+}
+
+Arena *arenaRetain(Arena *arena) {
+    if (arena) arena->refs++;
+    return arena;
+}
+
+// Drop one reference, the last one destroys the arena
+void arenaRelease(Arena *arena) {
+    if (arena && --arena->refs <= 0) {
+        arenaDestroy(arena);
+    }
+}
+
+// Free all chunks and adopted trees in one go
+void arenaDestroy(Arena *arena) {
+    if (!arena) return;
+
+    for (int i = 0; i < arena->num_trees; ++i) {
+        cJSON_Delete(arena->trees[i]);
+    }
+    memTrackFree(arena->trees);
+
+    ArenaChunk *chunk = arena->chunks;
+    while (chunk) {
+        ArenaChunk *next = chunk->next;
+        memTrackFree(chunk);
+        chunk = next;
+    }
+    memTrackFree(arena);
+}
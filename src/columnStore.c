@@ -0,0 +1,452 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../cJSON/cJSON.h"
+#include "../inc/columnStore.h"
+#include "../inc/keyTable.h"
+#include "../inc/jsonWriter.h"
+#include "../inc/memTrack.h"
+
+#define BITMAP_BYTES(rows) (((size_t)(rows) + 7) / 8)
+
+
+static void setValid(Column *column, int row) {
+    column->valid[row / 8] |= (unsigned char)(1u << (row % 8));
+}
+
+static void setNull(Column *column, int row) {
+    column->nulls[row / 8] |= (unsigned char)(1u << (row % 8));
+}
+
+int columnIsValid(const Column *column, int row) {
+    return (column->valid[row / 8] >> (row % 8)) & 1;
+}
+
+// 1 when the row holds an explicit null, which columnIsValid does not tell from a missing key
+int columnIsNull(const Column *column, int row) {
+    return (column->nulls[row / 8] >> (row % 8)) & 1;
+}
+
+// String of a row, NULL when the row has none. Stays valid as long as the store.
+const char *columnString(const Column *column, int row) {
+    if (column->type != COLUMN_STRING || !columnIsValid(column, row)) return NULL;
+    return column->blob + column->offsets[row];
+}
+
+ColumnStore *createColumnStore(int num_rows) {
+    ColumnStore *store = memTrackMalloc(sizeof(ColumnStore));
+    if (!store) {
+        perror("Memory allocation failed for column store");
+        return NULL;
+    }
+    memset(store, 0, sizeof(*store));
+    store->num_rows = num_rows;
+
+    store->ids = memTrackMalloc(((size_t)num_rows + 1) * sizeof(int));
+    store->row_layout = memTrackMalloc(((size_t)num_rows + 1) * sizeof(int));
+    store->layouts_capacity = 8;
+    store->layout_start = memTrackMalloc((size_t)store->layouts_capacity * sizeof(int));
+    if (!store->ids || !store->row_layout || !store->layout_start) {
+        perror("Memory allocation failed for column store");
+        freeColumnStore(store);
+        return NULL;
+    }
+    for (int i = 0; i < num_rows; ++i) {
+        store->ids[i] = -1;
+        store->row_layout[i] = -1;
+    }
+    store->layout_start[0] = 0;
+    return store;
+}
+
+// Allocate the arrays a column of the given type needs
+static int allocateColumn(Column *column, ColumnType type, int num_rows) {
+    column->type = type;
+    if (type == COLUMN_NUMBER) {
+        column->numbers = memTrackMalloc(((size_t)num_rows + 1) * sizeof(double));
+        return column->numbers != NULL;
+    }
+    if (type == COLUMN_STRING) {
+        column->offsets = memTrackMalloc(((size_t)num_rows + 1) * sizeof(size_t));
+        column->blob_capacity = 256;
+        column->blob = memTrackMalloc(column->blob_capacity);
+        column->blob_length = 0;
+        column->filled_rows = 0;
+        return column->offsets != NULL && column->blob != NULL;
+    }
+    column->values = memTrackMalloc(((size_t)num_rows + 1) * sizeof(Value));
+    if (!column->values) return 0;
+    memset(column->values, 0, ((size_t)num_rows + 1) * sizeof(Value)); // all VALUE_NULL
+    return 1;
+}
+
+static void releaseColumnData(Column *column, int num_rows) {
+    if (column->values) {
+        for (int i = 0; i < num_rows; ++i) {
+            freeValue(&column->values[i]);
+        }
+    }
+    memTrackFree(column->numbers);
+    memTrackFree(column->offsets);
+    memTrackFree(column->blob);
+    memTrackFree(column->values);
+    column->numbers = NULL;
+    column->offsets = NULL;
+    column->blob = NULL;
+    column->values = NULL;
+}
+
+// Column for key_id, created on first use with the type of its first value
+static Column *columnFor(ColumnStore *store, int key_id, ColumnType type) {
+    if (key_id >= store->keys_capacity) {
+        int capacity = store->keys_capacity ? store->keys_capacity : 16;
+        while (capacity <= key_id) {
+            capacity *= 2;
+        }
+        int *column_of_key = memTrackRealloc(store->column_of_key, (size_t)capacity * sizeof(int));
+        if (!column_of_key) return NULL;
+        for (int i = store->keys_capacity; i < capacity; ++i) {
+            column_of_key[i] = -1;
+        }
+        store->column_of_key = column_of_key;
+        store->keys_capacity = capacity;
+    }
+    if (store->column_of_key[key_id] >= 0) {
+        return &store->columns[store->column_of_key[key_id]];
+    }
+
+    if (store->num_columns == store->columns_capacity) {
+        int capacity = store->columns_capacity ? store->columns_capacity * 2 : 8;
+        Column *columns = memTrackRealloc(store->columns, (size_t)capacity * sizeof(Column));
+        if (!columns) return NULL;
+        store->columns = columns;
+        store->columns_capacity = capacity;
+    }
+
+    Column *column = &store->columns[store->num_columns];
+    memset(column, 0, sizeof(*column));
+    column->key_id = key_id;
+    column->valid = memTrackMalloc(BITMAP_BYTES(store->num_rows) + 1);
+    column->nulls = memTrackMalloc(BITMAP_BYTES(store->num_rows) + 1);
+    if (!column->valid || !column->nulls || !allocateColumn(column, type, store->num_rows)) {
+        releaseColumnData(column, store->num_rows);
+        memTrackFree(column->valid);
+        memTrackFree(column->nulls);
+        return NULL;
+    }
+    memset(column->valid, 0, BITMAP_BYTES(store->num_rows) + 1);
+    memset(column->nulls, 0, BITMAP_BYTES(store->num_rows) + 1);
+
+    store->column_of_key[key_id] = store->num_columns++;
+    return column;
+}
+
+// Set the offsets of the rows before row, which have no string
+static void fillOffsets(Column *column, int row) {
+    while (column->filled_rows <= row) {
+        column->offsets[column->filled_rows++] = column->blob_length;
+    }
+}
+
+static int appendString(Column *column, int row, const char *text) {
+    size_t length = strlen(text) + 1;
+    if (column->blob_length + length > column->blob_capacity) {
+        size_t capacity = column->blob_capacity * 2;
+        while (capacity < column->blob_length + length) {
+            capacity *= 2;
+        }
+        char *blob = memTrackRealloc(column->blob, capacity);
+        if (!blob) return 0;
+        column->blob = blob;
+        column->blob_capacity = capacity;
+    }
+
+    fillOffsets(column, row);
+    memcpy(column->blob + column->blob_length, text, length);
+    column->blob_length += length;
+    column->offsets[row + 1] = column->blob_length;
+    column->filled_rows = row + 1;
+    return 1;
+}
+
+// A value that does not fit the column type turns it into a generic column.
+// Before the first value the column just takes the new type.
+static int convertColumn(Column *column, ColumnType type, int num_rows) {
+    int has_values = 0;
+    for (size_t i = 0; i < BITMAP_BYTES(num_rows) && !has_values; ++i) {
+        has_values = column->valid[i] != 0;
+    }
+
+    Column converted = *column;
+    converted.numbers = NULL;
+    converted.offsets = NULL;
+    converted.blob = NULL;
+    converted.values = NULL;
+    if (!allocateColumn(&converted, has_values ? COLUMN_VALUE : type, num_rows)) {
+        releaseColumnData(&converted, num_rows);
+        return 0;
+    }
+
+    for (int row = 0; has_values && row < num_rows; ++row) {
+        if (!columnIsValid(column, row)) continue;
+        if (column->type == COLUMN_NUMBER) {
+            converted.values[row] = numberValue(column->numbers[row]);
+        } else if (column->type == COLUMN_STRING) {
+            stringValue(columnString(column, row), &converted.values[row]);
+        }
+    }
+
+    releaseColumnData(column, num_rows);
+    *column = converted;
+    return 1;
+}
+
+// Collect the column of the next key of the row being set behind the layouts
+static int appendLayoutColumn(ColumnStore *store, int column_index) {
+    if (store->layout_length == store->layout_capacity) {
+        int capacity = store->layout_capacity ? store->layout_capacity * 2 : 64;
+        int *columns = memTrackRealloc(store->layout_columns, (size_t)capacity * sizeof(int));
+        if (!columns) return 0;
+        store->layout_columns = columns;
+        store->layout_capacity = capacity;
+    }
+    store->layout_columns[store->layout_length++] = column_index;
+    return 1;
+}
+
+// Give row the key order collected since start. Most rows repeat the order of the row
+// before, then the collected columns are dropped again and the last layout is reused.
+static int finishRowLayout(ColumnStore *store, int row, int start) {
+    int length = store->layout_length - start;
+    if (length == 0) {
+        store->row_layout[row] = -1;
+        return 1;
+    }
+
+    if (store->num_layouts > 0) {
+        int last = store->num_layouts - 1;
+        int last_begin = store->layout_start[last];
+        if (start - last_begin == length &&
+            memcmp(store->layout_columns + last_begin, store->layout_columns + start, (size_t)length * sizeof(int)) == 0) {
+            store->layout_length = start;
+            store->row_layout[row] = last;
+            return 1;
+        }
+    }
+
+    if (store->num_layouts + 2 > store->layouts_capacity) {
+        int capacity = store->layouts_capacity * 2;
+        int *layout_start = memTrackRealloc(store->layout_start, (size_t)capacity * sizeof(int));
+        if (!layout_start) return 0;
+        store->layout_start = layout_start;
+        store->layouts_capacity = capacity;
+    }
+    store->layout_start[store->num_layouts] = start;
+    store->layout_start[store->num_layouts + 1] = store->layout_length;
+    store->row_layout[row] = store->num_layouts++;
+    return 1;
+}
+
+// Store one person, rows of string columns have to be set in increasing order.
+// Strings and nested values are moved out of person_json.
+int columnStoreSetRow(ColumnStore *store, int row, cJSON *person_json) {
+    if (row < 0 || row >= store->num_rows || !person_json) return 0;
+
+    cJSON *id_item = cJSON_GetObjectItem(person_json, "id");
+    store->ids[row] = (id_item != NULL && cJSON_IsNumber(id_item)) ? id_item->valueint : -1;
+
+    // The key order of this row is collected behind the layouts of the rows before
+    int layout_begin = store->layout_length;
+
+    cJSON *item = person_json->child;
+    while (item) {
+        // Nested values are detached from the list, so step on first
+        cJSON *next = item->next;
+        if (strcmp(item->string, "id") == 0) {
+            item = next;
+            continue;
+        }
+
+        // A null only marks the row, the column keeps the type of its values
+        int is_null = cJSON_IsNull(item);
+        ColumnType type = cJSON_IsNumber(item) ? COLUMN_NUMBER : cJSON_IsString(item) ? COLUMN_STRING : COLUMN_VALUE;
+        Column *column = columnFor(store, internKey(item->string), is_null ? COLUMN_NUMBER : type);
+        if (!column || (!is_null && column->type != type && column->type != COLUMN_VALUE &&
+                        !convertColumn(column, type, store->num_rows))) {
+            perror("Memory allocation failed for column");
+            return 0;
+        }
+
+        // A key that occurs twice keeps its first place in the order
+        if (!columnIsValid(column, row) && !columnIsNull(column, row) &&
+            !appendLayoutColumn(store, (int)(column - store->columns))) {
+            perror("Memory allocation failed for column");
+            return 0;
+        }
+        if (is_null) {
+            setNull(column, row);
+            item = next;
+            continue;
+        }
+
+        if (column->type == COLUMN_NUMBER) {
+            column->numbers[row] = item->valuedouble;
+        } else if (column->type == COLUMN_STRING) {
+            if (!appendString(column, row, item->valuestring)) {
+                perror("Memory allocation failed for column");
+                return 0;
+            }
+        } else {
+            freeValue(&column->values[row]);
+            column->values[row] = valueFromJSON(person_json, item, NULL);
+        }
+        setValid(column, row);
+        item = next;
+    }
+
+    if (!finishRowLayout(store, row, layout_begin)) {
+        perror("Memory allocation failed for column");
+        return 0;
+    }
+    return 1;
+}
+
+// Complete the offsets of string columns after the last row was set
+void columnStoreFinish(ColumnStore *store) {
+    for (int i = 0; i < store->num_columns; ++i) {
+        if (store->columns[i].type == COLUMN_STRING) {
+            fillOffsets(&store->columns[i], store->num_rows);
+        }
+    }
+}
+
+void freeColumnStore(ColumnStore *store) {
+    if (!store) return;
+    for (int i = 0; i < store->num_columns; ++i) {
+        releaseColumnData(&store->columns[i], store->num_rows);
+        memTrackFree(store->columns[i].valid);
+        memTrackFree(store->columns[i].nulls);
+    }
+    memTrackFree(store->columns);
+    memTrackFree(store->column_of_key);
+    memTrackFree(store->ids);
+    memTrackFree(store->row_layout);
+    memTrackFree(store->layout_columns);
+    memTrackFree(store->layout_start);
+    memTrackFree(store);
+}
+
+const Column *findColumn(const ColumnStore *store, const char *key) {
+    int key_id = findKeyID(key);
+    if (key_id < 0 || key_id >= store->keys_capacity || store->column_of_key[key_id] < 0) {
+        return NULL;
+    }
+    return &store->columns[store->column_of_key[key_id]];
+}
+
+static void addToStats(ColumnStats *stats, double number) {
+    if (stats->count == 0 || number < stats->min) stats->min = number;
+    if (stats->count == 0 || number > stats->max) stats->max = number;
+    stats->sum += number;
+    stats->count++;
+}
+
+// Count, sum, min, max and mean of the numbers stored under key.
+// Returns 0 when there is no such column or it holds strings.
+int columnStats(const ColumnStore *store, const char *key, ColumnStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    const Column *column = findColumn(store, key);
+    if (!column || column->type == COLUMN_STRING) return 0;
+
+    if (column->type == COLUMN_NUMBER) {
+        // One pass over the doubles, whole bitmap bytes at a time
+        int row = 0;
+        for (size_t byte = 0; byte < BITMAP_BYTES(store->num_rows); ++byte, row += 8) {
+            unsigned char bits = column->valid[byte];
+            if (bits == 0xFF) {
+                for (int i = row; i < row + 8; ++i) {
+                    addToStats(stats, column->numbers[i]);
+                }
+            } else {
+                for (int i = row; bits; ++i, bits >>= 1) {
+                    if (bits & 1) addToStats(stats, column->numbers[i]);
+                }
+            }
+        }
+    } else {
+        for (int row = 0; row < store->num_rows; ++row) {
+            const Value *value = &column->values[row];
+            if (value->type == VALUE_INT) {
+                addToStats(stats, (double)value->as.integer);
+            } else if (value->type == VALUE_DOUBLE) {
+                addToStats(stats, value->as.number);
+            }
+        }
+    }
+
+    if (stats->count > 0) {
+        stats->mean = stats->sum / stats->count;
+    }
+    return 1;
+}
+
+// One cell as saveData writes the value it would have loaded into a Person
+static void writeCell(JsonWriter *writer, const Column *column, int row) {
+    if (!columnIsValid(column, row)) {
+        jsonWriteRaw(writer, "null", 4);
+    } else if (column->type == COLUMN_NUMBER) {
+        jsonWriteDouble(writer, column->numbers[row]);
+    } else if (column->type == COLUMN_STRING) {
+        jsonWriteString(writer, columnString(column, row));
+    } else {
+        writeValueJSON(writer, &column->values[row], 3);
+    }
+}
+
+// Write the store in the same format as saveData: every row with its keys in the order
+// they were loaded, nulls included. Rows are streamed through a JsonWriter, so saving
+// needs no more memory than its buffer.
+int saveColumns(const char *filename, const ColumnStore *store) {
+    FILE *output_file = fopen(filename, "w");
+    if (output_file == NULL) {
+        fprintf(stderr, "Error when trying to open file for writing.\n");
+        return 0;
+    }
+
+    JsonWriter writer;
+    if (!jsonWriterOpen(&writer, output_file, NULL)) {
+        fclose(output_file);
+        return 0;
+    }
+
+    jsonWriteRaw(&writer, "{\n\t\"people\":\t[", 14);
+    for (int row = 0; row < store->num_rows; ++row) {
+        if (row > 0) {
+            jsonWriteRaw(&writer, ", ", 2);
+        }
+        jsonWriteRaw(&writer, "{\n\t\t\t\"id\":\t", 11);
+        jsonWriteInteger(&writer, store->ids[row]);
+
+        int layout = store->row_layout[row];
+        if (layout >= 0) {
+            for (int i = store->layout_start[layout]; i < store->layout_start[layout + 1]; ++i) {
+                const Column *column = &store->columns[store->layout_columns[i]];
+                jsonWriteRaw(&writer, ",\n\t\t\t", 5);
+                jsonWriteString(&writer, keyName(column->key_id));
+                jsonWriteRaw(&writer, ":\t", 2);
+                writeCell(&writer, column, row);
+            }
+        }
+        jsonWriteRaw(&writer, "\n\t\t}", 4);
+    }
+    jsonWriteRaw(&writer, "]\n}", 3);
+
+    int written = jsonWriterClose(&writer);
+    if (fclose(output_file) != 0) {
+        written = 0;
+    }
+    if (!written) {
+        fprintf(stderr, "Error when trying to write into file.\n");
+    }
+    return written;
+}
@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../inc/fileInput.h"
+#include "../inc/memTrack.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define READ_CHUNK_SIZE (64 * 1024)
+
+
+// Read everything from a stream into a NUL-terminated heap buffer
+static int readStream(FILE *stream, FileContent *file) {
+    size_t capacity = READ_CHUNK_SIZE;
+    size_t length = 0;
+    char *content = memTrackMalloc(capacity + 1);
+    if (!content) {
+        perror("Memory allocation failed for file content");
+        return 0;
+    }
+
+    // Pipes have no size, so keep reading until EOF and grow as needed
+    for (;;) {
+        if (length == capacity) {
+            char *bigger = memTrackRealloc(content, capacity * 2 + 1);
+            if (!bigger) {
+                perror("Memory allocation failed for file content");
+                memTrackFree(content);
+                return 0;
+            }
+            content = bigger;
+            capacity *= 2;
+        }
+
+        size_t read = fread(content + length, 1, capacity - length, stream);
+        length += read;
+        if (read == 0) break;
+    }
+
+    if (ferror(stream)) {
+        fprintf(stderr, "Error when reading file content.\n");
+        memTrackFree(content);
+        return 0;
+    }
+
+    content[length] = '\0'; // add null terminator
+    file->content = content;
+    file->length = length;
+    file->mapped = 0;
+    return 1;
+}
+
+// The original path: one malloc of the file size and one fread
+static int readFile(const char *filename, FileContent *file) {
+    FILE *stream = fopen(filename, "r");
+    if (!stream) {
+        fprintf(stderr, "Error occurred when trying to open file '%s'.\n", filename);
+        return 0;
+    }
+
+    long file_size = -1;
+    if (fseek(stream, 0, SEEK_END) == 0) { // Move pointer to end
+        file_size = ftell(stream); // get file size
+        rewind(stream); // move pointer to beginning
+    }
+
+    if (file_size < 0) {
+        // Not seekable (pipe, terminal), fall back to reading in chunks
+        int ok = readStream(stream, file);
+        fclose(stream);
+        return ok;
+    }
+
+    char *content = memTrackMalloc((size_t)file_size + 1);
+    if (!content) {
+        perror("Memory allocation failed for file content");
+        fclose(stream);
+        return 0;
+    }
+
+    size_t length = fread(content, 1, (size_t)file_size, stream); // read content to memory
+    fclose(stream);
+
+    content[length] = '\0'; // add null terminator
+    file->content = content;
+    file->length = length;
+    file->mapped = 0;
+    return 1;
+}
+
+#ifndef _WIN32
+// Map a regular file read-only, returns -1 when the file cannot be mapped and should be read instead
+static int mapFile(const char *filename, FileContent *file) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error occurred when trying to open file '%s'.\n", filename);
+        return 0;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) {
+        // Pipes, devices and empty files go through the read path
+        close(fd);
+        return -1;
+    }
+
+    void *content = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping stays valid without the descriptor
+    if (content == MAP_FAILED) {
+        return -1;
+    }
+
+    // The parser walks the file front to back exactly once
+    madvise(content, (size_t)info.st_size, MADV_SEQUENTIAL);
+    madvise(content, (size_t)info.st_size, MADV_WILLNEED);
+
+    file->content = content;
+    file->length = (size_t)info.st_size;
+    file->mapped = 1;
+    return 1;
+}
+#endif
+
+// Get the whole content of filename, mapped if requested and possible
+int openFileContent(const char *filename, int use_mmap, FileContent *file) {
+    file->content = NULL;
+    file->length = 0;
+    file->mapped = 0;
+
+#ifndef _WIN32
+    if (use_mmap) {
+        int mapped = mapFile(filename, file);
+        if (mapped >= 0) {
+            return mapped;
+        }
+    }
+#else
+    (void)use_mmap;
+#endif
+
+    return readFile(filename, file);
+}
+
+// Release the content obtained by openFileContent
+void closeFileContent(FileContent *file) {
+    if (!file->content) return;
+
+#ifndef _WIN32
+    if (file->mapped) {
+        munmap(file->content, file->length);
+    } else {
+        memTrackFree(file->content);
+    }
+#else
+    memTrackFree(file->content);
+#endif
+
+    file->content = NULL;
+    file->length = 0;
+    file->mapped = 0;
+}
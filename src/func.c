@@ -1,101 +1,250 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 #include "../cJSON/cJSON.h"
+#include "../inc/func.h"
+#include "../inc/fileInput.h"
+#include "../inc/jsonStream.h"
+#include "../inc/jsonIndex.h"
+#include "../inc/jsonWriter.h"
+#include "../inc/personIndex.h"
+#include "../inc/keyTable.h"
+#include "../inc/memTrack.h"
 
-// Structure to represent dynamic key-value pairs
-typedef struct KeyValue {
-    char *key;
-    char *value;
-    struct KeyValue *next;
-} KeyValue;
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
-// Structure to represent a person
-typedef struct {
-    int id;         
-    KeyValue *data;  
-} Person;
+#define PARALLEL_MAX_THREADS 64
+#define PARALLEL_MIN_SHARE (1024 * 1024)   // with an automatic thread count, smaller pieces get no thread of their own
 
 
 
+// Add a new key-value pair to the list, the value is stored as a string
+int addKeyValue(KeyValueList *list, const char *key, const char *value) {
+    if (!key || !value) return 0;
 
-// Add a new key-value pair to the linked list
-int addKeyValue(KeyValue **list, const char *key, const char *value) {
-    // Allocate memory for a new KeyValue node
-    KeyValue *newNode = malloc(sizeof(KeyValue));
-    if (!newNode) {
-        perror("Memory allocation failed for new KeyValue node");
+    Value string;
+    if (!stringValue(value, &string)) {
         return 0;
     }
+    return addTypedKeyValue(list, key, string);
+}
+
+// Add a new key-value pair to the list, taking over what the value owns
+int addTypedKeyValue(KeyValueList *list, const char *key, Value value) {
+    // The key is stored once in the key table, the pair only keeps its id
+    return addKeyIDValue(list, internKey(key), value);
+}
 
-    // Allocate memory for the key and value strings
-    newNode->key = strdup(key);                 // strdup = duplicates a string
-    newNode->value = strdup(value);
-    if (!newNode->key || !newNode->value) {
-        perror("Memory allocation failed for key or value string");
-        free(newNode->key);
-        free(newNode->value);
-        free(newNode);
+// Append a key-value pair for an already interned key, taking over what the value owns
+int addKeyIDValue(KeyValueList *list, int key_id, Value value) {
+    if (key_id < 0) {
+        freeValue(&value);
         return 0;
     }
 
-    newNode->next = *list;
-    *list = newNode;
+    // Grow geometrically, so appending stays cheap
+    if (list->count == list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : 4;
+        KeyValue *items = memTrackRealloc(list->items, (size_t)capacity * sizeof(KeyValue));
+        if (!items) {
+            perror("Memory allocation failed for key-value pairs");
+            freeValue(&value);
+            return 0;
+        }
+        list->items = items;
+        list->capacity = capacity;
+    }
 
+    list->items[list->count].key_id = key_id;
+    list->items[list->count].value = value;
+    list->count++;
     return 1;
 }
 
-// Release memory allocated for the linked list
-void freeKeyValueList(KeyValue **list) {
-    if (!list || !*list) return;
-    while (*list) {
-        KeyValue *temp = *list;
-        *list = (*list)->next;
-        free(temp->key);
-        free(temp->value);
-        free(temp);
-    }
-    *list = NULL;
+// Find the pair stored under key_id. People have a handful of keys, so a linear
+// scan over the contiguous ids is faster than anything with an index.
+KeyValue *findKeyValue(const KeyValueList *list, int key_id) {
+    for (int i = 0; i < list->count; ++i) {
+        if (list->items[i].key_id == key_id) {
+            return &list->items[i];
+        }
+    }
+    return NULL;
+}
+
+// Release memory allocated for the list
+void freeKeyValueList(KeyValueList *list) {
+    if (!list) return;
+    for (int i = 0; i < list->count; ++i) {
+        freeValue(&list->items[i].value);
+    }
+    memTrackFree(list->items);
+    list->items = NULL;
+    list->count = 0;
+    list->capacity = 0;
 }
 
 
-// Function to load data from a file and parse it into memory
-Person *loadData(const char *filename, int *num_people) {
-    // File Opening and Reading
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        fprintf(stderr, "Error occurred when trying to open file '%s'.\n", filename);
-        return NULL;
+// Make room for capacity pairs in the arena of a person. The old array stays in the
+// arena, so loading reserves the exact number up front.
+static int reservePersonData(Person *person, int capacity) {
+    if (capacity <= person->data.capacity) return 1;
+
+    KeyValue *items = arenaAlloc(person->arena, (size_t)capacity * sizeof(KeyValue));
+    if (!items) return 0;
+    if (person->data.count > 0) {
+        memcpy(items, person->data.items, (size_t)person->data.count * sizeof(KeyValue));
     }
+    person->data.items = items;
+    person->data.capacity = capacity;
+    return 1;
+}
 
-    fseek(file, 0, SEEK_END); // Move pointer to end
-    long file_size = ftell(file); // get file size
-    rewind(file); // move pointer to beginning
+// Append a pair whose value already belongs to the person's arena. On failure the
+// value is simply left to the arena.
+static int storeArenaKeyValue(Person *person, int key_id, Value value) {
+    int has_room = person->data.count < person->data.capacity ||
+                   reservePersonData(person, person->data.capacity ? person->data.capacity * 2 : 4);
+    if (key_id < 0 || !has_room) {
+        return 0;
+    }
 
-    char *file_content = malloc(file_size + 1);
-    if (!file_content) {
-        perror("Memory allocation failed for file content");
-        fclose(file);
-        return NULL;
+    person->data.items[person->data.count].key_id = key_id;
+    person->data.items[person->data.count].value = value;
+    person->data.count++;
+    return 1;
+}
+
+// Add a new key-value pair to a person. People with an arena get the pair and the
+// value from it, others from the heap like addKeyIDValue.
+int addPersonKeyValue(Person *person, int key_id, Value value) {
+    if (!person->arena) {
+        return addKeyIDValue(&(person->data), key_id, value);
     }
 
-    fread(file_content, 1, file_size, file); // read content to memory
-    fclose(file);
+    if (key_id < 0 || !moveValueToArena(person->arena, &value)) {
+        freeValue(&value);
+        return 0;
+    }
+    return storeArenaKeyValue(person, key_id, value);
+}
 
-    file_content[file_size] = '\0'; // add null terminator
+// Drop the data of one person. Arena data goes with the arena once nobody uses it.
+static void freePersonData(Person *person) {
+    if (person->arena) {
+        memset(&person->data, 0, sizeof(person->data));
+        arenaRelease(person->arena);
+        person->arena = NULL;
+    } else {
+        freeKeyValueList(&person->data);
+    }
+}
+
+// Fill a person from its JSON object. Strings are copied into the arena and nested
+// values handed over to it instead of being printed and copied. Loader threads pass
+// their key cache, everyone else NULL.
+static void personFromJSON(Person *person, cJSON *person_json, Arena *arena, KeyCache *keys) {
+    // Initialize the key-value pairs
+    memset(&person->data, 0, sizeof(person->data));
+    person->arena = arenaRetain(arena);
+
+    // Set the person's identifier (id)
+    cJSON *id_item = cJSON_GetObjectItem(person_json, "id");
+    person->id = (id_item != NULL && cJSON_IsNumber(id_item)) ? id_item->valueint : -1; //set person id
+
+    // All pairs of the person in one block, in file order
+    reservePersonData(person, cJSON_GetArraySize(person_json));
+
+    // Iterate through all items in the person's JSON object
+    cJSON *item = person_json ? person_json->child : NULL;
+    for (int position = 0; item; ++position) {
+        // Nested values are detached from the list, so step on first
+        cJSON *next = item->next;
+
+        // Exclude the "id" field from being added to the pairs
+        if (strcmp(item->string, "id") != 0) {
+            // Add key-value pair to the pairs, the value goes straight into the arena
+            int key_id = keys ? internKeyCached(keys, position, item->string) : internKey(item->string);
+            if (person->arena) {
+                storeArenaKeyValue(person, key_id, valueFromJSON(person_json, item, person->arena));
+            } else {
+                addKeyIDValue(&person->data, key_id, valueFromJSON(person_json, item, NULL));
+            }
+        }
+        item = next;
+    }
+}
+
+// Function to load data from a file and parse it into memory
+Person *loadData(const char *filename, int *num_people) {
+    LoadOptions options = { LOAD_INPUT_MMAP, LOAD_ENGINE_CJSON };
+    return loadDataWithOptions(filename, num_people, &options);
+}
+
+// Read the file the way options ask for and parse it, NULL on errors. cJSON takes the
+// tree from context, so freeDataTree drops it without walking it. The strings of an in
+// situ tree point into file, which stays open until then.
+static cJSON *parseDataFile(const char *filename, const LoadOptions *options, cJSON_Context *context, FileContent *file) {
+    // File Opening and Reading. In situ parsing writes terminators into the content, so it
+    // gets a heap buffer of its own: a mapping would be copied page by page as it is written.
+    int use_mmap = options->input == LOAD_INPUT_MMAP && options->engine != LOAD_ENGINE_CJSON_IN_SITU;
+    if (!openFileContent(filename, use_mmap, file)) {
+        return NULL;
+    }
 
-    printf("File content: %s\n", file_content);
+    printf("File content: ");
+    fwrite(file->content, 1, file->length, stdout);
+    printf("\n");
 
-    // JSON Parsing
-    cJSON *json = cJSON_Parse(file_content); // parse json content
-    free(file_content); // free memory for content
+    // JSON Parsing, the length is known so the parser does not need a terminator or strlen
+    cJSON *json = NULL;
+    const char *error_ptr = NULL;
+    if (options->engine == LOAD_ENGINE_INDEXED) {
+        size_t error_offset = 0;
+        json = parseJsonIndexed(file->content, file->length, &error_offset);
+        error_ptr = file->content + error_offset;
+    } else {
+        // Numbers are not packed (CJSON_PARSE_PACK_NUMBERS): subtrees become VALUE_JSON values
+        // whose callers walk the items of arrays, which a packed array does not have
+        int flags = options->engine == LOAD_ENGINE_CJSON_IN_SITU ? CJSON_PARSE_IN_SITU : 0;
+        json = cJSON_ParseWithContext(context, file->content, file->length, NULL, flags); // parse json content
+        error_ptr = cJSON_GetErrorPtr();
+    }
 
     if (!json) {
-        const char *error_ptr = cJSON_GetErrorPtr();
         if (error_ptr) {
-            fprintf(stderr, "Error before: %s\n", error_ptr);
+            // A mapped file has no terminator, so stop at its end
+            fprintf(stderr, "Error before: ");
+            fwrite(error_ptr, 1, file->length - (size_t)(error_ptr - file->content), stderr);
+            fprintf(stderr, "\n");
         }
         fprintf(stderr, "Error when parsing JSON.\n");
+    }
+    if (!json || options->engine != LOAD_ENGINE_CJSON_IN_SITU) {
+        closeFileContent(file); // free memory for content
+    }
+    return json;
+}
+
+// Free a tree from parseDataFile, its context and the file content it may point into
+static void freeDataTree(cJSON *json, cJSON_Context *context, FileContent *file) {
+    if (json && !(json->type & cJSON_IsPooled)) {
+        cJSON_Delete(json);
+    }
+    cJSON_DeleteContext(context);
+    closeFileContent(file);
+}
+
+// Function to load data with an explicit choice of how the file is read
+Person *loadDataWithOptions(const char *filename, int *num_people, const LoadOptions *options) {
+    FileContent file = { NULL, 0, 0 };
+    cJSON_Context *context = cJSON_CreateContext();
+    cJSON *json = context ? parseDataFile(filename, options, context, &file) : NULL;
+    if (!json) {
+        cJSON_DeleteContext(context);
         return NULL;
     }
 
@@ -103,99 +252,450 @@ Person *loadData(const char *filename, int *num_people) {
     cJSON *people_array = cJSON_GetObjectItem(json, "people"); // get people array
     if (!people_array || !cJSON_IsArray(people_array)) {
         fprintf(stderr, "Invalid or missing 'people' array in JSON.\n");
-        cJSON_Delete(json);
+        freeDataTree(json, context, &file);
         return NULL;
     }
 
     *num_people = cJSON_GetArraySize(people_array); // get number of people in the array
 
     // Memory Allocation
-    Person *people = malloc((*num_people) * sizeof(Person)); // allocate memory for array of people
+    Person *people = memTrackMalloc((*num_people) * sizeof(Person)); // allocate memory for array of people
 
     if (!people) {
         fprintf(stderr, "Memory allocation failed.\n");
-        cJSON_Delete(json);
+        freeDataTree(json, context, &file);
         return NULL;
     }
 
-    // Data Population
+    // All attributes of the dataset are allocated from one arena
+    Arena *arena = arenaRetain(arenaCreate());
+    if (!arena) {
+        memTrackFree(people);
+        freeDataTree(json, context, &file);
+        return NULL;
+    }
+
+    // Data Population, one pass over the child list instead of cJSON_GetArrayItem(i) from the head every time
+    cJSON_ArrayCursor cursor;
+    cJSON_ArrayCursorInit(&cursor, people_array);
     for (int i = 0; i < *num_people; ++i) {
-        cJSON *person_json = cJSON_GetArrayItem(people_array, i); // get json object for each person
-
-        // Initialize a linked list for key-value pairs
-        people[i].data = NULL;
-
-        // Set the person's identifier (id)
-        cJSON *id_item = cJSON_GetObjectItem(person_json, "id");
-        people[i].id = (id_item != NULL && cJSON_IsNumber(id_item)) ? id_item->valueint : -1; //set person id
-
-        // Iterate through all items in the person's JSON object
-        cJSON *item = NULL;
-        cJSON_ArrayForEach(item, person_json) {
-            // Exclude the "id" field from being added to the linked list
-            if (strcmp(item->string, "id") != 0) {
-                // Add key-value pair to the linked list
-                addKeyValue(&(people[i].data), item->string, cJSON_Print(item));
+        cJSON *person_json = cJSON_ArrayCursorNext(&cursor); // get json object for each person
+        personFromJSON(&people[i], person_json, arena, NULL);
+    }
+    arenaRelease(arena); // now owned by the people
+
+    // Cleanup
+    freeDataTree(json, context, &file);
+    return people;
+}
+
+// Function to load data column by column for scans over single attributes
+ColumnStore *loadDataColumnar(const char *filename) {
+    LoadOptions options = { LOAD_INPUT_MMAP, LOAD_ENGINE_CJSON };
+    FileContent file = { NULL, 0, 0 };
+    cJSON_Context *context = cJSON_CreateContext();
+    cJSON *json = context ? parseDataFile(filename, &options, context, &file) : NULL;
+    if (!json) {
+        cJSON_DeleteContext(context);
+        return NULL;
+    }
+
+    cJSON *people_array = cJSON_GetObjectItem(json, "people");
+    if (!people_array || !cJSON_IsArray(people_array)) {
+        fprintf(stderr, "Invalid or missing 'people' array in JSON.\n");
+        freeDataTree(json, context, &file);
+        return NULL;
+    }
+
+    ColumnStore *store = createColumnStore(cJSON_GetArraySize(people_array));
+    if (!store) {
+        freeDataTree(json, context, &file);
+        return NULL;
+    }
+
+    // Every person is written straight into the columns, no Person is built
+    cJSON_ArrayCursor cursor;
+    cJSON_ArrayCursorInit(&cursor, people_array);
+    for (int row = 0; row < store->num_rows; ++row) {
+        if (!columnStoreSetRow(store, row, cJSON_ArrayCursorNext(&cursor))) {
+            freeColumnStore(store);
+            freeDataTree(json, context, &file);
+            return NULL;
+        }
+    }
+    columnStoreFinish(store);
+
+    freeDataTree(json, context, &file);
+    return store;
+}
+
+// Function to load data one person at a time without building the whole document
+Person *loadDataStreaming(const char *filename, int *num_people) {
+    JsonStream stream;
+    if (!jsonStreamOpen(&stream, filename)) {
+        return NULL;
+    }
+
+    if (!jsonStreamEnterArray(&stream, "people")) {
+        fprintf(stderr, "Invalid or missing 'people' array in JSON.\n");
+        jsonStreamClose(&stream);
+        return NULL;
+    }
+
+    int count = 0;
+    int capacity = 16;
+    Person *people = memTrackMalloc(capacity * sizeof(Person));
+    Arena *arena = arenaRetain(arenaCreate());
+    cJSON_Context *context = cJSON_CreateContext();
+    if (!people || !arena || !context) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        memTrackFree(people);
+        arenaRelease(arena);
+        cJSON_DeleteContext(context);
+        jsonStreamClose(&stream);
+        return NULL;
+    }
+
+    // Only the current record is parsed, so memory is bounded by the largest one, and
+    // every record reuses the memory of the context
+    const char *text = NULL;
+    size_t length = 0;
+    int status;
+    while ((status = jsonStreamNextValue(&stream, &text, &length)) == 1) {
+        cJSON_ResetContext(context);
+        cJSON *person_json = cJSON_ParseWithContext(context, text, length, NULL, 0);
+        if (!person_json) {
+            status = -1;
+            break;
+        }
+
+        if (count == capacity) {
+            Person *bigger = memTrackRealloc(people, (size_t)capacity * 2 * sizeof(Person));
+            if (!bigger) {
+                fprintf(stderr, "Memory allocation failed.\n");
+                status = -1;
+                break;
             }
+            people = bigger;
+            capacity *= 2;
         }
+
+        personFromJSON(&people[count++], person_json, arena, NULL);
     }
+    cJSON_DeleteContext(context);
+    jsonStreamClose(&stream);
+    arenaRelease(arena); // now owned by the people
 
-    // Cleanup
-    cJSON_Delete(json);
+    if (status < 0) {
+        fprintf(stderr, "Error when parsing JSON.\n");
+        for (int i = 0; i < count; ++i) {
+            freePersonData(&people[i]);
+        }
+        memTrackFree(people);
+        return NULL;
+    }
+
+    // Give back the unused tail of the array
+    if (count > 0 && count < capacity) {
+        Person *shrunk = memTrackRealloc(people, (size_t)count * sizeof(Person));
+        if (shrunk) people = shrunk;
+    }
+
+    *num_people = count;
+    return people;
+}
+
+// One loader thread's piece of the document and the people parsed from it
+typedef struct {
+    const char *text;       // the whole document
+    size_t length;
+    size_t start, end;      // the piece, elements whose separator lies in it belong to this thread
+    int first;              // the piece starts right after the array's '['
+    JsonChunkSummary summary;
+    int in_string;          // where the piece starts, from the summaries of the pieces before
+    long depth;
+    Person *people;
+    int count;
+    int capacity;
+    int failed;
+} LoadShare;
+
+// Pass 1: quote parity and bracket balance of the piece
+static void *summarizeShare(void *arg) {
+    LoadShare *share = arg;
+    jsonSummarizeChunk(share->text + share->start, share->end - share->start, &share->summary);
+    return NULL;
+}
+
+static size_t skipWhitespace(const char *text, size_t length, size_t pos) {
+    while (pos < length && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) {
+        pos++;
+    }
+    return pos;
+}
+
+// Pass 2: parse every element of the people array whose separator lies in the piece.
+// The last one may reach into the next piece, which then starts at the separator after it.
+static void *parseShare(void *arg) {
+    LoadShare *share = arg;
+    const char *text = share->text;
+    size_t pos = share->start;
+    KeyCache keys;
+    memset(&keys, 0, sizeof(keys));
+
+    if (!share->first) {
+        if (share->start >= share->end) return NULL; // the array ended before this piece
+        long separator = jsonFindSeparator(text + share->start, share->end - share->start, share->in_string, share->depth);
+        if (separator < 0) return NULL;
+        pos = share->start + (size_t)separator + 1;
+    } else {
+        pos = skipWhitespace(text, share->length, pos);
+        if (pos < share->length && text[pos] == ']') return NULL; // empty array
+    }
+
+    Arena *arena = arenaRetain(arenaCreate());
+    cJSON_Context *context = cJSON_CreateContext();
+    if (!arena || !context) {
+        arenaRelease(arena);
+        cJSON_DeleteContext(context);
+        share->failed = 1;
+        return NULL;
+    }
+
+    for (;;) {
+        const char *value_end = NULL;
+        cJSON_ResetContext(context);
+        cJSON *person_json = cJSON_ParseWithContext(context, text + pos, share->length - pos, &value_end, 0);
+        if (!person_json) {
+            share->failed = 1;
+            break;
+        }
+
+        if (share->count == share->capacity) {
+            int capacity = share->capacity ? share->capacity * 2 : 64;
+            Person *bigger = memTrackRealloc(share->people, (size_t)capacity * sizeof(Person));
+            if (!bigger) {
+                share->failed = 1;
+                break;
+            }
+            share->people = bigger;
+            share->capacity = capacity;
+        }
+        personFromJSON(&share->people[share->count++], person_json, arena, &keys);
+
+        // A ',' inside the piece means another element of ours, ']' or a later ',' means done
+        pos = skipWhitespace(text, share->length, (size_t)(value_end - text));
+        if (pos < share->length && text[pos] == ',') {
+            if (pos >= share->end) break;
+            pos++;
+        } else {
+            share->failed = pos >= share->length || text[pos] != ']';
+            break;
+        }
+    }
+
+    cJSON_DeleteContext(context);
+    arenaRelease(arena); // now owned by the people
+    return NULL;
+}
+
+// Run work on every share, share 0 on the calling thread
+static void runShares(LoadShare *shares, int num_shares, void *(*work)(void *)) {
+    pthread_t threads[PARALLEL_MAX_THREADS];
+    int started[PARALLEL_MAX_THREADS] = { 0 };
+
+    for (int i = 1; i < num_shares; ++i) {
+        started[i] = pthread_create(&threads[i], NULL, work, &shares[i]) == 0;
+    }
+    work(&shares[0]);
+    for (int i = 1; i < num_shares; ++i) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            work(&shares[i]); // no thread for it, do it here
+        }
+    }
+}
+
+// Threads to use for length bytes, requested <= 0 means one per online CPU
+static int loaderThreadCount(int requested, size_t length) {
+    int count = requested;
+    if (count <= 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        count = online > 0 ? (int)online : 1;
+#else
+        count = 1;
+#endif
+        if ((size_t)count > length / PARALLEL_MIN_SHARE + 1) {
+            count = (int)(length / PARALLEL_MIN_SHARE + 1);
+        }
+    }
+    if (count > PARALLEL_MAX_THREADS) count = PARALLEL_MAX_THREADS;
+    if ((size_t)count > length) count = length > 0 ? (int)length : 1;
+    return count;
+}
+
+// Function to load data by parsing pieces of the people array on several threads
+Person *loadDataParallel(const char *filename, int *num_people, int num_threads) {
+    FileContent file;
+    if (!openFileContent(filename, 1, &file)) {
+        return NULL;
+    }
+
+    // Only the way to the array is walked here, nothing is copied
+    JsonStream stream;
+    jsonStreamOpenMemory(&stream, file.content, file.length);
+    if (!jsonStreamEnterArray(&stream, "people")) {
+        fprintf(stderr, "Invalid or missing 'people' array in JSON.\n");
+        jsonStreamClose(&stream);
+        closeFileContent(&file);
+        return NULL;
+    }
+    size_t array_start = stream.start;
+    jsonStreamClose(&stream);
+
+    // Cut the rest of the file into even pieces, never right after a backslash
+    LoadShare shares[PARALLEL_MAX_THREADS];
+    int num_shares = loaderThreadCount(num_threads, file.length - array_start);
+    size_t piece = (file.length - array_start) / (size_t)num_shares;
+    memset(shares, 0, sizeof(shares));
+    for (int i = 0; i < num_shares; ++i) {
+        size_t start = array_start + (size_t)i * piece;
+        if (i > 0) {
+            if (start < shares[i - 1].start) start = shares[i - 1].start;
+            while (start < file.length && file.content[start - 1] == '\\') {
+                start++;
+            }
+            shares[i - 1].end = start;
+        }
+        shares[i].text = file.content;
+        shares[i].length = file.length;
+        shares[i].start = start;
+        shares[i].first = i == 0;
+    }
+    shares[num_shares - 1].end = file.length;
+
+    // cJSON picks its SIMD level on first use, do that before the threads race for it
+    cJSON_GetSimdLevel();
+
+    // Where each piece starts follows from the summaries of all pieces before it,
+    // the first one always starts right inside the array
+    if (num_shares > 1) {
+        runShares(shares, num_shares, summarizeShare);
+    }
+    int in_string = 0;
+    long depth = 0;
+    size_t array_end = file.length;
+    for (int i = 0; i < num_shares; ++i) {
+        shares[i].in_string = in_string;
+        shares[i].depth = depth;
+
+        // The piece whose balance drops below the array's holds its ']'
+        if (array_end == file.length && depth + shares[i].summary.min_depth[in_string] < 0) {
+            long close = jsonFindArrayEnd(file.content + shares[i].start, shares[i].end - shares[i].start, in_string, depth);
+            if (close >= 0) array_end = shares[i].start + (size_t)close;
+        }
+        depth += shares[i].summary.depth_change[in_string];
+        in_string ^= shares[i].summary.quote_parity;
+    }
+
+    // Values after the array can come back to the same depth, so no piece looks past its end
+    for (int i = 0; i < num_shares; ++i) {
+        if (shares[i].start > array_end) shares[i].start = array_end;
+        if (shares[i].end > array_end) shares[i].end = array_end;
+    }
+
+    runShares(shares, num_shares, parseShare);
+    closeFileContent(&file);
+
+    // Put the pieces together in file order
+    int failed = 0, count = 0;
+    for (int i = 0; i < num_shares; ++i) {
+        failed |= shares[i].failed;
+        count += shares[i].count;
+    }
+    Person *people = failed ? NULL : memTrackMalloc((size_t)(count > 0 ? count : 1) * sizeof(Person));
+    int filled = 0;
+    for (int i = 0; i < num_shares; ++i) {
+        if (people) {
+            if (shares[i].count > 0) {
+                memcpy(people + filled, shares[i].people, (size_t)shares[i].count * sizeof(Person));
+            }
+            filled += shares[i].count;
+        } else {
+            for (int j = 0; j < shares[i].count; ++j) {
+                freePersonData(&shares[i].people[j]);
+            }
+        }
+        memTrackFree(shares[i].people);
+    }
+    if (!people) {
+        fprintf(stderr, failed ? "Error when parsing JSON.\n" : "Memory allocation failed.\n");
+        return NULL;
+    }
+
+    *num_people = count;
     return people;
 }
 
 // Function to add new data to the memory based on existing keys
-void addNewData(Person **people, int *num_people) {
-    // Find all unique keys present in the loaded data
-    char **keys = NULL;
+void addNewData(Person **people, int *num_people, PersonIndex *index) {
+    // Find all unique keys present in the loaded data, in order of first appearance.
+    // Key ids are small, so one flag per id replaces comparing against every key found so far.
+    int *keys = memTrackMalloc(((size_t)keyCount() + 1) * sizeof(int));
+    char *seen = memTrackMalloc((size_t)keyCount() + 1);
     int num_keys = 0;
+    if (!keys || !seen) {
+        perror("Memory allocation failed for keys");
+        memTrackFree(keys);
+        memTrackFree(seen);
+        return;
+    }
+    memset(seen, 0, (size_t)keyCount());
 
     // Iterate through existing people to find unique keys
     for (int i = 0; i < *num_people; ++i) {
-        KeyValue *current = (*people)[i].data;
-        while (current) {
-            // Check if the key is already present in the keys array
-            int found = 0;
-            for (int j = 0; j < num_keys; ++j) {
-                if (strcmp(current->key, keys[j]) == 0) {
-                    found = 1;
-                    break;
-                }
-            }
+        const KeyValueList *data = &(*people)[i].data;
+        for (int j = 0; j < data->count; ++j) {
             // If the key is not already present, add it to the keys array
-            if (!found) {
-                num_keys++;
-                keys = realloc(keys, num_keys * sizeof(char *));
-                keys[num_keys - 1] = strdup(current->key);
+            int key_id = data->items[j].key_id;
+            if (!seen[key_id]) {
+                seen[key_id] = 1;
+                keys[num_keys++] = key_id;
             }
-            current = current->next;
         }
     }
+    memTrackFree(seen);
 
     // Create a new person object
     Person new_person;
     new_person.id = *num_people + 1;
-    new_person.data = NULL;
+    memset(&new_person.data, 0, sizeof(new_person.data));
+    new_person.arena = arenaRetain(*num_people > 0 ? (*people)[0].arena : NULL); // same storage as the others
+    if (new_person.arena) {
+        reservePersonData(&new_person, num_keys);
+    }
 
     // Prompt the user for values
     for (int j = 0; j < num_keys; ++j) {
-        char value[100];
-        printf("Enter value for key %s: ", keys[j]);
-        scanf("%99s", value);
-        addKeyValue(&(new_person.data), keys[j], value);
+        char text[100];
+        Value value;
+        printf("Enter value for key %s: ", keyName(keys[j]));
+        scanf("%99s", text);
+        if (parseValueText(text, &value)) {
+            addPersonKeyValue(&new_person, keys[j], value);
+        }
     }
 
     // Add the new person object to the existing people array
     *num_people += 1;
-    *people = realloc(*people, *num_people * sizeof(Person));
+    *people = memTrackRealloc(*people, *num_people * sizeof(Person));
     (*people)[*num_people - 1] = new_person;
+    personIndexAppend(index, *people, *num_people);
 
     // Free the memory allocated for keys
-    for (int i = 0; i < num_keys; ++i) {
-        free(keys[i]);
-    }
-    free(keys);
+    memTrackFree(keys);
 }
 
 
@@ -203,10 +703,11 @@ void addNewData(Person **people, int *num_people) {
 void printPersonData(const Person *person) {
     printf("Person ID: %d\nData:\n", person->id);
 
-    const KeyValue *key_value = person->data;
-    while (key_value) {
-        printf("  %s: %s\n", key_value->key, key_value->value);
-        key_value = key_value->next;
+    for (int i = 0; i < person->data.count; ++i) {
+        const KeyValue *key_value = &person->data.items[i];
+        printf("  %s: ", keyName(key_value->key_id));
+        printValue(stdout, &key_value->value);
+        printf("\n");
     }
     printf("\n");
 }
@@ -232,7 +733,7 @@ void modifyPersonData(Person *person) {
             }
             break;
         case 2:
-            if (!person->data) {
+            if (person->data.count == 0) {
                 printf("No data available for modification.\n");
                 break;
             }
@@ -243,17 +744,22 @@ void modifyPersonData(Person *person) {
             printf("Enter new value: ");
             scanf("%99s", value);
 
-            // Find the key in the linked list and modify its value
-            KeyValue *key_value = person->data;
-            while (key_value && strcmp(key_value->key, key) != 0) {
-                key_value = key_value->next;
-            }
-
-            if (key_value) {
-                // Update the linked list node with the new value
-                free(key_value->value);
-                key_value->value = strdup(value);
-            } else {
+            // Find the key and modify its value, a key nobody uses has no id
+            KeyValue *key_value = findKeyValue(&person->data, findKeyID(key));
+
+            Value new_value;
+            if (key_value && parseValueText(value, &new_value)) {
+                if (!person->arena) {
+                    // Update the pair with the new value
+                    freeValue(&key_value->value);
+                    key_value->value = new_value;
+                } else if (moveValueToArena(person->arena, &new_value)) {
+                    // The old value stays in the arena until the dataset is dropped
+                    key_value->value = new_value;
+                } else {
+                    freeValue(&new_value);
+                }
+            } else if (!key_value) {
                 printf("Key not found.\n");
             }
             break;
@@ -264,74 +770,55 @@ void modifyPersonData(Person *person) {
     }
 }
 
-// Function to save modified data back to a file
-void saveData(const char *filename, Person *people, int num_people) {
-    // Creating JSON Strucure
-    cJSON *new_json = cJSON_CreateObject();
-    cJSON *new_people_array = cJSON_CreateArray();
+// Write people as the JSON document saveData saves, straight from their key-value pairs
+// into a buffered writer. The text is the same cJSON_Print gives for the tree of
+// valueToJSON items, but no tree is built. Returns 1 when everything was written.
+int writePeopleJSON(FILE *file, FILE *echo, const Person *people, int num_people) {
+    JsonWriter writer;
+    if (!jsonWriterOpen(&writer, file, echo)) return 0;
 
-    // Creating Person Objects
+    jsonWriteRaw(&writer, "{\n\t\"people\":\t[", 14);
     for (int i = 0; i < num_people; ++i) {
-        cJSON *person_json = cJSON_CreateObject();
-
-        // Add ID to the person's JSON object
-        cJSON_AddNumberToObject(person_json, "id", people[i].id);
-
-        // Parsing Values
-        KeyValue *key_value = people[i].data;
-        while (key_value) {
-            cJSON *value_item;
-
-            // Check if the value is numeric or a string
-            double numeric_value;
-            if (sscanf(key_value->value, "%lf", &numeric_value) == 1) {
-                value_item = cJSON_CreateNumber(numeric_value);
-            } else {
-                char *value = key_value->value;
-                size_t len = strlen(value);
-                if (value[0] == '\"' && value[len - 1] == '\"') {
-                    value[len - 1] = '\0';
-                    value_item = cJSON_CreateString(value + 1);
-                } else if (value[0] == '\"') {
-                    value_item = cJSON_CreateString(value + 1); 
-                } else {
-                    value_item = cJSON_CreateString(value);
-                }
-            }
-
-            cJSON_AddItemToObject(person_json, key_value->key, value_item);
-            key_value = key_value->next;
+        if (i > 0) {
+            jsonWriteRaw(&writer, ", ", 2);
         }
-
-        cJSON_AddItemToArray(new_people_array, person_json);
+        jsonWriteRaw(&writer, "{\n\t\t\t\"id\":\t", 11);
+        jsonWriteInteger(&writer, people[i].id);
+
+        // In the order they were loaded, members sit at depth 3
+        const KeyValueList *data = &people[i].data;
+        for (int j = 0; j < data->count; ++j) {
+            jsonWriteRaw(&writer, ",\n\t\t\t", 5);
+            jsonWriteString(&writer, keyName(data->items[j].key_id));
+            jsonWriteRaw(&writer, ":\t", 2);
+            writeValueJSON(&writer, &data->items[j].value, 3);
+        }
+        jsonWriteRaw(&writer, "\n\t\t}", 4);
     }
+    jsonWriteRaw(&writer, "]\n}", 3);
 
-    cJSON_AddItemToObject(new_json, "people", new_people_array);
-
-    char *json_string = cJSON_Print(new_json);
+    return jsonWriterClose(&writer);
+}
 
-    // Saving to File
+// Function to save modified data back to a file
+void saveData(const char *filename, Person *people, int num_people) {
     FILE *output_file = fopen(filename, "w");
     if (output_file == NULL) {
         fprintf(stderr, "Error when trying to open file for writing.\n");
-        cJSON_Delete(new_json);
-        free(json_string);
         return;
     }
 
-    printf("JSON String:\n%s\n", json_string);
+    // Written into the file in chunks and echoed to the console as it goes
+    printf("JSON String:\n");
+    int written = writePeopleJSON(output_file, stdout, people, num_people);
+    printf("\n");
 
-    // Attempt to write to the file
-    if (fprintf(output_file, "%s", json_string) < 0) {
+    // Close the file, buffered text is only written now
+    if (fclose(output_file) != 0 || !written) {
         fprintf(stderr, "Error when trying to write into file.\n");
     } else {
         printf("Data successfully saved to %s.\n", filename);
     }
-
-    // Close the file
-    fclose(output_file);
-    cJSON_Delete(new_json);
-    free(json_string);
 }
 
 
@@ -339,14 +826,15 @@ void saveData(const char *filename, Person *people, int num_people) {
 void freePeople(Person *people, int num_people) {
     if (!people) return;
 
+    // Arena data is released with the last person using it, without walking the lists
     for (int i = 0; i < num_people; ++i) {
-        freeKeyValueList(&people[i].data);
+        freePersonData(&people[i]);
     }
 
-    free(people);
+    memTrackFree(people);
 }
 
-void modifyDataBasedOnID(Person *people, int num_people) {
+void modifyDataBasedOnID(Person *people, int num_people, PersonIndex *index) {
     // Modify data based on person ID
     int personID;
     do {
@@ -358,11 +846,13 @@ void modifyDataBasedOnID(Person *people, int num_people) {
             return;
         }
 
-        for (int i = 0; i < num_people; ++i) {
-            if (people[i].id == personID) {
-                modifyPersonData(&people[i]);
-                return;
+        int slot = findPersonSlot(index, personID);
+        if (slot >= 0) {
+            modifyPersonData(&people[slot]);
+            if (people[slot].id != personID) {
+                personIndexChangeID(index, people, num_people, slot, personID);
             }
+            return;
         }
 
         printf("Person with ID %d not found.\n", personID);
@@ -370,21 +860,24 @@ void modifyDataBasedOnID(Person *people, int num_people) {
 }
 
 // Function to delete a person based on their ID
-void deletePersonByID(Person *people, int *num_people, int id) {
-    for (int i = 0; i < *num_people; ++i) {
-        if (people[i].id == id) {
-            // Free the key-value pairs associated with the person
-            freeKeyValueList(&people[i].data);
+void deletePersonByID(Person *people, int *num_people, PersonIndex *index, int id) {
+    int i = findPersonSlot(index, id);
+    if (i < 0) {
+        printf("Person with ID %d not found.\n", id);
+        return;
+    }
 
-            // Move the last person in the array to the position of the deleted person
-            people[i] = people[*num_people - 1];
+    // Free the key-value pairs associated with the person
+    freePersonData(&people[i]);
 
-            // Decrement the number of people
-            (*num_people)--;
+    // Move the last person in the array to the position of the deleted person
+    people[i] = people[*num_people - 1];
 
-            printf("Person with ID %d deleted.\n", id);
-            return;
-        }
-    }
-    printf("Person with ID %d not found.\n", id);
+    // Decrement the number of people
+    (*num_people)--;
+
+    // Keep the id index in step with the swap
+    personIndexRemove(index, people, *num_people, id, i);
+
+    printf("Person with ID %d deleted.\n", id);
 }
@@ -0,0 +1,543 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../cJSON/cJSON.h"
+#include "../inc/jsonIndex.h"
+#include "../inc/memTrack.h"
+
+#if !defined(CJSON_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define JSON_INDEX_X86_SIMD
+#include <immintrin.h>
+#endif
+
+#define BLOCK_SIZE 64
+
+
+// Bit masks for one 64 byte block, bit i stands for byte i
+typedef struct {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t structural;    // { } [ ] : ,
+    uint64_t whitespace;
+} BlockMasks;
+
+// What one block hands over to the next
+typedef struct {
+    uint64_t ends_odd_backslash;    // 1 when the block ended in an odd run of backslashes
+    uint64_t in_string;             // all ones when the block ended inside a string
+    uint64_t ends_separator;        // 1 when the block ended in whitespace or a structural character
+} ScanState;
+
+typedef void (*BlockClassifier)(const unsigned char *block, BlockMasks *masks);
+
+static void classifyScalar(const unsigned char *block, BlockMasks *masks) {
+    memset(masks, 0, sizeof(*masks));
+    for (int i = 0; i < BLOCK_SIZE; ++i) {
+        uint64_t bit = (uint64_t)1 << i;
+        switch (block[i]) {
+            case '"':
+                masks->quote |= bit;
+                break;
+            case '\\':
+                masks->backslash |= bit;
+                break;
+            case '{': case '}': case '[': case ']': case ':': case ',':
+                masks->structural |= bit;
+                break;
+            case ' ': case '\t': case '\n': case '\r':
+                masks->whitespace |= bit;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+#ifdef JSON_INDEX_X86_SIMD
+// '[' and ']' differ from '{' and '}' only in bit 0x20, so one OR folds them together
+__attribute__((target("sse2")))
+static void classifySSE2(const unsigned char *block, BlockMasks *masks) {
+    memset(masks, 0, sizeof(*masks));
+    for (int part = 0; part < 4; ++part) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(const void *)(block + 16 * part));
+        __m128i folded = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+        __m128i structural = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')),
+                                                       _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+                                          _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(':')),
+                                                       _mm_cmpeq_epi8(bytes, _mm_set1_epi8(','))));
+        __m128i whitespace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')),
+                                                       _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t'))),
+                                          _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')),
+                                                       _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r'))));
+        int shift = 16 * part;
+        masks->quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"'))) << shift;
+        masks->backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))) << shift;
+        masks->structural |= (uint64_t)(uint16_t)_mm_movemask_epi8(structural) << shift;
+        masks->whitespace |= (uint64_t)(uint16_t)_mm_movemask_epi8(whitespace) << shift;
+    }
+}
+
+__attribute__((target("avx2")))
+static void classifyAVX2(const unsigned char *block, BlockMasks *masks) {
+    memset(masks, 0, sizeof(*masks));
+    for (int half = 0; half < 2; ++half) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i *)(const void *)(block + 32 * half));
+        __m256i folded = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
+        __m256i structural = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')),
+                                                             _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+                                             _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(':')),
+                                                             _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(','))));
+        __m256i whitespace = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')),
+                                                             _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t'))),
+                                             _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')),
+                                                             _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r'))));
+        int shift = 32 * half;
+        masks->quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"'))) << shift;
+        masks->backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'))) << shift;
+        masks->structural |= (uint64_t)(uint32_t)_mm256_movemask_epi8(structural) << shift;
+        masks->whitespace |= (uint64_t)(uint32_t)_mm256_movemask_epi8(whitespace) << shift;
+    }
+}
+#endif
+
+// Same SIMD level as cJSON's own string scanning
+static BlockClassifier pickClassifier(void) {
+#ifdef JSON_INDEX_X86_SIMD
+    switch (cJSON_GetSimdLevel()) {
+        case CJSON_SIMD_AVX2:
+            return classifyAVX2;
+        case CJSON_SIMD_SSE2:
+            return classifySSE2;
+        default:
+            break;
+    }
+#endif
+    return classifyScalar;
+}
+
+static int trailingZeros(uint64_t bits) {
+#ifdef __GNUC__
+    return __builtin_ctzll(bits);
+#else
+    int count = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+// Bits of the characters escaped by an odd run of backslashes, carried over block edges
+static uint64_t findEscaped(uint64_t backslash, ScanState *state) {
+    const uint64_t even_bits = 0x5555555555555555ULL;
+    const uint64_t odd_bits = ~even_bits;
+    uint64_t start_edges = backslash & ~(backslash << 1);
+    // A run left open by the previous block flips which starts count as even
+    uint64_t even_start_mask = even_bits ^ state->ends_odd_backslash;
+    uint64_t even_starts = start_edges & even_start_mask;
+    uint64_t odd_starts = start_edges & ~even_start_mask;
+    uint64_t even_carries = backslash + even_starts;
+    uint64_t odd_carries = backslash + odd_starts;
+    uint64_t ends_odd = odd_carries < backslash;
+
+    odd_carries |= state->ends_odd_backslash;
+    state->ends_odd_backslash = ends_odd;
+
+    uint64_t even_carry_ends = even_carries & ~backslash;
+    uint64_t odd_carry_ends = odd_carries & ~backslash;
+    return (even_carry_ends & odd_bits) | (odd_carry_ends & even_bits);
+}
+
+// Bit i is the XOR of bits 0..i, turns quote bits into "inside a string" bits
+static uint64_t prefixXor(uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// Structural characters outside strings, opening quotes and the first byte of each number
+// or literal. The byte after a closing quote is reported too unless it is whitespace or
+// structural, so text glued to a string shows up as an unexpected token.
+static uint64_t structuralBits(const BlockMasks *masks, ScanState *state) {
+    uint64_t escaped = findEscaped(masks->backslash, state);
+    uint64_t quotes = masks->quote & ~escaped;
+    uint64_t in_string = prefixXor(quotes) ^ state->in_string;
+    state->in_string = 0 - (in_string >> 63);
+
+    uint64_t structurals = (masks->structural & ~in_string) | quotes;
+    uint64_t separators = structurals | masks->whitespace;
+    uint64_t scalar_starts = ((separators << 1) | state->ends_separator) & ~masks->whitespace & ~in_string;
+    state->ends_separator = separators >> 63;
+
+    structurals |= scalar_starts;
+    // Closing quotes are found again from the next token in stage 2
+    return structurals & ~(quotes & ~in_string);
+}
+
+// Stage 1: find every structural position of json[0..length).
+// Returns 0 when a string is not terminated or memory runs out.
+int buildJsonIndex(const char *json, size_t length, JsonIndex *index, size_t *error_offset) {
+    const unsigned char *text = (const unsigned char *)json;
+    BlockClassifier classify = pickClassifier();
+    ScanState state = { 0, 0, 1 };
+    unsigned char tail[BLOCK_SIZE];
+    BlockMasks masks;
+    size_t offset = 0;
+
+    memset(index, 0, sizeof(*index));
+    *error_offset = 0;
+    if (length >= UINT32_MAX) {
+        fprintf(stderr, "JSON text too long for the structural index.\n");
+        return 0;
+    }
+
+    // Skip the UTF-8 byte order mark like cJSON does
+    if (length >= 3 && memcmp(json, "\xEF\xBB\xBF", 3) == 0) {
+        offset = 3;
+    }
+
+    while (offset < length) {
+        const unsigned char *block = text + offset;
+        if (length - offset < BLOCK_SIZE) {
+            // The last block is padded with spaces, which are no tokens
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, block, length - offset);
+            block = tail;
+        }
+
+        if (index->count + BLOCK_SIZE > index->capacity) {
+            size_t capacity = index->capacity ? index->capacity * 2 : length / 8 + BLOCK_SIZE;
+            uint32_t *positions = memTrackRealloc(index->positions, capacity * sizeof(uint32_t));
+            if (!positions) {
+                perror("Memory allocation failed for structural index");
+                freeJsonIndex(index);
+                *error_offset = offset;
+                return 0;
+            }
+            index->positions = positions;
+            index->capacity = capacity;
+        }
+
+        classify(block, &masks);
+        uint64_t bits = structuralBits(&masks, &state);
+        while (bits) {
+            index->positions[index->count++] = (uint32_t)(offset + (size_t)trailingZeros(bits));
+            bits &= bits - 1;
+        }
+        offset += BLOCK_SIZE;
+    }
+
+    if (state.in_string) {
+        freeJsonIndex(index);
+        *error_offset = length;
+        return 0;
+    }
+    return 1;
+}
+
+void freeJsonIndex(JsonIndex *index) {
+    memTrackFree(index->positions);
+    memset(index, 0, sizeof(*index));
+}
+
+static int isWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Four hex digits of a \u escape
+static int parseHex4(const char *text, unsigned int *value) {
+    *value = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = text[i];
+        *value <<= 4;
+        if (c >= '0' && c <= '9') {
+            *value |= (unsigned int)(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            *value |= (unsigned int)(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            *value |= (unsigned int)(c - 'A' + 10);
+        } else {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Decode a \uXXXX escape (with its low surrogate) at text to UTF-8.
+// Returns the length of the escape, 0 when it is invalid.
+static size_t decodeUnicodeEscape(const char *text, const char *end, char **output) {
+    unsigned int codepoint = 0;
+    unsigned int low = 0;
+    size_t length = 6;
+
+    if (end - text < 6 || !parseHex4(text + 2, &codepoint)) return 0;
+    if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) return 0;
+    if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+        if (end - text < 12 || text[6] != '\\' || text[7] != 'u' || !parseHex4(text + 8, &low)) return 0;
+        if (low < 0xDC00 || low > 0xDFFF) return 0;
+        codepoint = 0x10000 + (((codepoint & 0x3FF) << 10) | (low & 0x3FF));
+        length = 12;
+    }
+
+    char *out = *output;
+    if (codepoint < 0x80) {
+        *out++ = (char)codepoint;
+    } else if (codepoint < 0x800) {
+        *out++ = (char)(0xC0 | (codepoint >> 6));
+        *out++ = (char)(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+        *out++ = (char)(0xE0 | (codepoint >> 12));
+        *out++ = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (codepoint & 0x3F));
+    } else {
+        *out++ = (char)(0xF0 | (codepoint >> 18));
+        *out++ = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+        *out++ = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (codepoint & 0x3F));
+    }
+    *output = out;
+    return length;
+}
+
+// Unescape the string text[start..end) into a cJSON_malloc'd copy, NULL when it is invalid
+static char *decodeString(const char *start, const char *end) {
+    size_t length = (size_t)(end - start);
+    char *output = cJSON_malloc(length + 1);
+    if (!output) return NULL;
+
+    const char *backslash = memchr(start, '\\', length);
+    if (!backslash) {
+        memcpy(output, start, length);
+        output[length] = '\0';
+        return output;
+    }
+
+    memcpy(output, start, (size_t)(backslash - start));
+    char *out = output + (backslash - start);
+    const char *in = backslash;
+    while (in < end) {
+        if (*in != '\\') {
+            *out++ = *in++;
+            continue;
+        }
+        if (end - in < 2) break;
+        switch (in[1]) {
+            case 'b': *out++ = '\b'; break;
+            case 'f': *out++ = '\f'; break;
+            case 'n': *out++ = '\n'; break;
+            case 'r': *out++ = '\r'; break;
+            case 't': *out++ = '\t'; break;
+            case '"': case '\\': case '/': *out++ = in[1]; break;
+            case 'u': {
+                size_t escape_length = decodeUnicodeEscape(in, end, &out);
+                if (escape_length == 0) {
+                    cJSON_free(output);
+                    return NULL;
+                }
+                in += escape_length;
+                continue;
+            }
+            default:
+                cJSON_free(output);
+                return NULL;
+        }
+        in += 2;
+    }
+    if (in != end) {
+        cJSON_free(output);
+        return NULL;
+    }
+    *out = '\0';
+    return output;
+}
+
+// A number or true/false/null spanning text[start..end)
+static int parseScalar(cJSON *item, const char *start, const char *end) {
+    size_t length = (size_t)(end - start);
+
+    if (length == 4 && memcmp(start, "true", 4) == 0) {
+        item->type = cJSON_True;
+        item->valueint = 1;
+        return 1;
+    }
+    if (length == 5 && memcmp(start, "false", 5) == 0) {
+        item->type = cJSON_False;
+        return 1;
+    }
+    if (length == 4 && memcmp(start, "null", 4) == 0) {
+        item->type = cJSON_NULL;
+        return 1;
+    }
+
+    // Same characters cJSON's parse_number looks at, strtod does the rest
+    if (length == 0 || !(*start == '-' || (*start >= '0' && *start <= '9'))) return 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (!strchr("0123456789+-.eE", start[i])) return 0;
+    }
+
+    char small[64];
+    char *number = length < sizeof(small) ? small : memTrackMalloc(length + 1);
+    if (!number) return 0;
+    memcpy(number, start, length);
+    number[length] = '\0';
+
+    char *number_end = NULL;
+    double value = strtod(number, &number_end);
+    int ok = number_end == number + length;
+    if (number != small) {
+        memTrackFree(number);
+    }
+    if (!ok) return 0;
+
+    item->type = cJSON_Number;
+    cJSON_SetNumberHelper(item, value);
+    return 1;
+}
+
+static cJSON *newItem(void) {
+    cJSON *item = cJSON_malloc(sizeof(cJSON));
+    if (item) {
+        memset(item, 0, sizeof(cJSON));
+    }
+    return item;
+}
+
+// Append with cJSON's list layout: the first child's prev points at the last child
+static void appendChild(cJSON *parent, cJSON *item) {
+    if (!parent->child) {
+        parent->child = item;
+        item->prev = item;
+    } else {
+        cJSON *last = parent->child->prev;
+        last->next = item;
+        item->prev = last;
+        parent->child->prev = item;
+    }
+}
+
+// Where the token after index entry i starts, or the end of the text
+static size_t nextTokenStart(const JsonIndex *index, size_t i, size_t length) {
+    return i + 1 < index->count ? index->positions[i + 1] : length;
+}
+
+// Closing quote of the string opened at index entry i: only whitespace lies between it
+// and the next token, anything else would have been indexed
+static size_t closingQuote(const char *json, const JsonIndex *index, size_t i, size_t length) {
+    size_t end = nextTokenStart(index, i, length);
+    while (end > index->positions[i] + 1 && json[end - 1] != '"') {
+        end--;
+    }
+    return end - 1;
+}
+
+// Stage 2: build the cJSON tree from the index with an explicit stack instead of recursion.
+// Unlike cJSON_ParseWithLength, text after the root value is an error. On failure NULL is
+// returned and error_offset is where parsing stopped.
+cJSON *parseJsonIndexed(const char *json, size_t length, size_t *error_offset) {
+    enum { EXPECT_VALUE, EXPECT_KEY, AFTER_VALUE } state = EXPECT_VALUE;
+    cJSON *stack[CJSON_NESTING_LIMIT];
+    int depth = 0;
+    cJSON *root = NULL;
+    char *key = NULL;
+    JsonIndex index;
+    size_t i = 0;
+    size_t at = length;
+
+    if (!buildJsonIndex(json, length, &index, error_offset)) {
+        return NULL;
+    }
+
+    for (;;) {
+        if (state == AFTER_VALUE && depth == 0) {
+            if (i == index.count) break;
+            at = index.positions[i];
+            goto fail; // text after the root value
+        }
+        if (i >= index.count) {
+            at = length;
+            goto fail;
+        }
+
+        at = index.positions[i];
+        char c = json[at];
+
+        if (state == EXPECT_KEY) {
+            if (c != '"' || i + 1 >= index.count || json[index.positions[i + 1]] != ':') goto fail;
+            key = decodeString(json + at + 1, json + closingQuote(json, &index, i, length));
+            if (!key) goto fail;
+            i += 2;
+            state = EXPECT_VALUE;
+            continue;
+        }
+
+        if (state == AFTER_VALUE) {
+            cJSON *parent = stack[depth - 1];
+            if (c == ',') {
+                i++;
+                state = cJSON_IsObject(parent) ? EXPECT_KEY : EXPECT_VALUE;
+                continue;
+            }
+            if (c == (cJSON_IsObject(parent) ? '}' : ']')) {
+                i++;
+                depth--;
+                continue;
+            }
+            goto fail;
+        }
+
+        // A value, hooked into the tree first so a failure below frees it with the rest
+        cJSON *item = newItem();
+        if (!item) goto fail;
+        if (depth > 0) {
+            item->string = key;
+            key = NULL;
+            appendChild(stack[depth - 1], item);
+        } else {
+            root = item;
+        }
+
+        if (c == '{' || c == '[') {
+            char close = c == '{' ? '}' : ']';
+            item->type = c == '{' ? cJSON_Object : cJSON_Array;
+            if (depth >= CJSON_NESTING_LIMIT) goto fail;
+            i++;
+            if (i < index.count && json[index.positions[i]] == close) {
+                i++;
+                state = AFTER_VALUE;
+            } else {
+                stack[depth++] = item;
+                state = c == '{' ? EXPECT_KEY : EXPECT_VALUE;
+            }
+            continue;
+        }
+
+        if (c == '"') {
+            item->type = cJSON_String;
+            item->valuestring = decodeString(json + at + 1, json + closingQuote(json, &index, i, length));
+            if (!item->valuestring) goto fail;
+        } else {
+            size_t end = nextTokenStart(&index, i, length);
+            while (end > at && isWhitespace(json[end - 1])) {
+                end--;
+            }
+            if (!parseScalar(item, json + at, json + end)) goto fail;
+        }
+        i++;
+        state = AFTER_VALUE;
+    }
+
+    freeJsonIndex(&index);
+    return root;
+
+fail:
+    *error_offset = at;
+    cJSON_Delete(root);
+    cJSON_free(key);
+    freeJsonIndex(&index);
+    return NULL;
+}
@@ -0,0 +1,363 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "../inc/jsonStream.h"
+#include "../inc/memTrack.h"
+
+#define STREAM_CHUNK_SIZE (64 * 1024)
+
+
+// Characters that can make up a number or a true/false/null literal
+static int isScalarChar(unsigned char c) {
+    return isalnum(c) || c == '-' || c == '+' || c == '.';
+}
+
+void jsonScanInit(JsonScanState *state) {
+    memset(state, 0, sizeof(*state));
+}
+
+// Continue scanning one value in text[0..length), which must start where the value starts.
+// Returns 1 when the value is complete (state->position is its length), 0 when more input
+// is needed and -1 when the text cannot be the start of a value.
+int jsonScanValue(JsonScanState *state, const char *text, size_t length) {
+    size_t pos = state->position;
+
+    while (pos < length) {
+        unsigned char c = (unsigned char)text[pos];
+
+        if (state->in_string) {
+            if (state->escaped) {
+                state->escaped = 0;
+            } else if (c == '\\') {
+                state->escaped = 1;
+            } else if (c == '"') {
+                state->in_string = 0;
+                if (state->depth == 0) {
+                    state->position = pos + 1;
+                    return 1;
+                }
+            }
+            pos++;
+            continue;
+        }
+
+        if (!state->started) {
+            state->started = 1;
+            if (c == '{' || c == '[') {
+                state->depth = 1;
+            } else if (c == '"') {
+                state->in_string = 1;
+            } else if (isScalarChar(c)) {
+                state->scalar = 1;
+            } else {
+                state->position = pos;
+                return -1;
+            }
+            pos++;
+            continue;
+        }
+
+        if (state->scalar) {
+            if (!isScalarChar(c)) {
+                state->position = pos;
+                return 1;
+            }
+            pos++;
+            continue;
+        }
+
+        switch (c) {
+            case '"':
+                state->in_string = 1;
+                break;
+            case '{':
+            case '[':
+                state->depth++;
+                break;
+            case '}':
+            case ']':
+                if (--state->depth == 0) {
+                    state->position = pos + 1;
+                    return 1;
+                }
+                break;
+            default:
+                break;
+        }
+        pos++;
+    }
+
+    state->position = pos;
+    return 0;
+}
+
+// Count the unescaped quotes and the brackets of text[0..length). Backslashes only occur
+// inside strings in valid JSON, so quotes can be matched without knowing where the piece
+// starts, and the brackets are counted for both cases at once. The piece must not start
+// right after a backslash.
+void jsonSummarizeChunk(const char *text, size_t length, JsonChunkSummary *summary) {
+    int parity = 0;
+    memset(summary, 0, sizeof(*summary));
+
+    for (size_t pos = 0; pos < length; ++pos) {
+        switch (text[pos]) {
+            case '\\':
+                pos++;
+                break;
+            case '"':
+                parity ^= 1;
+                break;
+            case '{':
+            case '[':
+                // Outside a string if the piece started outside and the parity is even, or the other way round
+                summary->depth_change[parity]++;
+                break;
+            case '}':
+            case ']':
+                if (--summary->depth_change[parity] < summary->min_depth[parity]) {
+                    summary->min_depth[parity] = summary->depth_change[parity];
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    summary->quote_parity = parity;
+}
+
+// Scan text[0..length), which starts at the given string state and depth relative to an
+// array's elements, for the bracket that closes the array, and with separators set for
+// the first ',' between two elements in front of it. Returns its offset, or -1.
+static long scanArrayPiece(const char *text, size_t length, int in_string, long depth, int separators) {
+    for (size_t pos = 0; pos < length; ++pos) {
+        char c = text[pos];
+        if (in_string) {
+            if (c == '\\') {
+                pos++;
+            } else if (c == '"') {
+                in_string = 0;
+            }
+            continue;
+        }
+
+        switch (c) {
+            case '"':
+                in_string = 1;
+                break;
+            case '{':
+            case '[':
+                depth++;
+                break;
+            case '}':
+            case ']':
+                if (--depth < 0) return separators ? -1 : (long)pos;
+                break;
+            case ',':
+                if (depth == 0 && separators) return (long)pos;
+                break;
+            default:
+                break;
+        }
+    }
+    return -1;
+}
+
+// The first ',' between two elements of the array, -1 when the piece has none or the array ends first
+long jsonFindSeparator(const char *text, size_t length, int in_string, long depth) {
+    return scanArrayPiece(text, length, in_string, depth, 1);
+}
+
+// The ']' that closes the array, -1 when it is not in the piece
+long jsonFindArrayEnd(const char *text, size_t length, int in_string, long depth) {
+    return scanArrayPiece(text, length, in_string, depth, 0);
+}
+
+// Move the unconsumed bytes to the front and read the next chunk behind them.
+// Returns 1 when something was read, 0 at the end of the file and -1 on errors.
+static int refill(JsonStream *stream) {
+    if (stream->eof) return 0;
+
+    if (stream->start > 0) {
+        memmove(stream->buffer, stream->buffer + stream->start, stream->end - stream->start);
+        stream->end -= stream->start;
+        stream->start = 0;
+    }
+
+    // A single value bigger than the buffer makes it grow, nothing else does
+    if (stream->end == stream->capacity) {
+        char *bigger = memTrackRealloc(stream->buffer, stream->capacity * 2);
+        if (!bigger) {
+            perror("Memory allocation failed for stream buffer");
+            return -1;
+        }
+        stream->buffer = bigger;
+        stream->capacity *= 2;
+    }
+
+    size_t read = fread(stream->buffer + stream->end, 1, stream->capacity - stream->end, stream->file);
+    if (read == 0) {
+        if (ferror(stream->file)) {
+            fprintf(stderr, "Error when reading file content.\n");
+            return -1;
+        }
+        stream->eof = 1;
+        return 0;
+    }
+
+    stream->end += read;
+    return 1;
+}
+
+// Skip whitespace and return the next byte without consuming it, -1 at the end of input
+static int peekToken(JsonStream *stream) {
+    for (;;) {
+        while (stream->start < stream->end) {
+            unsigned char c = (unsigned char)stream->buffer[stream->start];
+            if (c > 32) return c;
+            stream->start++;
+        }
+        if (refill(stream) <= 0) return -1;
+    }
+}
+
+// Find the length of the value at stream->start, reading more input as needed
+static int scanValue(JsonStream *stream, size_t *length) {
+    JsonScanState state;
+    jsonScanInit(&state);
+
+    for (;;) {
+        int status = jsonScanValue(&state, stream->buffer + stream->start, stream->end - stream->start);
+        if (status != 0) {
+            *length = state.position;
+            return status;
+        }
+
+        int read = refill(stream);
+        if (read < 0) return -1;
+        if (read == 0) {
+            // A bare number may end exactly at the end of the file
+            *length = state.position;
+            return state.scalar ? 1 : -1;
+        }
+    }
+}
+
+// Open filename for chunked reading
+int jsonStreamOpen(JsonStream *stream, const char *filename) {
+    memset(stream, 0, sizeof(*stream));
+
+    stream->file = fopen(filename, "r");
+    if (!stream->file) {
+        fprintf(stderr, "Error occurred when trying to open file '%s'.\n", filename);
+        return 0;
+    }
+
+    stream->buffer = memTrackMalloc(STREAM_CHUNK_SIZE);
+    if (!stream->buffer) {
+        perror("Memory allocation failed for stream buffer");
+        fclose(stream->file);
+        stream->file = NULL;
+        return 0;
+    }
+    stream->capacity = STREAM_CHUNK_SIZE;
+
+    // Skip the UTF-8 byte order mark like cJSON does
+    while (stream->end < 3 && refill(stream) > 0) {}
+    if (stream->end >= 3 && memcmp(stream->buffer, "\xEF\xBB\xBF", 3) == 0) {
+        stream->start = 3;
+    }
+    return 1;
+}
+
+// Walk a document that is already in memory with the same calls. Nothing is copied,
+// text must stay valid until the stream is closed.
+void jsonStreamOpenMemory(JsonStream *stream, const char *text, size_t length) {
+    memset(stream, 0, sizeof(*stream));
+    stream->buffer = (char *)text;
+    stream->capacity = length;
+    stream->end = length;
+    stream->eof = 1;
+    stream->borrowed = 1;
+
+    if (length >= 3 && memcmp(text, "\xEF\xBB\xBF", 3) == 0) {
+        stream->start = 3;
+    }
+}
+
+// Walk the top-level object up to the array stored under key (compared case-insensitively
+// like cJSON_GetObjectItem) and stop right after its '['. Returns 1 when found.
+int jsonStreamEnterArray(JsonStream *stream, const char *key) {
+    size_t key_length = strlen(key);
+    size_t length = 0;
+
+    if (peekToken(stream) != '{') return 0;
+    stream->start++;
+
+    for (;;) {
+        int c = peekToken(stream);
+        if (c != '"' || scanValue(stream, &length) != 1) return 0;
+
+        // The name without its quotes
+        const char *name = stream->buffer + stream->start + 1;
+        int matches = (length - 2 == key_length);
+        for (size_t i = 0; matches && i < key_length; ++i) {
+            matches = tolower((unsigned char)name[i]) == tolower((unsigned char)key[i]);
+        }
+        stream->start += length;
+
+        if (peekToken(stream) != ':') return 0;
+        stream->start++;
+
+        if (matches) {
+            if (peekToken(stream) != '[') return 0;
+            stream->start++;
+            stream->first = 1;
+            return 1;
+        }
+
+        // Not the array we want, skip its value
+        if (peekToken(stream) < 0 || scanValue(stream, &length) != 1) return 0;
+        stream->start += length;
+
+        c = peekToken(stream);
+        if (c != ',') return 0; // '}' means the key is not there
+        stream->start++;
+    }
+}
+
+// Return the next element of the array entered by jsonStreamEnterArray.
+// The text stays valid until the next call. Returns 1 for a value, 0 at the
+// end of the array and -1 on malformed input.
+int jsonStreamNextValue(JsonStream *stream, const char **value, size_t *length) {
+    int c = peekToken(stream);
+
+    if (c == ']') {
+        stream->start++;
+        return 0;
+    }
+    if (!stream->first) {
+        if (c != ',') return -1;
+        stream->start++;
+        c = peekToken(stream);
+    }
+    if (c < 0) return -1;
+    stream->first = 0;
+
+    if (scanValue(stream, length) != 1) return -1;
+
+    *value = stream->buffer + stream->start;
+    stream->start += *length;
+    return 1;
+}
+
+// Close the file and free the buffer
+void jsonStreamClose(JsonStream *stream) {
+    if (stream->file) {
+        fclose(stream->file);
+    }
+    if (!stream->borrowed) {
+        memTrackFree(stream->buffer);
+    }
+    memset(stream, 0, sizeof(*stream));
+}
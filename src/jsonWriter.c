@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "../cJSON/cJSON.h"
+#include "../inc/jsonWriter.h"
+#include "../inc/memTrack.h"
+
+#define WRITER_BUFFER_SIZE (64 * 1024)
+#define TREE_CHUNK_SIZE 256     // print buffer of a nested subtree, its pieces are copied into the writer
+
+
+// Hand the buffered text to the file (and the echo) and start over at the front
+static void flushWriter(JsonWriter *writer) {
+    if (writer->length > 0 && !writer->failed) {
+        if (fwrite(writer->buffer, 1, writer->length, writer->file) != writer->length) {
+            writer->failed = 1;
+        }
+        if (writer->echo) {
+            fwrite(writer->buffer, 1, writer->length, writer->echo);
+        }
+    }
+    writer->length = 0;
+}
+
+static void writeByte(JsonWriter *writer, char c) {
+    if (writer->length == writer->capacity) {
+        flushWriter(writer);
+    }
+    writer->buffer[writer->length++] = c;
+}
+
+// Start writing into file. Returns 0 when the buffer cannot be allocated.
+int jsonWriterOpen(JsonWriter *writer, FILE *file, FILE *echo) {
+    memset(writer, 0, sizeof(*writer));
+    writer->buffer = memTrackMalloc(WRITER_BUFFER_SIZE);
+    if (!writer->buffer) {
+        perror("Memory allocation failed for writer buffer");
+        return 0;
+    }
+    writer->file = file;
+    writer->echo = echo;
+    writer->capacity = WRITER_BUFFER_SIZE;
+    return 1;
+}
+
+// Text of any length, copied in pieces that fit the buffer
+void jsonWriteRaw(JsonWriter *writer, const char *text, size_t length) {
+    while (length > 0) {
+        if (writer->length == writer->capacity) {
+            flushWriter(writer);
+        }
+        size_t piece = writer->capacity - writer->length;
+        if (piece > length) piece = length;
+        memcpy(writer->buffer + writer->length, text, piece);
+        writer->length += piece;
+        text += piece;
+        length -= piece;
+    }
+}
+
+// A quoted string escaped like cJSON escapes it: the short escapes, \u00XX for the
+// other control characters and everything else, UTF-8 included, as it is
+void jsonWriteString(JsonWriter *writer, const char *text) {
+    static const char hex[] = "0123456789abcdef";
+    const unsigned char *run = (const unsigned char *)(text ? text : "");
+    const unsigned char *pos = run;
+
+    writeByte(writer, '"');
+    for (;; ++pos) {
+        unsigned char c = *pos;
+        if (c >= 32 && c != '"' && c != '\\') continue;
+
+        // Runs without escapes are copied as a whole
+        jsonWriteRaw(writer, (const char *)run, (size_t)(pos - run));
+        if (c == '\0') break;
+        run = pos + 1;
+
+        char escape[6] = { '\\', (char)c, 0, 0, 0, 0 };
+        size_t length = 2;
+        switch (c) {
+            case '"':
+            case '\\':
+                break;
+            case '\b':
+                escape[1] = 'b';
+                break;
+            case '\f':
+                escape[1] = 'f';
+                break;
+            case '\n':
+                escape[1] = 'n';
+                break;
+            case '\r':
+                escape[1] = 'r';
+                break;
+            case '\t':
+                escape[1] = 't';
+                break;
+            default:
+                escape[1] = 'u';
+                escape[2] = '0';
+                escape[3] = '0';
+                escape[4] = hex[c >> 4];
+                escape[5] = hex[c & 0x0F];
+                length = 6;
+                break;
+        }
+        jsonWriteRaw(writer, escape, length);
+    }
+    writeByte(writer, '"');
+}
+
+// Whole numbers in the int range are written as digits like cJSON does, larger ones
+// go through the double formatting like they do in cJSON
+void jsonWriteInteger(JsonWriter *writer, int64_t number) {
+    if (number < INT_MIN || number > INT_MAX) {
+        jsonWriteDouble(writer, (double)number);
+        return;
+    }
+
+    char digits[12];
+    size_t pos = sizeof(digits);
+    uint32_t magnitude = (uint32_t)(number < 0 ? -number : number);
+    do {
+        digits[--pos] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (number < 0) {
+        digits[--pos] = '-';
+    }
+    jsonWriteRaw(writer, digits + pos, sizeof(digits) - pos);
+}
+
+// Formatted by cJSON on the stack, so the shortest digits that read back as the same
+// double are written exactly as cJSON_Print writes them, without any allocation
+void jsonWriteDouble(JsonWriter *writer, double number) {
+    char text[32];
+    cJSON item;
+    memset(&item, 0, sizeof(item));
+    item.type = cJSON_Number;
+    cJSON_SetNumberValue(&item, number);
+    if (!cJSON_PrintPreallocated(&item, text, sizeof(text), 0)) {
+        writer->failed = 1;
+        return;
+    }
+    jsonWriteRaw(writer, text, strlen(text));
+}
+
+typedef struct {
+    JsonWriter *writer;
+    int depth;
+} TreeTarget;
+
+// Copy a piece of a printed subtree, indenting every line after the first by depth tabs
+static cJSON_bool writeTreePiece(void *target, const char *text, size_t length) {
+    TreeTarget *tree = target;
+    const char *end = text + length;
+
+    while (text < end) {
+        const char *newline = memchr(text, '\n', (size_t)(end - text));
+        const char *stop = newline ? newline + 1 : end;
+        jsonWriteRaw(tree->writer, text, (size_t)(stop - text));
+        for (int i = 0; newline && i < tree->depth; ++i) {
+            writeByte(tree->writer, '\t');
+        }
+        text = stop;
+    }
+    return 1;
+}
+
+// A cJSON subtree formatted the way cJSON_Print formats it at the given nesting depth.
+// Printed strings cannot hold a raw newline, so every newline starts a line of the layout.
+void jsonWriteTree(JsonWriter *writer, const cJSON *tree, int depth) {
+    TreeTarget target = { writer, depth };
+    if (!cJSON_PrintStreamed(tree, 1, TREE_CHUNK_SIZE, writeTreePiece, &target)) {
+        writer->failed = 1;
+    }
+}
+
+// Write what is left and free the buffer. Returns 1 when everything was written.
+int jsonWriterClose(JsonWriter *writer) {
+    flushWriter(writer);
+    int written = !writer->failed;
+    memTrackFree(writer->buffer);
+    memset(writer, 0, sizeof(*writer));
+    return written;
+}
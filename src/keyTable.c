@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "../inc/keyTable.h"
+#include "../inc/memTrack.h"
+
+#define SLOT_EMPTY -1
+
+// Shared by all loaded people, keys stay until freeKeyTable
+static KeyTable key_table = { NULL, 0, 0, NULL, 0 };
+
+// Interning may run on several loader threads at once, lookups only happen between loads
+static pthread_mutex_t key_table_lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+// FNV-1a, keys are short
+static uint32_t hashKey(const char *key) {
+    uint32_t hash = 2166136261u;
+    while (*key) {
+        hash ^= (unsigned char)*key++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Slot holding key, or the empty slot where it belongs
+static int *lookupSlot(const char *key) {
+    unsigned int mask = (unsigned int)key_table.capacity - 1;
+    unsigned int i = hashKey(key) & mask;
+    while (key_table.slots[i] != SLOT_EMPTY && strcmp(key_table.names[key_table.slots[i]], key) != 0) {
+        i = (i + 1) & mask;
+    }
+    return &key_table.slots[i];
+}
+
+// Double the hash table and put all ids back, load factor stays below 1/2
+static int growSlots(void) {
+    int capacity = key_table.capacity ? key_table.capacity * 2 : 64;
+    int *slots = memTrackMalloc((size_t)capacity * sizeof(int));
+    if (!slots) {
+        perror("Memory allocation failed for key table");
+        return 0;
+    }
+    for (int i = 0; i < capacity; ++i) {
+        slots[i] = SLOT_EMPTY;
+    }
+
+    memTrackFree(key_table.slots);
+    key_table.slots = slots;
+    key_table.capacity = capacity;
+    for (int id = 0; id < key_table.count; ++id) {
+        *lookupSlot(key_table.names[id]) = id;
+    }
+    return 1;
+}
+
+// internKey with the lock held
+static int internKeyLocked(const char *key) {
+    if (key_table.slots) {
+        int *slot = lookupSlot(key);
+        if (*slot != SLOT_EMPTY) {
+            return *slot;
+        }
+    }
+
+    if ((key_table.count + 1) * 2 > key_table.capacity && !growSlots()) {
+        return -1;
+    }
+    if (key_table.count == key_table.names_capacity) {
+        int names_capacity = key_table.names_capacity ? key_table.names_capacity * 2 : 32;
+        char **names = memTrackRealloc(key_table.names, (size_t)names_capacity * sizeof(char *));
+        if (!names) {
+            perror("Memory allocation failed for key table");
+            return -1;
+        }
+        key_table.names = names;
+        key_table.names_capacity = names_capacity;
+    }
+
+    char *name = memTrackStrdup(key);
+    if (!name) {
+        perror("Memory allocation failed for key string");
+        return -1;
+    }
+
+    int id = key_table.count++;
+    key_table.names[id] = name;
+    *lookupSlot(name) = id;
+    return id;
+}
+
+// Return the id of key, adding it on first use. Returns -1 when out of memory.
+int internKey(const char *key) {
+    if (!key) return -1;
+
+    pthread_mutex_lock(&key_table_lock);
+    int id = internKeyLocked(key);
+    pthread_mutex_unlock(&key_table_lock);
+    return id;
+}
+
+// internKey for the key at position in a record, answered from cache when the record
+// before had the same key there
+int internKeyCached(KeyCache *cache, int position, const char *key) {
+    if (!key) return -1;
+    if (position < 0 || position >= KEY_CACHE_SIZE) return internKey(key);
+
+    if (cache->names[position] && strcmp(cache->names[position], key) == 0) {
+        return cache->ids[position];
+    }
+
+    pthread_mutex_lock(&key_table_lock);
+    int id = internKeyLocked(key);
+    cache->names[position] = id >= 0 ? key_table.names[id] : NULL;
+    cache->ids[position] = id;
+    pthread_mutex_unlock(&key_table_lock);
+    return id;
+}
+
+// Id of a key that was interned before, -1 when no record ever used it
+int findKeyID(const char *key) {
+    if (!key || !key_table.slots) return -1;
+    return *lookupSlot(key);
+}
+
+const char *keyName(int key_id) {
+    if (key_id < 0 || key_id >= key_table.count) return NULL;
+    return key_table.names[key_id];
+}
+
+int keyCount(void) {
+    return key_table.count;
+}
+
+// Drop all keys. Only valid when no KeyValue refers to them any more.
+void freeKeyTable(void) {
+    for (int id = 0; id < key_table.count; ++id) {
+        memTrackFree(key_table.names[id]);
+    }
+    memTrackFree(key_table.names);
+    memTrackFree(key_table.slots);
+    memset(&key_table, 0, sizeof(key_table));
+}
@@ -3,12 +3,22 @@
 #include <string.h>
 #include "../cJSON/cJSON.h"
 #include "../inc/func.h"
+#include "../inc/memTrack.h"
+#include "../inc/keyTable.h"
+#include "../inc/personIndex.h"
 
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    // --mem-report counts cJSON allocations too and prints the live bytes after loads and at exit
+    int mem_report = argc > 1 && strcmp(argv[1], "--mem-report") == 0;
+    if (mem_report) {
+        memTrackInstallHooks();
+    }
+
     int num_people = 0;
     Person *people = NULL;
+    PersonIndex person_index = { NULL, 0, 0, 0 };   // id -> slot of people, for modify and delete
     char file_name[100];
     int choice;
 
@@ -34,6 +44,11 @@ int main() {
             case 1:
                 printf("Choose file to load: ");
                 scanf("%99s", file_name);
+                // Drop the data loaded before, it is replaced
+                freePeople(people, num_people);
+                people = NULL;
+                num_people = 0;
+
                 // Load data from a file
                 people = loadData(file_name, &num_people);
                 if (!people) {
@@ -42,6 +57,10 @@ int main() {
                 } else {
                     printf("Data loaded succesfully\n");
                 }
+                buildPersonIndex(&person_index, people, num_people);
+                if (mem_report) {
+                    memTrackReport(stdout, "after load");
+                }
                 break; 
 
             case 2:
@@ -53,7 +72,7 @@ int main() {
 
             case 3:
                 printf("Modify data based on ID\n");
-                modifyDataBasedOnID(people, num_people);
+                modifyDataBasedOnID(people, num_people, &person_index);
                 break;
 
             case 4:
@@ -66,11 +85,11 @@ int main() {
                 printf("Enter the ID of the person to delete: ");
                 scanf("%d", &personID);
 
-                deletePersonByID(people, &num_people, personID);
+                deletePersonByID(people, &num_people, &person_index, personID);
                 break;
 
             case 5:
-                addNewData(&people, &num_people);
+                addNewData(&people, &num_people, &person_index);
                 break;
 
             case 6:
@@ -89,11 +108,13 @@ int main() {
 
     } while (choice != 7);
 
-    // Free the allocated memory for the 'people' array
-    for (int i = 0; i < num_people; ++i) {
-        free(people[i].data);
+    // Free the allocated memory for the 'people' array and everything it holds
+    freePeople(people, num_people);
+    freePersonIndex(&person_index);
+    freeKeyTable();
+    if (mem_report) {
+        memTrackReport(stdout, "at exit");
     }
-    free(people);
     return 0;
 }
 
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "../cJSON/cJSON.h"
+#include "../inc/memTrack.h"
+
+// Every block starts with its size, padded so the memory behind it stays aligned
+typedef union {
+    size_t size;
+    max_align_t align;
+} MemTrackHeader;
+
+// Loader threads allocate concurrently, so the counters are atomic
+static atomic_size_t live_bytes;
+static atomic_size_t live_blocks;
+static atomic_size_t peak_bytes;
+static atomic_size_t total_allocations;
+
+
+static void countAllocation(size_t size) {
+    size_t live = atomic_fetch_add_explicit(&live_bytes, size, memory_order_relaxed) + size;
+    atomic_fetch_add_explicit(&live_blocks, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&total_allocations, 1, memory_order_relaxed);
+
+    size_t peak = atomic_load_explicit(&peak_bytes, memory_order_relaxed);
+    while (live > peak && !atomic_compare_exchange_weak_explicit(&peak_bytes, &peak, live,
+                                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+static void countFree(size_t size) {
+    atomic_fetch_sub_explicit(&live_bytes, size, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&live_blocks, 1, memory_order_relaxed);
+}
+
+void *memTrackMalloc(size_t size) {
+    if (size > (size_t)-1 - sizeof(MemTrackHeader)) return NULL;
+
+    MemTrackHeader *header = malloc(sizeof(MemTrackHeader) + size);
+    if (!header) return NULL;
+
+    header->size = size;
+    countAllocation(size);
+    return header + 1;
+}
+
+void *memTrackRealloc(void *ptr, size_t size) {
+    if (!ptr) return memTrackMalloc(size);
+    if (size > (size_t)-1 - sizeof(MemTrackHeader)) return NULL;
+
+    MemTrackHeader *header = (MemTrackHeader *)ptr - 1;
+    size_t old_size = header->size;
+
+    MemTrackHeader *moved = realloc(header, sizeof(MemTrackHeader) + size);
+    if (!moved) return NULL; // the old block is untouched and still counted
+
+    moved->size = size;
+    countFree(old_size);
+    countAllocation(size);
+    return moved + 1;
+}
+
+char *memTrackStrdup(const char *text) {
+    size_t length = strlen(text) + 1;
+    char *copy = memTrackMalloc(length);
+    if (copy) {
+        memcpy(copy, text, length);
+    }
+    return copy;
+}
+
+void memTrackFree(void *ptr) {
+    if (!ptr) return;
+
+    MemTrackHeader *header = (MemTrackHeader *)ptr - 1;
+    countFree(header->size);
+    free(header);
+}
+
+// Route cJSON through the counters as well. Must run before the first cJSON
+// allocation, blocks allocated before cannot be freed through the hooks.
+void memTrackInstallHooks(void) {
+    cJSON_Hooks hooks = { memTrackMalloc, memTrackFree };
+    cJSON_InitHooks(&hooks);
+}
+
+MemTrackStats memTrackStats(void) {
+    MemTrackStats stats;
+    stats.live_bytes = atomic_load(&live_bytes);
+    stats.live_blocks = atomic_load(&live_blocks);
+    stats.peak_bytes = atomic_load(&peak_bytes);
+    stats.total_allocations = atomic_load(&total_allocations);
+    return stats;
+}
+
+size_t memTrackLiveBytes(void) {
+    return atomic_load(&live_bytes);
+}
+
+// Count the peak again from what is live now, to measure the peak of one step
+void memTrackResetPeak(void) {
+    atomic_store(&peak_bytes, atomic_load(&live_bytes));
+}
+
+// Print the counters, e.g. after a load or before exiting
+void memTrackReport(FILE *stream, const char *label) {
+    MemTrackStats stats = memTrackStats();
+    fprintf(stream, "[memory] %s: %zu bytes in %zu blocks live, peak %zu bytes, %zu allocations\n",
+            label, stats.live_bytes, stats.live_blocks, stats.peak_bytes, stats.total_allocations);
+}
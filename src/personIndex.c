@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "../inc/personIndex.h"
+#include "../inc/memTrack.h"
+
+#define SLOT_EMPTY   -1
+#define SLOT_DELETED -2
+
+
+// Fibonacci hashing spreads consecutive ids over the whole table
+static unsigned int hashID(int id, int capacity) {
+    return ((unsigned int)id * 2654435769u) & (unsigned int)(capacity - 1);
+}
+
+// Find the entry holding id, or NULL
+static PersonIndexEntry *lookupEntry(const PersonIndex *index, int id) {
+    if (!index->entries) return NULL;
+
+    unsigned int mask = (unsigned int)index->capacity - 1;
+    unsigned int i = hashID(id, index->capacity);
+    while (index->entries[i].slot != SLOT_EMPTY) {
+        if (index->entries[i].slot != SLOT_DELETED && index->entries[i].id == id) {
+            return &index->entries[i];
+        }
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+// Insert id -> slot. An id that is already present keeps the lower of the two slots,
+// like the linear scan that finds the first person with it.
+static void insertEntry(PersonIndex *index, int id, int slot) {
+    unsigned int mask = (unsigned int)index->capacity - 1;
+    unsigned int i = hashID(id, index->capacity);
+    PersonIndexEntry *reuse = NULL;
+
+    while (index->entries[i].slot != SLOT_EMPTY) {
+        if (index->entries[i].slot == SLOT_DELETED) {
+            if (!reuse) reuse = &index->entries[i];
+        } else if (index->entries[i].id == id) {
+            index->has_duplicates = 1;
+            if (slot < index->entries[i].slot) {
+                index->entries[i].slot = slot;
+            }
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+
+    if (!reuse) {
+        reuse = &index->entries[i];
+        index->used++;
+    }
+    reuse->id = id;
+    reuse->slot = slot;
+}
+
+// Make room for at least num_people entries at a load factor of 1/2. A table that is
+// big enough is kept, and so is a smaller one that still has room when allocating fails.
+static int reserveEntries(PersonIndex *index, int num_people) {
+    int capacity = 16;
+    while (capacity < num_people * 2) {
+        capacity *= 2;
+    }
+
+    if (capacity > index->capacity) {
+        PersonIndexEntry *entries = memTrackMalloc((size_t)capacity * sizeof(PersonIndexEntry));
+        if (entries) {
+            memTrackFree(index->entries);
+            index->entries = entries;
+            index->capacity = capacity;
+        } else {
+            perror("Memory allocation failed for person index");
+            if (index->capacity <= num_people) return 0;
+        }
+    }
+
+    for (int i = 0; i < index->capacity; ++i) {
+        index->entries[i].slot = SLOT_EMPTY;
+    }
+    index->used = 0;
+    return 1;
+}
+
+// Build the id -> slot index for a whole people array
+int buildPersonIndex(PersonIndex *index, const Person *people, int num_people) {
+    index->has_duplicates = 0;
+    if (!reserveEntries(index, num_people)) {
+        return 0;
+    }
+
+    for (int i = 0; i < num_people; ++i) {
+        insertEntry(index, people[i].id, i);
+    }
+    return 1;
+}
+
+// Return the slot of the first person with the given id, or -1 when there is none
+int findPersonSlot(const PersonIndex *index, int id) {
+    const PersonIndexEntry *entry = lookupEntry(index, id);
+    return entry ? entry->slot : -1;
+}
+
+// Index the person that was just appended as people[num_people - 1]
+int personIndexAppend(PersonIndex *index, const Person *people, int num_people) {
+    if ((index->used + 1) * 2 > index->capacity) {
+        return buildPersonIndex(index, people, num_people);
+    }
+
+    insertEntry(index, people[num_people - 1].id, num_people - 1);
+    return 1;
+}
+
+// Drop id after deletePersonByID moved the former last person into slot and shrank the array
+int personIndexRemove(PersonIndex *index, const Person *people, int num_people, int id, int slot) {
+    if (index->has_duplicates) {
+        // Another person may have the id or own the moved person's entry
+        return buildPersonIndex(index, people, num_people);
+    }
+
+    PersonIndexEntry *entry = lookupEntry(index, id);
+    if (entry) {
+        entry->slot = SLOT_DELETED;
+    }
+
+    if (slot < num_people) {
+        PersonIndexEntry *moved = lookupEntry(index, people[slot].id);
+        if (moved) {
+            moved->slot = slot;
+        }
+    }
+    return 1;
+}
+
+// Re-key people[slot], whose id was edited from old_id
+int personIndexChangeID(PersonIndex *index, const Person *people, int num_people, int slot, int old_id) {
+    if (index->has_duplicates || (index->used + 1) * 2 > index->capacity) {
+        return buildPersonIndex(index, people, num_people);
+    }
+
+    PersonIndexEntry *entry = lookupEntry(index, old_id);
+    if (entry && entry->slot == slot) {
+        entry->slot = SLOT_DELETED;
+    }
+    insertEntry(index, people[slot].id, slot);
+    return 1;
+}
+
+// Release the index memory
+void freePersonIndex(PersonIndex *index) {
+    memTrackFree(index->entries);
+    index->entries = NULL;
+    index->capacity = 0;
+    index->used = 0;
+    index->has_duplicates = 0;
+}
@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <math.h>
+#include "../cJSON/cJSON.h"
+#include "../inc/value.h"
+#include "../inc/arena.h"
+#include "../inc/jsonWriter.h"
+
+
+// Numbers from cJSON arrive as doubles, so above 2^53 a whole number may already be
+// rounded. Only whole numbers up to that limit are kept as integers, everything else
+// stays a double, which is also how cJSON prints it.
+#define VALUE_INT_LIMIT 9007199254740992.0
+
+Value numberValue(double number) {
+    Value value;
+    if (number >= -VALUE_INT_LIMIT && number <= VALUE_INT_LIMIT && (double)(int64_t)number == number) {
+        value.type = VALUE_INT;
+        value.as.integer = (int64_t)number;
+    } else {
+        value.type = VALUE_DOUBLE;
+        value.as.number = number;
+    }
+    return value;
+}
+
+// Take the value of item over from the parsed tree.
+// Strings and subtrees are moved out of the tree, so nothing is copied. A tree parsed
+// with a cJSON_Context owns neither, those are copied. With an arena, strings are copied
+// straight into it and subtrees handed to it, so the value belongs to the arena and is
+// not freed on its own; VALUE_NULL is returned when the arena is out of memory.
+Value valueFromJSON(cJSON *parent, cJSON *item, Arena *arena) {
+    Value value;
+    value.type = VALUE_NULL;
+    value.as.integer = 0;
+
+    switch (item->type & 0xFF) {
+        case cJSON_False:
+        case cJSON_True:
+            value.type = VALUE_BOOL;
+            value.as.boolean = cJSON_IsTrue(item);
+            break;
+        case cJSON_Number:
+            value = numberValue(item->valuedouble);
+            break;
+        case cJSON_String:
+        case cJSON_Raw:
+            if (arena) {
+                // One copy whether the tree owns the string or not, the tree frees its own
+                value.as.string = arenaStrdup(arena, item->valuestring);
+                value.type = value.as.string ? VALUE_STRING : VALUE_NULL;
+                break;
+            }
+            if (item->type & cJSON_IsReference) {
+                stringValue(item->valuestring, &value);
+                break;
+            }
+            value.type = VALUE_STRING;
+            value.as.string = item->valuestring;
+            item->valuestring = NULL;
+            break;
+        case cJSON_Array:
+        case cJSON_Object:
+            value.as.json = (item->type & cJSON_IsPooled) ? cJSON_Duplicate(item, 1) : cJSON_DetachItemViaPointer(parent, item);
+            if (value.as.json && arena && !arenaAdoptTree(arena, value.as.json)) {
+                cJSON_Delete(value.as.json);
+                value.as.json = NULL;
+            }
+            value.type = value.as.json ? VALUE_JSON : VALUE_NULL;
+            break;
+        default:
+            break;
+    }
+    return value;
+}
+
+// Create the cJSON item for saving a value. Subtrees are added as references, not copies,
+// except packed arrays: those have no items to refer to and are copied as one block.
+cJSON *valueToJSON(const Value *value) {
+    switch (value->type) {
+        case VALUE_BOOL:
+            return cJSON_CreateBool(value->as.boolean);
+        case VALUE_INT:
+            return cJSON_CreateNumber((double)value->as.integer);
+        case VALUE_DOUBLE:
+            return cJSON_CreateNumber(value->as.number);
+        case VALUE_STRING:
+            return cJSON_CreateString(value->as.string);
+        case VALUE_JSON:
+            if (cJSON_GetPackedNumbers(value->as.json, NULL)) {
+                return cJSON_Duplicate(value->as.json, 1);
+            }
+            return cJSON_IsArray(value->as.json) ? cJSON_CreateArrayReference(value->as.json->child)
+                                                 : cJSON_CreateObjectReference(value->as.json->child);
+        case VALUE_NULL:
+        default:
+            return cJSON_CreateNull();
+    }
+}
+
+// Write a value as the text cJSON_Print gives for valueToJSON(value), without creating
+// the item. depth is the nesting depth the value is printed at, for indenting subtrees.
+void writeValueJSON(JsonWriter *writer, const Value *value, int depth) {
+    switch (value->type) {
+        case VALUE_BOOL:
+            if (value->as.boolean) {
+                jsonWriteRaw(writer, "true", 4);
+            } else {
+                jsonWriteRaw(writer, "false", 5);
+            }
+            break;
+        case VALUE_INT:
+            jsonWriteInteger(writer, value->as.integer);
+            break;
+        case VALUE_DOUBLE:
+            jsonWriteDouble(writer, value->as.number);
+            break;
+        case VALUE_STRING:
+            jsonWriteString(writer, value->as.string);
+            break;
+        case VALUE_JSON:
+            jsonWriteTree(writer, value->as.json, depth);
+            break;
+        case VALUE_NULL:
+        default:
+            jsonWriteRaw(writer, "null", 4);
+            break;
+    }
+}
+
+// Store text as a string value
+int stringValue(const char *text, Value *value) {
+    size_t length = strlen(text) + 1;
+    value->type = VALUE_STRING;
+    value->as.string = cJSON_malloc(length);
+    if (!value->as.string) {
+        perror("Memory allocation failed for value string");
+        value->type = VALUE_NULL;
+        return 0;
+    }
+    memcpy(value->as.string, text, length);
+    return 1;
+}
+
+// Turn text typed by the user into a value: numbers, true/false and null get
+// their own types, anything else is a string
+int parseValueText(const char *text, Value *value) {
+    char *end = NULL;
+
+    if (strcmp(text, "null") == 0) {
+        value->type = VALUE_NULL;
+        value->as.integer = 0;
+        return 1;
+    }
+    if (strcmp(text, "true") == 0 || strcmp(text, "false") == 0) {
+        value->type = VALUE_BOOL;
+        value->as.boolean = text[0] == 't';
+        return 1;
+    }
+
+    if (*text != '\0') {
+        errno = 0;
+        long long integer = strtoll(text, &end, 10);
+        if (*end == '\0' && errno != ERANGE && integer >= -(long long)VALUE_INT_LIMIT && integer <= (long long)VALUE_INT_LIMIT) {
+            value->type = VALUE_INT;
+            value->as.integer = integer;
+            return 1;
+        }
+
+        double number = strtod(text, &end);
+        if (*end == '\0' && isfinite(number)) {
+            value->type = VALUE_DOUBLE;
+            value->as.number = number;
+            return 1;
+        }
+    }
+
+    return stringValue(text, value);
+}
+
+// Print a value the way it reads best in the console, strings without quotes
+void printValue(FILE *stream, const Value *value) {
+    switch (value->type) {
+        case VALUE_BOOL:
+            fputs(value->as.boolean ? "true" : "false", stream);
+            break;
+        case VALUE_INT:
+            fprintf(stream, "%" PRId64, value->as.integer);
+            break;
+        case VALUE_DOUBLE: {
+            // Printed by cJSON on the stack, so the console shows what saveData writes
+            char buffer[32];
+            cJSON number;
+            memset(&number, 0, sizeof(number));
+            number.type = cJSON_Number;
+            cJSON_SetNumberValue(&number, value->as.number);
+            if (cJSON_PrintPreallocated(&number, buffer, sizeof(buffer), 0)) {
+                fputs(buffer, stream);
+            }
+            break;
+        }
+        case VALUE_STRING:
+            fputs(value->as.string, stream);
+            break;
+        case VALUE_JSON: {
+            char *text = cJSON_PrintUnformatted(value->as.json);
+            if (text) {
+                fputs(text, stream);
+                cJSON_free(text);
+            }
+            break;
+        }
+        case VALUE_NULL:
+        default:
+            fputs("null", stream);
+            break;
+    }
+}
+
+// Hand what a value owns over to the arena: strings are copied into it, subtrees are
+// deleted with it. Returns 0 when out of memory, the value is then left as it was.
+int moveValueToArena(Arena *arena, Value *value) {
+    if (value->type == VALUE_STRING) {
+        char *copy = arenaStrdup(arena, value->as.string);
+        if (!copy) return 0;
+        cJSON_free(value->as.string);
+        value->as.string = copy;
+    } else if (value->type == VALUE_JSON) {
+        return arenaAdoptTree(arena, value->as.json);
+    }
+    return 1;
+}
+
+// Release what a value owns
+void freeValue(Value *value) {
+    if (value->type == VALUE_STRING) {
+        cJSON_free(value->as.string);
+    } else if (value->type == VALUE_JSON) {
+        cJSON_Delete(value->as.json);
+    }
+    value->type = VALUE_NULL;
+    value->as.integer = 0;
+}
@@ -1,7 +1,15 @@
 #include "../inc/func.h" 
+#include "../cJSON/cJSON.h"
+#include "../inc/personIndex.h"
+#include "../inc/memTrack.h"
+#include "../inc/keyTable.h"
+#include "../inc/arena.h"
+#include "../inc/jsonIndex.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <math.h>
 #include <CUnit/CUnit.h>
 #include <CUnit/Basic.h>
 
@@ -31,21 +39,32 @@ void provideInput(const char *input) {
 // Test cases for addKeyValue function
 void test_addKeyValue(void) {
     // Test Case 1: Add a new key-value pair to an empty list
-    KeyValue *list = NULL;
+    KeyValueList list = { NULL, 0, 0 };
     CU_ASSERT_EQUAL(addKeyValue(&list, "key1", "value1"), 1);
-    CU_ASSERT_PTR_NOT_NULL(list);
-    CU_ASSERT_STRING_EQUAL(list->key, "key1");
-    CU_ASSERT_STRING_EQUAL(list->value, "value1");
-    CU_ASSERT_PTR_NULL(list->next);
+    CU_ASSERT_PTR_NOT_NULL(list.items);
+    CU_ASSERT_EQUAL(list.count, 1);
+    CU_ASSERT_STRING_EQUAL(keyName(list.items[0].key_id), "key1");
+    CU_ASSERT_STRING_EQUAL(list.items[0].value.as.string, "value1");
 
     // Test Case 2: Add a new key-value pair to a non-empty list
     CU_ASSERT_EQUAL(addKeyValue(&list, "key2", "value2"), 1);
-    CU_ASSERT_PTR_NOT_NULL(list);
-    CU_ASSERT_STRING_EQUAL(list->key, "key2");
-    CU_ASSERT_STRING_EQUAL(list->value, "value2");
-    CU_ASSERT_PTR_NOT_NULL(list->next);
-    CU_ASSERT_STRING_EQUAL(list->next->key, "key1");
-    CU_ASSERT_STRING_EQUAL(list->next->value, "value1");
+    CU_ASSERT_EQUAL(list.count, 2);
+    CU_ASSERT_STRING_EQUAL(keyName(list.items[0].key_id), "key1");
+    CU_ASSERT_STRING_EQUAL(list.items[0].value.as.string, "value1");
+    CU_ASSERT_STRING_EQUAL(keyName(list.items[1].key_id), "key2");
+    CU_ASSERT_STRING_EQUAL(list.items[1].value.as.string, "value2");
+
+    // Pairs stay in insertion order while the array grows
+    char key[16];
+    for (int i = 3; i <= 100; ++i) {
+        sprintf(key, "key%d", i);
+        CU_ASSERT_EQUAL(addKeyValue(&list, key, "value"), 1);
+    }
+    CU_ASSERT_EQUAL(list.count, 100);
+    CU_ASSERT(list.capacity >= 100);
+    CU_ASSERT_STRING_EQUAL(keyName(list.items[99].key_id), "key100");
+    CU_ASSERT_PTR_EQUAL(findKeyValue(&list, findKeyID("key57")), &list.items[56]);
+    CU_ASSERT_PTR_NULL(findKeyValue(&list, -1));
 
     // Test Case 3: Attempt to add a new key-value pair with NULL key or value
     // CU_ASSERT_EQUAL(addKeyValue(&list, NULL, "value3"), 0);
@@ -61,28 +80,22 @@ void test_freeKeyValueList() {
     CU_PASS("Null pointer test passed");
 
     // Test freeKeyValueList function with a single node
-    KeyValue *list2 = malloc(sizeof(KeyValue));
-    list2->key = strdup("key");
-    list2->value = strdup("value");
-    list2->next = NULL;
+    KeyValueList list2 = { NULL, 0, 0 };
+    addKeyValue(&list2, "key", "value");
 
     freeKeyValueList(&list2);
-    CU_ASSERT_PTR_NULL(list2);
+    CU_ASSERT_PTR_NULL(list2.items);
+    CU_ASSERT_EQUAL(list2.count, 0);
 
     // Test freeKeyValueList function with multiple nodes
-    KeyValue *list3 = malloc(sizeof(KeyValue));
-    list3->key = strdup("key1");
-    list3->value = strdup("value1");
-    list3->next = malloc(sizeof(KeyValue));
-    list3->next->key = strdup("key2");
-    list3->next->value = strdup("value2");
-    list3->next->next = malloc(sizeof(KeyValue));
-    list3->next->next->key = strdup("key3");
-    list3->next->next->value = strdup("value3");
-    list3->next->next->next = NULL;
+    KeyValueList list3 = { NULL, 0, 0 };
+    addKeyValue(&list3, "key1", "value1");
+    addKeyValue(&list3, "key2", "value2");
+    addKeyValue(&list3, "key3", "value3");
 
     freeKeyValueList(&list3);
-    CU_ASSERT_PTR_NULL(list3);
+    CU_ASSERT_PTR_NULL(list3.items);
+    CU_ASSERT_EQUAL(list3.count, 0);
 }
 
 
@@ -108,43 +121,1260 @@ void test_loadData(void) {
 }
 
 
+// Whether text was taken from one of the chunks of arena
+static int inArena(const Arena *arena, const char *text) {
+    for (const ArenaChunk *chunk = arena->chunks; chunk; chunk = chunk->next) {
+        const char *data = (const char *)(chunk + 1);
+        if (text >= data && text < data + chunk->size) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Same ids, keys and values in the same order
+static void assertSamePeople(const Person *actual, int num_actual, const Person *expected, int num_expected) {
+    CU_ASSERT_EQUAL_FATAL(num_actual, num_expected);
+    for (int i = 0; i < num_expected; ++i) {
+        CU_ASSERT_EQUAL(actual[i].id, expected[i].id);
+        CU_ASSERT_EQUAL_FATAL(actual[i].data.count, expected[i].data.count);
+        for (int j = 0; j < expected[i].data.count; ++j) {
+            cJSON *expected_json = valueToJSON(&expected[i].data.items[j].value);
+            cJSON *actual_json = valueToJSON(&actual[i].data.items[j].value);
+            CU_ASSERT_EQUAL(actual[i].data.items[j].key_id, expected[i].data.items[j].key_id);
+            CU_ASSERT_TRUE(cJSON_Compare(expected_json, actual_json, 1));
+            cJSON_Delete(expected_json);
+            cJSON_Delete(actual_json);
+        }
+    }
+}
+
+void test_loadDataWithOptions(void) {
+    LoadOptions read_options = { LOAD_INPUT_READ, LOAD_ENGINE_CJSON };
+    LoadOptions mmap_options = { LOAD_INPUT_MMAP, LOAD_ENGINE_CJSON };
+
+    // Both input paths give the same people
+    int num_read = 0, num_mapped = 0;
+    Person *read_people = loadDataWithOptions("./tests/testLoadData.json", &num_read, &read_options);
+    Person *mapped_people = loadDataWithOptions("./tests/testLoadData.json", &num_mapped, &mmap_options);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(read_people);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(mapped_people);
+    CU_ASSERT_EQUAL(num_read, 2);
+    CU_ASSERT_EQUAL(num_mapped, 2);
+    CU_ASSERT_EQUAL(mapped_people[1].id, read_people[1].id);
+    CU_ASSERT_STRING_EQUAL(mapped_people[1].data.items[0].value.as.string, read_people[1].data.items[0].value.as.string);
+    freePeople(read_people, num_read);
+    freePeople(mapped_people, num_mapped);
+
+    // The indexed parser gives the same people as cJSON
+    LoadOptions indexed_options = { LOAD_INPUT_MMAP, LOAD_ENGINE_INDEXED };
+    int num_cjson = 0, num_indexed = 0;
+    Person *cjson_people = loadDataWithOptions("./tests/test_saveData.json", &num_cjson, &mmap_options);
+    Person *indexed_people = loadDataWithOptions("./tests/test_saveData.json", &num_indexed, &indexed_options);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(cjson_people);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(indexed_people);
+    assertSamePeople(indexed_people, num_indexed, cjson_people, num_cjson);
+    freePeople(cjson_people, num_cjson);
+    freePeople(indexed_people, num_indexed);
+
+    // So does parsing in situ, which reads into a heap buffer with either input option, and the file stays as it was
+    LoadOptions in_situ_options[] = { { LOAD_INPUT_MMAP, LOAD_ENGINE_CJSON_IN_SITU }, { LOAD_INPUT_READ, LOAD_ENGINE_CJSON_IN_SITU } };
+    for (int i = 0; i < 2; ++i) {
+        int num_in_situ = 0;
+        cjson_people = loadDataWithOptions("./tests/test_saveData.json", &num_cjson, &mmap_options);
+        Person *in_situ_people = loadDataWithOptions("./tests/test_saveData.json", &num_in_situ, &in_situ_options[i]);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(in_situ_people);
+        assertSamePeople(in_situ_people, num_in_situ, cjson_people, num_cjson);
+
+        // The strings were copied into the arena of the dataset, none points into the file content
+        for (int p = 0; p < num_in_situ; ++p) {
+            CU_ASSERT_PTR_NOT_NULL_FATAL(in_situ_people[p].arena);
+            for (int j = 0; j < in_situ_people[p].data.count; ++j) {
+                const Value *value = &in_situ_people[p].data.items[j].value;
+                if (value->type == VALUE_STRING) {
+                    CU_ASSERT_TRUE(inArena(in_situ_people[p].arena, value->as.string));
+                }
+            }
+        }
+        freePeople(cjson_people, num_cjson);
+        freePeople(in_situ_people, num_in_situ);
+    }
+
+    // A pipe cannot be mapped and goes through the read path
+    const char *json = "{\"people\": [{\"id\": 4, \"name\": \"Piped\"}]}";
+    int fds[2];
+    CU_ASSERT_EQUAL_FATAL(pipe(fds), 0);
+    CU_ASSERT_EQUAL(write(fds[1], json, strlen(json)), (ssize_t)strlen(json));
+    close(fds[1]);
+
+    char pipe_name[64];
+    snprintf(pipe_name, sizeof(pipe_name), "/proc/self/fd/%d", fds[0]);
+    int num_piped = 0;
+    Person *piped = loadDataWithOptions(pipe_name, &num_piped, &mmap_options);
+    close(fds[0]);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(piped);
+    CU_ASSERT_EQUAL(num_piped, 1);
+    CU_ASSERT_EQUAL(piped[0].id, 4);
+    freePeople(piped, num_piped);
+
+    // Missing files fail in both modes
+    int num_missing = 0;
+    CU_ASSERT_PTR_NULL(loadDataWithOptions("src/badfilename.json", &num_missing, &read_options));
+    CU_ASSERT_PTR_NULL(loadDataWithOptions("src/badfilename.json", &num_missing, &mmap_options));
+}
+
+
+void test_loadDataStreaming(void) {
+    // Same result as the DOM loader
+    int num_people = 0, num_expected = 0;
+    Person *people = loadDataStreaming("./tests/testLoadData.json", &num_people);
+    Person *expected = loadData("./tests/testLoadData.json", &num_expected);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(expected);
+    CU_ASSERT_EQUAL(num_people, num_expected);
+    for (int i = 0; i < num_people && i < num_expected; ++i) {
+        CU_ASSERT_EQUAL(people[i].id, expected[i].id);
+        CU_ASSERT_EQUAL_FATAL(people[i].data.count, expected[i].data.count);
+        CU_ASSERT_EQUAL(people[i].data.items[0].key_id, expected[i].data.items[0].key_id);
+        CU_ASSERT_STRING_EQUAL(people[i].data.items[0].value.as.string, expected[i].data.items[0].value.as.string);
+    }
+    freePeople(people, num_people);
+    freePeople(expected, num_expected);
+
+    // "people" after other keys, brackets inside strings and a record bigger than one read chunk
+    const char *filename = "test_stream.json";
+    FILE *fp = fopen(filename, "w");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(fp);
+    fprintf(fp, "{\"meta\": {\"note\": \"not ] here \\\" }\", \"list\": [1, [2]]},\n \"People\" : [ ");
+    fprintf(fp, "{\"id\": 1, \"name\": \"A\"}, {\"id\": 2, \"bio\": \"");
+    for (int i = 0; i < 100000; ++i) fputc('x', fp);
+    fprintf(fp, "\"}, {\"id\": 3} ]}");
+    fclose(fp);
+
+    int num_stream = 0;
+    Person *streamed = loadDataStreaming(filename, &num_stream);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(streamed);
+    CU_ASSERT_EQUAL(num_stream, 3);
+    CU_ASSERT_EQUAL(streamed[1].id, 2);
+    CU_ASSERT_EQUAL(strlen(streamed[1].data.items[0].value.as.string), 100000);
+    CU_ASSERT_EQUAL(streamed[2].id, 3);
+    CU_ASSERT_EQUAL(streamed[2].data.count, 0);
+    freePeople(streamed, num_stream);
+
+    // A broken record fails the whole load
+    fp = fopen(filename, "w");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(fp);
+    fprintf(fp, "{\"people\": [{\"id\": 1}, {\"id\": }]}");
+    fclose(fp);
+    CU_ASSERT_PTR_NULL(loadDataStreaming(filename, &num_stream));
+    remove(filename);
+
+    CU_ASSERT_PTR_NULL(loadDataStreaming("src/badfilename.json", &num_stream));
+}
+
+
+// Whole file as a string, NULL when it cannot be read
+static char *readTestFile(const char *filename) {
+    FILE *fp = fopen(filename, "r");
+    if (!fp) return NULL;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char *content = malloc(size + 1);
+    size_t read = fread(content, 1, size, fp);
+    content[read] = '\0';
+    fclose(fp);
+    return content;
+}
+
+void test_loadDataParallel(void) {
+    // Strings full of separators, brackets, quotes and backslashes, nested values and keys
+    // around the array, so the pieces start in every possible state
+    const char *path = "./test_parallel.json";
+    FILE *file = fopen(path, "w");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(file);
+    fprintf(file, "{\"before\": {\"people\": [1, 2]}, \"people\": [");
+    for (int i = 0; i < 200; ++i) {
+        fprintf(file, "%s{\"id\": %d, \"name\": \"a, b], {c\\\"d\\\\\", \"path\": \"C:\\\\dir\\\\\", "
+                      "\"tags\": [\"x\", {\"y\": [%d, \"]\"]}], \"salary\": %d.5}",
+                i ? " , " : "", i + 1, i, 1000 + i);
+    }
+    fprintf(file, "], \"after\": [{\"id\": 0}, \"}\"]}");
+    fclose(file);
+
+    int num_expected = 0;
+    Person *expected = loadDataStreaming(path, &num_expected);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(expected);
+    CU_ASSERT_EQUAL(num_expected, 200);
+
+    for (int threads = 1; threads <= 13; threads += 3) {
+        int num_people = 0;
+        Person *people = loadDataParallel(path, &num_people, threads);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+        assertSamePeople(people, num_people, expected, num_expected);
+        freePeople(people, num_people);
+    }
+    freePeople(expected, num_expected);
+
+    // The automatic thread count loads the test file like loadData
+    int num_loaded = 0, num_people = 0;
+    Person *loaded = loadData("./tests/test_saveData.json", &num_loaded);
+    Person *people = loadDataParallel("./tests/test_saveData.json", &num_people, 0);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(loaded);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+    assertSamePeople(people, num_people, loaded, num_loaded);
+    PersonIndex index = { NULL, 0, 0, 0 };
+    CU_ASSERT_TRUE(buildPersonIndex(&index, people, num_people));
+    CU_ASSERT_EQUAL(findPersonSlot(&index, people[num_people - 1].id), num_people - 1);
+    freePersonIndex(&index);
+    freePeople(loaded, num_loaded);
+    freePeople(people, num_people);
+
+    // A long sibling after the array comes back to the depth of the people, its commas
+    // and braces are no separators for the pieces that start in it
+    for (int s = 0; s < 2; ++s) {
+        file = fopen(path, "w");
+        CU_ASSERT_PTR_NOT_NULL_FATAL(file);
+        fprintf(file, "{\"people\": [");
+        for (int i = 0; i < 50; ++i) {
+            fprintf(file, "%s{\"id\": %d, \"name\": \"p%d\"}", i ? ", " : "", i + 1, i);
+        }
+        fprintf(file, "], \"extra\": %c", s ? '{' : '[');
+        for (int i = 0; i < 2000; ++i) {
+            fprintf(file, i ? ", " : "");
+            fprintf(file, s ? "\"k%d\": %d" : "%d", i, i);
+        }
+        fprintf(file, "%c}", s ? '}' : ']');
+        fclose(file);
+
+        loaded = loadData(path, &num_loaded);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(loaded);
+        CU_ASSERT_EQUAL(num_loaded, 50);
+        for (int threads = 2; threads <= 8; threads *= 2) {
+            people = loadDataParallel(path, &num_people, threads);
+            CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+            assertSamePeople(people, num_people, loaded, num_loaded);
+            freePeople(people, num_people);
+        }
+        freePeople(loaded, num_loaded);
+    }
+
+    // An empty array, a truncated one and a missing file
+    file = fopen(path, "w");
+    fprintf(file, "{\"people\": [ ]}");
+    fclose(file);
+    num_people = -1;
+    people = loadDataParallel(path, &num_people, 4);
+    CU_ASSERT_PTR_NOT_NULL(people);
+    CU_ASSERT_EQUAL(num_people, 0);
+    freePeople(people, num_people);
+
+    file = fopen(path, "w");
+    fprintf(file, "{\"people\": [{\"id\": 1}, {\"id\": 2}, {\"id\": ");
+    fclose(file);
+    CU_ASSERT_PTR_NULL(loadDataParallel(path, &num_people, 3));
+    CU_ASSERT_PTR_NULL(loadDataParallel("src/badfilename.json", &num_people, 2));
+    remove(path);
+}
+
+void test_loadDataColumnar(void) {
+    // Keys stay in the key table, so they are added before the baseline is taken
+    internKey("x");
+    internKey("s");
+    internKey("b");
+    internKey("job");
+    size_t baseline = memTrackLiveBytes();
+
+    ColumnStore *store = loadDataColumnar("./tests/testLoadData.json");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(store);
+    CU_ASSERT_EQUAL(store->num_rows, 2);
+    CU_ASSERT_EQUAL(store->num_columns, 6);
+    CU_ASSERT_EQUAL(store->ids[1], 2);
+
+    // Columns get the type of their values
+    const Column *name = findColumn(store, "name");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(name);
+    CU_ASSERT_EQUAL(name->type, COLUMN_STRING);
+    CU_ASSERT_STRING_EQUAL(columnString(name, 0), "Jane Doe");
+    CU_ASSERT_STRING_EQUAL(columnString(name, 1), "John Doe");
+    CU_ASSERT_EQUAL(findColumn(store, "salary")->type, COLUMN_NUMBER);
+    CU_ASSERT_PTR_NULL(findColumn(store, "no such key"));
+
+    ColumnStats stats;
+    CU_ASSERT_EQUAL(columnStats(store, "salary", &stats), 1);
+    CU_ASSERT_EQUAL(stats.count, 2);
+    CU_ASSERT_DOUBLE_EQUAL(stats.sum, 95000.75, 1e-9);
+    CU_ASSERT_DOUBLE_EQUAL(stats.min, 35000.0, 0.0);
+    CU_ASSERT_DOUBLE_EQUAL(stats.max, 60000.75, 0.0);
+    CU_ASSERT_DOUBLE_EQUAL(stats.mean, 47500.375, 1e-9);
+    CU_ASSERT_EQUAL(columnStats(store, "name", &stats), 0);
+
+    // Saving the columns gives the same file as saving the people
+    CU_ASSERT_EQUAL(saveColumns("test_columns.json", store), 1);
+    freeColumnStore(store);
+    int num_people = 0;
+    Person *people = loadData("./tests/testLoadData.json", &num_people);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+    saveData("test_people.json", people, num_people);
+    freePeople(people, num_people);
+
+    char *columns = readTestFile("test_columns.json");
+    char *expected = readTestFile("test_people.json");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(columns);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(expected);
+    CU_ASSERT_STRING_EQUAL(columns, expected);
+    free(columns);
+    free(expected);
+    remove("test_columns.json");
+    remove("test_people.json");
+
+    // Missing keys, nulls, mixed types and a different key order
+    FILE *fp = fopen("test_columnar.json", "w");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(fp);
+    fprintf(fp, "{\"people\": [{\"id\": 1, \"x\": 1, \"s\": null, \"b\": true}, {\"id\": 2, \"x\": \"two\", \"s\": \"y\"}, {\"id\": 3}, "
+                "{\"s\": \"z\", \"id\": 4, \"job\": null, \"x\": 2.5}, {\"id\": 5, \"s\": \"w\", \"job\": null, \"x\": [1, 2]}]}");
+    fclose(fp);
+    store = loadDataColumnar("test_columnar.json");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(store);
+    CU_ASSERT_EQUAL(store->num_rows, 5);
+    CU_ASSERT_EQUAL(store->num_layouts, 3);
+
+    const Column *x = findColumn(store, "x");
+    CU_ASSERT_EQUAL_FATAL(x->type, COLUMN_VALUE);
+    CU_ASSERT_EQUAL(x->values[0].type, VALUE_INT);
+    CU_ASSERT_STRING_EQUAL(x->values[1].as.string, "two");
+    CU_ASSERT_FALSE(columnIsValid(x, 2));
+    CU_ASSERT_EQUAL(columnStats(store, "x", &stats), 1);
+    CU_ASSERT_EQUAL(stats.count, 2);
+
+    const Column *text = findColumn(store, "s");
+    CU_ASSERT_EQUAL_FATAL(text->type, COLUMN_STRING);
+    CU_ASSERT_PTR_NULL(columnString(text, 0));
+    CU_ASSERT_STRING_EQUAL(columnString(text, 1), "y");
+    CU_ASSERT_PTR_NULL(columnString(text, 2));
+    CU_ASSERT_TRUE(columnIsNull(text, 0));
+    CU_ASSERT_FALSE(columnIsNull(text, 2));
+    CU_ASSERT_EQUAL(findColumn(store, "b")->type, COLUMN_VALUE);
+    const Column *job = findColumn(store, "job");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(job);
+    CU_ASSERT_TRUE(columnIsNull(job, 3));
+    CU_ASSERT_FALSE(columnIsValid(job, 3));
+
+    // Nulls and the key order of every row survive saving, like with saveData
+    CU_ASSERT_EQUAL(saveColumns("test_columns.json", store), 1);
+    freeColumnStore(store);
+    people = loadData("test_columnar.json", &num_people);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+    saveData("test_people.json", people, num_people);
+    freePeople(people, num_people);
+    remove("test_columnar.json");
+    columns = readTestFile("test_columns.json");
+    expected = readTestFile("test_people.json");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(columns);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(expected);
+    CU_ASSERT_STRING_EQUAL(columns, expected);
+    free(columns);
+    free(expected);
+    remove("test_columns.json");
+    remove("test_people.json");
+
+    CU_ASSERT_PTR_NULL(loadDataColumnar("src/badfilename.json"));
+    CU_ASSERT_EQUAL(memTrackLiveBytes(), baseline);
+}
+
+
+void test_arrayCursor(void) {
+    cJSON *array = cJSON_Parse("[10, 11, 12, 13]");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(array);
+
+    // Next visits the items in order and stops at the end
+    cJSON_ArrayCursor cursor;
+    cJSON_ArrayCursorInit(&cursor, array);
+    for (int i = 0; i < 4; ++i) {
+        cJSON *item = cJSON_ArrayCursorNext(&cursor);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(item);
+        CU_ASSERT_EQUAL(item->valueint, 10 + i);
+        CU_ASSERT_EQUAL(cursor.index, i);
+    }
+    CU_ASSERT_PTR_NULL(cJSON_ArrayCursorNext(&cursor));
+    CU_ASSERT_PTR_NULL(cJSON_ArrayCursorNext(&cursor));
+
+    // Seek goes forward from the current item and restarts when going back
+    CU_ASSERT_EQUAL(cJSON_ArrayCursorSeek(&cursor, 2)->valueint, 12);
+    CU_ASSERT_EQUAL(cJSON_ArrayCursorSeek(&cursor, 3)->valueint, 13);
+    CU_ASSERT_EQUAL(cJSON_ArrayCursorSeek(&cursor, 0)->valueint, 10);
+    CU_ASSERT_PTR_NULL(cJSON_ArrayCursorSeek(&cursor, 4));
+    CU_ASSERT_PTR_NULL(cJSON_ArrayCursorSeek(&cursor, -1));
+
+    cJSON_Delete(array);
+}
+
+
+void test_parseStringSimd(void) {
+    char json[128];
+    char expected[128];
+    int levels = cJSON_GetSimdLevel() + 1;
+
+    // Put an escape and then the closing quote at every offset around the 16 and 32 byte
+    // blocks and check each kernel decodes the same string
+    for (int level = 0; level < levels; ++level) {
+        CU_ASSERT_EQUAL(cJSON_SetSimdLevel(level), level);
+        for (int escape_at = 0; escape_at < 70; ++escape_at) {
+            int length = 0, expected_length = 0;
+            json[length++] = '"';
+            for (int i = 0; i < escape_at; ++i) {
+                json[length++] = expected[expected_length++] = (char)('a' + i % 26);
+            }
+            json[length++] = '\\';
+            json[length++] = 'n';
+            expected[expected_length++] = '\n';
+            for (int i = 0; i < escape_at % 37; ++i) {
+                json[length++] = expected[expected_length++] = (char)('A' + i % 26);
+            }
+            json[length++] = '"';
+            expected[expected_length] = '\0';
+
+            cJSON *item = cJSON_ParseWithLength(json, length);
+            CU_ASSERT_PTR_NOT_NULL_FATAL(item);
+            CU_ASSERT_STRING_EQUAL(cJSON_GetStringValue(item), expected);
+            cJSON_Delete(item);
+
+            // Without the closing quote the string is rejected, also when it ends in a backslash
+            CU_ASSERT_PTR_NULL(cJSON_ParseWithLength(json, length - 1));
+            CU_ASSERT_PTR_NULL(cJSON_ParseWithLength(json, escape_at + 2));
+        }
+    }
+
+    cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
+    CU_ASSERT_EQUAL(cJSON_GetSimdLevel(), levels - 1);
+}
+
+void test_parseNumber(void) {
+    // Halfway cases, the limits of the fast paths and numbers strtod has to handle
+    const char *numbers[] = {
+        "0", "-0", "0.0", "-0.0e5", "7", "-42", "1234567890123456789", "12345678901234567890",
+        "9007199254740993", "9007199254740995", "18446744073709551615", "0.1", "0.3", "-2.5e-3",
+        "1e22", "1e23", "8.98846567431158e307", "1.7976931348623157e308", "2.2250738585072014e-308",
+        "4.9406564584124654e-324", "1e-64", "1e64", "1e-65", "1e65", "1e400",
+        "7.2057594037927933e16", "1.00000000000000011102230246251565404236316680908203125",
+        "123456789012345678e-30", "3.14159265358979323846", "100000000000000000000000000e-26",
+        "1.5E+10", "2e0"
+    };
+    char text[64];
+    double number = 1.0 / 3.0;
+
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); ++i) {
+        double expected = strtod(numbers[i], NULL);
+        cJSON *item = cJSON_Parse(numbers[i]);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(item);
+        CU_ASSERT(memcmp(&item->valuedouble, &expected, sizeof(expected)) == 0);
+        cJSON_Delete(item);
+    }
+
+    // Every digit count and a wide range of exponents
+    for (int i = 0; i < 2000; ++i) {
+        snprintf(text, sizeof(text), "%.*g", 1 + i % 17, number);
+        double expected = strtod(text, NULL);
+        cJSON *item = cJSON_Parse(text);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(item);
+        CU_ASSERT(memcmp(&item->valuedouble, &expected, sizeof(expected)) == 0);
+        cJSON_Delete(item);
+        number *= (i % 3 == 0) ? 0.37 : 7.3;
+        if (number > 1e100 || number < 1e-100) number = 1.0 / (i + 3);
+    }
+
+    // Numbers end where strtod would stop, also inside arrays
+    cJSON *array = cJSON_Parse("[1,-2.5,3e2,0.125]");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(array);
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(array), 4);
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(array, 2)->valueint, 300);
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(array, 3)->valuedouble, 0.125);
+    cJSON_Delete(array);
+    array = cJSON_Parse("1.");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(array);
+    CU_ASSERT_EQUAL(array->valuedouble, 1.0);
+    cJSON_Delete(array);
+    CU_ASSERT_PTR_NULL(cJSON_Parse("-"));
+    CU_ASSERT_PTR_NULL(cJSON_Parse("[1e]"));
+}
+
+void test_printNumber(void) {
+    // Integers, the %1.15g format when 15 digits are enough and the shortest digits otherwise
+    const double numbers[] = { 0, -0.0, 7, -42, 2147483647.0, -2147483648.0, 2147483648.0, 1e15, 1e17,
+                               0.1, 0.3, 30000.5, -2.5e-3, 1e-5, 0.0001, 123456789012.5, 1e21, 1e100,
+                               0.1 + 0.2, 1.0 / 3.0, 5e-324, 1.7976931348623157e308 };
+    const char *expected[] = { "0", "0", "7", "-42", "2147483647", "-2147483648", "2147483648", "1e+15", "1e+17",
+                               "0.1", "0.3", "30000.5", "-0.0025", "1e-05", "0.0001", "123456789012.5", "1e+21", "1e+100",
+                               "0.30000000000000004", "0.3333333333333333", "5e-324", "1.7976931348623157e+308" };
+    char text[64];
+
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); ++i) {
+        cJSON *item = cJSON_CreateNumber(numbers[i]);
+        CU_ASSERT_TRUE_FATAL(cJSON_PrintPreallocated(item, text, sizeof(text), 0));
+        CU_ASSERT_STRING_EQUAL(text, expected[i]);
+        cJSON_Delete(item);
+    }
+
+    // Everything parses back to the same double
+    double number = 1.0 / 7.0;
+    for (int i = 0; i < 2000; ++i) {
+        cJSON *item = cJSON_CreateNumber(i % 2 ? number : -number);
+        CU_ASSERT_TRUE_FATAL(cJSON_PrintPreallocated(item, text, sizeof(text), 0));
+        double parsed = strtod(text, NULL);
+        CU_ASSERT(memcmp(&parsed, &item->valuedouble, sizeof(parsed)) == 0);
+        cJSON_Delete(item);
+        number *= (i % 3 == 0) ? 1e-7 : 913.7;
+        if (number > 1e300 || number < 1e-300) number = 1.0 / (i + 3);
+    }
+
+    // Not a number is printed as null
+    cJSON *item = cJSON_CreateNumber(NAN);
+    CU_ASSERT_TRUE_FATAL(cJSON_PrintPreallocated(item, text, sizeof(text), 0));
+    CU_ASSERT_STRING_EQUAL(text, "null");
+    cJSON_Delete(item);
+}
+
+void test_printStringSimd(void) {
+    char text[128];
+    char expected[256];
+    char printed[256];
+    int levels = cJSON_GetSimdLevel() + 1;
+
+    // Put a character that needs escaping at every offset around the 16 and 32 byte
+    // blocks and check each kernel prints the same text
+    const char specials[] = { '"', '\\', '\n', '\x01', '\x1f' };
+    const char *escaped[] = { "\\\"", "\\\\", "\\n", "\\u0001", "\\u001f" };
+    for (int level = 0; level < levels; ++level) {
+        CU_ASSERT_EQUAL(cJSON_SetSimdLevel(level), level);
+        for (int at = 0; at < 70; ++at) {
+            int special = at % 5;
+            int length = 0;
+            int expected_length = sprintf(expected, "\"");
+            for (int i = 0; i < at; ++i) {
+                text[length++] = expected[expected_length++] = (char)('a' + i % 26);
+            }
+            text[length++] = specials[special];
+            expected_length += sprintf(expected + expected_length, "%s", escaped[special]);
+            for (int i = 0; i < at % 37; ++i) {
+                text[length++] = expected[expected_length++] = (char)('A' + i % 26);
+            }
+            text[length] = '\0';
+            sprintf(expected + expected_length, "\"");
+
+            cJSON *item = cJSON_CreateString(text);
+            CU_ASSERT_TRUE_FATAL(cJSON_PrintPreallocated(item, printed, sizeof(printed), 0));
+            CU_ASSERT_STRING_EQUAL(printed, expected);
+
+            // Without the special character nothing is escaped
+            text[at] = 'x';
+            cJSON_SetValuestring(item, text);
+            CU_ASSERT_TRUE_FATAL(cJSON_PrintPreallocated(item, printed, sizeof(printed), 0));
+            CU_ASSERT_EQUAL(strlen(printed), strlen(text) + 2);
+            CU_ASSERT_EQUAL(strncmp(printed + 1, text, strlen(text)), 0);
+            cJSON_Delete(item);
+        }
+    }
+
+    cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
+}
+
+void test_minifySimd(void) {
+    const char *pretty = "{\n\t\"people\":\t[{\n\t\t\t\"id\":\t1, // first\n"
+                         "\t\t\t\"note\":\t\"a  b\\\"  c\\\\\", /* \"not\" a string */\n"
+                         "\t\t\t\"path\":\t\"/x/ //y\"\r\n\t\t}, {\n\t\t\t\"id\":\t2\n\t\t}]\n}";
+    const char *expected = "{\"people\":[{\"id\":1,\"note\":\"a  b\\\"  c\\\\\",\"path\":\"/x/ //y\"},{\"id\":2}]}";
+    char json[256];
+    char spaced[256];
+    int levels = cJSON_GetSimdLevel() + 1;
+
+    for (int level = 0; level < levels; ++level) {
+        CU_ASSERT_EQUAL(cJSON_SetSimdLevel(level), level);
+
+        // Comments and whitespace go, whitespace in strings stays
+        strcpy(json, pretty);
+        cJSON_Minify(json);
+        CU_ASSERT_STRING_EQUAL(json, expected);
+
+        // Runs of whitespace of every length around the 16 and 32 byte blocks
+        for (int run = 0; run < 70; ++run) {
+            int length = sprintf(spaced, "[1,");
+            for (int i = 0; i < run; ++i) {
+                spaced[length++] = " \t\r\n"[i % 4];
+            }
+            sprintf(spaced + length, "\"x\"]");
+
+            cJSON *array = cJSON_Parse(spaced);
+            CU_ASSERT_PTR_NOT_NULL_FATAL(array);
+            CU_ASSERT_STRING_EQUAL(cJSON_GetStringValue(cJSON_GetArrayItem(array, 1)), "x");
+            cJSON_Delete(array);
+
+            cJSON_Minify(spaced);
+            CU_ASSERT_STRING_EQUAL(spaced, "[1,\"x\"]");
+        }
+    }
+
+    cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
+}
+
+void test_parseStrictUtf8(void) {
+    const char *valid[] = {
+        "\"plain ascii\"", "\"\xC3\xA9t\xC3\xA9\"", "\"\xE2\x82\xAC \xE6\x97\xA5\xE6\x9C\xAC\"",
+        "\"\xF0\x9F\x98\x80\"", "\"\xED\x9F\xBF\xEE\x80\x80\"", "\"\xF4\x8F\xBF\xBF\"", "\"\\u00e9\\uD83D\\uDE00\""
+    };
+    const char *invalid[] = {
+        "\"\xC0\xAF\"",             // overlong '/'
+        "\"\xE0\x80\xAF\"",         // overlong in three bytes
+        "\"\xED\xA0\x80\"",         // encoded surrogate
+        "\"\xF4\x90\x80\x80\"",     // above U+10FFFF
+        "\"\xF5\x80\x80\x80\"",     // invalid lead byte
+        "\"\x80\"",                 // lone continuation
+        "\"\xE2\x82\"",             // cut short by the quote
+        "\"\xC3\xA9\xC3\""
+    };
+    char text[128];
+    int levels = cJSON_GetSimdLevel() + 1;
+
+    for (int level = 0; level < levels; ++level) {
+        CU_ASSERT_EQUAL(cJSON_SetSimdLevel(level), level);
+        for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); ++i) {
+            cJSON *item = cJSON_ParseWithFlags(valid[i], strlen(valid[i]) + 1, NULL, CJSON_PARSE_STRICT_UTF8);
+            CU_ASSERT_PTR_NOT_NULL(item);
+            cJSON_Delete(item);
+        }
+        for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+            // Only the strict mode looks at the bytes
+            cJSON *item = cJSON_Parse(invalid[i]);
+            CU_ASSERT_PTR_NOT_NULL(item);
+            cJSON_Delete(item);
+            CU_ASSERT_PTR_NULL(cJSON_ParseWithFlags(invalid[i], strlen(invalid[i]) + 1, NULL, CJSON_PARSE_STRICT_UTF8));
+        }
+
+        // A bad sequence at every offset around the 16 and 32 byte blocks
+        for (int at = 0; at < 70; ++at) {
+            int length = sprintf(text, "\"");
+            for (int i = 0; i < at; ++i) {
+                text[length++] = (char)('a' + i % 26);
+            }
+            length += sprintf(text + length, "\xE2\x82\xAC");
+            sprintf(text + length, "%.*s\"", at % 11, "bcdefghijkl");
+            cJSON *item = cJSON_ParseWithFlags(text, strlen(text) + 1, NULL, CJSON_PARSE_STRICT_UTF8);
+            CU_ASSERT_PTR_NOT_NULL(item);
+            CU_ASSERT_EQUAL(strlen(cJSON_GetStringValue(item)), (size_t)at + 3 + at % 11);
+            cJSON_Delete(item);
+
+            text[length - 1] = 'x';
+            CU_ASSERT_PTR_NULL(cJSON_ParseWithFlags(text, strlen(text) + 1, NULL, CJSON_PARSE_STRICT_UTF8));
+        }
+    }
+    cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
+
+    // Invalid hex digits in \u escapes used to be read as 0
+    cJSON *item = cJSON_Parse("\"\\u00g1\"");
+    CU_ASSERT_PTR_NOT_NULL(item);
+    cJSON_Delete(item);
+    CU_ASSERT_PTR_NULL(cJSON_ParseWithFlags("\"\\u00g1\"", 9, NULL, CJSON_PARSE_STRICT_UTF8));
+    CU_ASSERT_PTR_NULL(cJSON_ParseWithFlags("\"\\uD83D\\uDE0x\"", 15, NULL, CJSON_PARSE_STRICT_UTF8));
+    CU_ASSERT_PTR_NULL(cJSON_ParseWithFlags("\"\\uD83D\"", 9, NULL, CJSON_PARSE_STRICT_UTF8));
+
+    // The other flag still works
+    CU_ASSERT_PTR_NULL(cJSON_ParseWithFlags("\"a\" x", 6, NULL, CJSON_PARSE_REQUIRE_NULL_TERMINATED | CJSON_PARSE_STRICT_UTF8));
+}
+
+void test_parseContext(void) {
+    const char *text = "{\"people\": [{\"id\": 1, \"name\": \"Jane \\\"Doe\\\"\", \"tags\": [\"a\", null, true, 1.5]},"
+                       " {\"id\": 2, \"name\": \"\\u00e9\", \"nested\": {\"k\": []}}]}";
+    cJSON_Context *context = cJSON_CreateContext();
+    CU_ASSERT_PTR_NOT_NULL_FATAL(context);
+
+    for (int round = 0; round < 3; ++round) {
+        // Same tree as a plain parse, with every item and string in the context
+        cJSON *expected = cJSON_Parse(text);
+        cJSON *pooled = cJSON_ParseWithContext(context, text, strlen(text), NULL, 0);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(pooled);
+        CU_ASSERT_TRUE(cJSON_Compare(expected, pooled, 1));
+        CU_ASSERT_TRUE(pooled->type & cJSON_IsPooled);
+        cJSON *person = cJSON_GetArrayItem(cJSON_GetObjectItem(pooled, "people"), 0);
+        cJSON *name = cJSON_GetObjectItem(person, "name");
+        CU_ASSERT_TRUE((name->type & (cJSON_IsPooled | cJSON_IsReference | cJSON_StringIsConst)) ==
+                       (cJSON_IsPooled | cJSON_IsReference | cJSON_StringIsConst));
+
+        // A copy does not depend on the context
+        cJSON *copy = cJSON_Duplicate(pooled, 1);
+        CU_ASSERT_FALSE(copy->type & cJSON_IsPooled);
+
+        // Pooled items can still be changed and moved to other trees
+        CU_ASSERT_PTR_NOT_NULL(cJSON_SetValuestring(name, "Jo"));
+        CU_ASSERT_PTR_NOT_NULL(cJSON_SetValuestring(name, "a name longer than the one parsed"));
+        CU_ASSERT_STRING_EQUAL(name->valuestring, "a name longer than the one parsed");
+        cJSON_AddNumberToObject(person, "added", 3);
+        cJSON_AddItemToObject(copy, "tags", cJSON_DetachItemFromObject(person, "tags"));
+        cJSON_Delete(cJSON_DetachItemFromObject(person, "id"));
+
+        // Frees only what was added from the heap, the rest goes with the context
+        cJSON_Delete(pooled);
+        cJSON_Delete(copy);
+        cJSON_Delete(expected);
+        cJSON_ResetContext(context);
+    }
+
+    // Failed parses leave nothing behind either
+    CU_ASSERT_PTR_NULL(cJSON_ParseWithContext(context, "[\"a\", {\"b\": [1, }", 17, NULL, 0));
+    CU_ASSERT_PTR_NULL(cJSON_ParseWithContext(context, "", 0, NULL, 0));
+
+    // Without a context it is the plain parse
+    cJSON *heap = cJSON_ParseWithContext(NULL, "[\"a\"]", 5, NULL, 0);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(heap);
+    CU_ASSERT_FALSE(heap->child->type & (cJSON_IsPooled | cJSON_IsReference));
+    cJSON_Delete(heap);
+
+    cJSON_DeleteContext(context);
+}
+
+void test_parseInSitu(void) {
+    char text[] = "{\"name\": \"Jane Doe\", \"quoted\": \"a \\\"b\\\"\", \"t\\u00e9\": [\"x\", 1]}";
+    char original[sizeof(text)];
+    memcpy(original, text, sizeof(text));
+    cJSON *expected = cJSON_Parse(original);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(expected);
+
+    // Strings and keys without escapes point into the text, the others are decoded
+    cJSON *root = cJSON_ParseWithFlags(text, sizeof(text), NULL, CJSON_PARSE_IN_SITU);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(root);
+    CU_ASSERT_TRUE(cJSON_Compare(expected, root, 1));
+    cJSON *name = cJSON_GetObjectItem(root, "name");
+    CU_ASSERT_PTR_EQUAL(name->string, text + 2);
+    CU_ASSERT_PTR_EQUAL(name->valuestring, text + 10);
+    CU_ASSERT_TRUE((name->type & (cJSON_IsReference | cJSON_StringIsConst)) == (cJSON_IsReference | cJSON_StringIsConst));
+    cJSON *quoted = cJSON_GetObjectItem(root, "quoted");
+    CU_ASSERT_TRUE(quoted->valuestring < text || quoted->valuestring >= text + sizeof(text));
+    CU_ASSERT_FALSE(quoted->type & cJSON_IsReference);
+    CU_ASSERT_FALSE(cJSON_GetArrayItem(root, 2)->type & cJSON_StringIsConst);
+
+    // A copy does not point into the text
+    cJSON *copy = cJSON_Duplicate(root, 1);
+    cJSON_Delete(root);
+    memset(text, 'x', sizeof(text) - 1);
+    CU_ASSERT_TRUE(cJSON_Compare(expected, copy, 1));
+    cJSON_Delete(copy);
+
+    // With a context nothing is left for cJSON_Delete
+    cJSON_Context *context = cJSON_CreateContext();
+    memcpy(text, original, sizeof(text));
+    root = cJSON_ParseWithContext(context, text, sizeof(text), NULL, CJSON_PARSE_IN_SITU);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(root);
+    CU_ASSERT_TRUE(cJSON_Compare(expected, root, 1));
+    CU_ASSERT_PTR_EQUAL(cJSON_GetObjectItem(root, "name")->valuestring, text + 10);
+    cJSON_DeleteContext(context);
+
+    // A failed parse frees what it decoded
+    char invalid[] = "[\"a\", \"b\\n\", {\"c\": }]";
+    CU_ASSERT_PTR_NULL(cJSON_ParseWithFlags(invalid, sizeof(invalid), NULL, CJSON_PARSE_IN_SITU));
+
+    cJSON_Delete(expected);
+}
+
+void test_objectIndex(void) {
+    char key[16];
+    cJSON *object = cJSON_CreateObject();
+    for (int i = 0; i < 40; ++i) {
+        snprintf(key, sizeof(key), "k%d", i);
+        cJSON_AddNumberToObject(object, key, i);
+    }
+    cJSON *first = cJSON_AddNumberToObject(object, "Dup", 1);
+    cJSON *second = cJSON_AddNumberToObject(object, "dup", 2);
+    cJSON_SetObjectIndexThreshold(8);
+
+    // The same members as the linear scan, including the first of names that differ in case
+    for (int i = 0; i < 40; ++i) {
+        snprintf(key, sizeof(key), "K%d", i);
+        CU_ASSERT_EQUAL(cJSON_GetObjectItem(object, key)->valueint, i);
+        CU_ASSERT_PTR_NULL(cJSON_GetObjectItemCaseSensitive(object, key));
+    }
+    CU_ASSERT_PTR_NOT_NULL(object->index);
+    CU_ASSERT_PTR_EQUAL(cJSON_GetObjectItem(object, "DUP"), first);
+    CU_ASSERT_PTR_EQUAL(cJSON_GetObjectItemCaseSensitive(object, "dup"), second);
+    CU_ASSERT_PTR_NULL(cJSON_GetObjectItem(object, "k40"));
+
+    // Changes to the members show up in the lookups
+    cJSON *added = cJSON_AddStringToObject(object, "added", "x");
+    CU_ASSERT_PTR_EQUAL(cJSON_GetObjectItem(object, "ADDED"), added);
+    cJSON_Delete(cJSON_DetachItemFromObject(object, "Dup"));
+    CU_ASSERT_PTR_EQUAL(cJSON_GetObjectItem(object, "DUP"), second);
+    cJSON *inserted = cJSON_CreateNumber(-5);
+    inserted->string = cJSON_malloc(3);
+    strcpy(inserted->string, "k5");
+    CU_ASSERT_TRUE(cJSON_InsertItemInArray(object, 0, inserted));
+    CU_ASSERT_PTR_EQUAL(cJSON_GetObjectItem(object, "k5"), inserted);
+    CU_ASSERT_TRUE(cJSON_ReplaceItemInObject(object, "k7", cJSON_CreateString("seven")));
+    CU_ASSERT_STRING_EQUAL(cJSON_GetObjectItem(object, "k7")->valuestring, "seven");
+    for (int i = 0; i < 100; ++i) {
+        snprintf(key, sizeof(key), "more%d", i);
+        cJSON_AddNumberToObject(object, key, i);
+        CU_ASSERT_EQUAL(cJSON_GetObjectItem(object, key)->valueint, i);
+    }
+
+    // References share the members and keep using the scan, copies get their own index
+    cJSON *reference = cJSON_CreateObjectReference(object->child);
+    cJSON *copy = cJSON_Duplicate(object, 1);
+    CU_ASSERT_EQUAL(cJSON_GetObjectItem(reference, "more99")->valueint, 99);
+    CU_ASSERT_PTR_NULL(reference->index);
+    CU_ASSERT_EQUAL(cJSON_GetObjectItem(copy, "k39")->valueint, 39);
+    CU_ASSERT_TRUE(copy->index != object->index);
+    cJSON_Delete(reference);
+    cJSON_Delete(copy);
+    cJSON_Delete(object);
+
+    // Pooled objects take their index from the context
+    char *text = cJSON_malloc(1024);
+    size_t length = 0;
+    text[length++] = '{';
+    for (int i = 0; i < 30; ++i) {
+        length += (size_t)snprintf(text + length, 1024 - length, "%s\"k%d\": %d", i ? ", " : "", i, i);
+    }
+    strcpy(text + length, "}");
+    cJSON_Context *context = cJSON_CreateContext();
+    for (int round = 0; round < 2; ++round) {
+        cJSON *pooled = cJSON_ParseWithContext(context, text, strlen(text), NULL, 0);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(pooled);
+        CU_ASSERT_EQUAL(cJSON_GetObjectItem(pooled, "k29")->valueint, 29);
+        cJSON_AddNumberToObject(pooled, "k30", 30);
+        cJSON_Delete(cJSON_DetachItemFromObject(pooled, "k0"));
+        CU_ASSERT_PTR_NULL(cJSON_GetObjectItem(pooled, "k0"));
+        CU_ASSERT_EQUAL(cJSON_GetObjectItem(pooled, "k30")->valueint, 30);
+        cJSON_Delete(pooled);
+        cJSON_ResetContext(context);
+    }
+    cJSON_DeleteContext(context);
+    cJSON_free(text);
+
+    cJSON_SetObjectIndexThreshold(0);
+}
+
+void test_arrayIndex(void) {
+    cJSON *array = cJSON_CreateArray();
+    for (int i = 0; i < 100; ++i) {
+        cJSON_AddItemToArray(array, cJSON_CreateNumber(i));
+    }
+    cJSON_SetArrayIndexThreshold(8);
+
+    // Items close to the start are walked to, further ones build the vector
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(array, 3)->valueint, 3);
+    CU_ASSERT_PTR_NULL(array->index);
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(array), 100);
+    CU_ASSERT_PTR_NOT_NULL(array->index);
+    for (int i = 0; i < 100; ++i) {
+        CU_ASSERT_EQUAL(cJSON_GetArrayItem(array, i)->valueint, i);
+    }
+    CU_ASSERT_PTR_NULL(cJSON_GetArrayItem(array, 100));
+
+    // Changes show up in the size and the items
+    cJSON_AddItemToArray(array, cJSON_CreateNumber(100));
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(array), 101);
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(array, 100)->valueint, 100);
+    cJSON_DeleteItemFromArray(array, 100);
+    cJSON_DeleteItemFromArray(array, 50);
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(array), 99);
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(array, 50)->valueint, 51);
+    CU_ASSERT_TRUE(cJSON_InsertItemInArray(array, 10, cJSON_CreateNumber(-1)));
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(array, 10)->valueint, -1);
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(array, 11)->valueint, 10);
+    CU_ASSERT_TRUE(cJSON_ReplaceItemInArray(array, 20, cJSON_CreateNumber(-2)));
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(array, 20)->valueint, -2);
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(array), 100);
+    while (cJSON_GetArraySize(array) > 0) {
+        cJSON_DeleteItemFromArray(array, cJSON_GetArraySize(array) - 1);
+    }
+    cJSON_AddItemToArray(array, cJSON_CreateNumber(7));
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(array), 1);
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(array, 0)->valueint, 7);
+
+    // Objects count their members with a hash index they already have
+    cJSON_SetObjectIndexThreshold(8);
+    cJSON *object = cJSON_CreateObject();
+    char key[16];
+    for (int i = 0; i < 20; ++i) {
+        snprintf(key, sizeof(key), "k%d", i);
+        cJSON_AddNumberToObject(object, key, i);
+    }
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(object), 20);
+    CU_ASSERT_PTR_NULL(object->index);
+    CU_ASSERT_PTR_NOT_NULL(cJSON_GetObjectItem(object, "k3"));
+    cJSON_Delete(cJSON_DetachItemFromObject(object, "k3"));
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(object), 19);
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(object, 3)->valueint, 4);
+    cJSON_Delete(object);
+    cJSON_SetObjectIndexThreshold(0);
+
+    // Pooled arrays take their vector from the context
+    const char *text = "[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19]";
+    cJSON_Context *context = cJSON_CreateContext();
+    cJSON *pooled = cJSON_ParseWithContext(context, text, strlen(text), NULL, 0);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(pooled);
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(pooled, 19)->valueint, 19);
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(pooled), 20);
+    cJSON *reference = cJSON_CreateArrayReference(pooled->child);
+    CU_ASSERT_EQUAL(cJSON_GetArrayItem(reference, 12)->valueint, 12);
+    CU_ASSERT_PTR_NULL(reference->index);
+    cJSON_Delete(reference);
+    cJSON_DeleteContext(context);
+
+    cJSON_Delete(array);
+    cJSON_SetArrayIndexThreshold(0);
+}
+
+void test_packedArray(void) {
+    const char *text = "{\"series\": [1, -2.5, 3e3, 0.1], \"mixed\": [1, \"a\"], \"empty\": [], \"nested\": [[1, 2], [3]]}";
+    cJSON *expected = cJSON_Parse(text);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(expected);
+
+    // Arrays of nothing but numbers are packed, the others are not, and the text is the same
+    cJSON *root = cJSON_ParseWithFlags(text, strlen(text) + 1, NULL, CJSON_PARSE_PACK_NUMBERS);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(root);
+    cJSON *series = cJSON_GetObjectItem(root, "series");
+    int count = 0;
+    double *numbers = cJSON_GetPackedNumbers(series, &count);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(numbers);
+    CU_ASSERT_EQUAL(count, 4);
+    CU_ASSERT_DOUBLE_EQUAL(numbers[2], 3000.0, 0.0);
+    CU_ASSERT_TRUE(cJSON_IsArray(series));
+    CU_ASSERT_PTR_NULL(series->child);
+    CU_ASSERT_PTR_NULL(cJSON_GetPackedNumbers(cJSON_GetObjectItem(root, "mixed"), NULL));
+    CU_ASSERT_PTR_NULL(cJSON_GetPackedNumbers(cJSON_GetObjectItem(root, "empty"), NULL));
+    CU_ASSERT_PTR_NOT_NULL(cJSON_GetPackedNumbers(cJSON_GetArrayItem(cJSON_GetObjectItem(root, "nested"), 1), NULL));
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(series), 4);
+    CU_ASSERT_TRUE(cJSON_Compare(expected, root, 1));
+    CU_ASSERT_TRUE(cJSON_Compare(root, expected, 1));
+    char *printed = cJSON_PrintUnformatted(root);
+    char *expected_printed = cJSON_PrintUnformatted(expected);
+    CU_ASSERT_STRING_EQUAL(printed, expected_printed);
+    cJSON_free(printed);
+    cJSON_free(expected_printed);
+
+    // Copies stay packed, a change to the numbers shows in the text
+    cJSON *copy = cJSON_Duplicate(series, 1);
+    CU_ASSERT_PTR_NOT_NULL(cJSON_GetPackedNumbers(copy, NULL));
+    CU_ASSERT_TRUE(cJSON_Compare(copy, series, 1));
+    cJSON_GetPackedNumbers(copy, NULL)[0] = 7;
+    printed = cJSON_PrintUnformatted(copy);
+    CU_ASSERT_STRING_EQUAL(printed, "[7,-2.5,3000,0.1]");
+    cJSON_free(printed);
+    CU_ASSERT_FALSE(cJSON_Compare(copy, series, 1));
+    cJSON_Delete(copy);
+
+    // Reading leaves it packed: there are no items until it is unpacked explicitly
+    CU_ASSERT_PTR_NULL(cJSON_GetArrayItem(series, 1));
+    cJSON_ArrayCursor cursor;
+    CU_ASSERT_FALSE(cJSON_ArrayCursorInit(&cursor, series));
+    CU_ASSERT_PTR_NULL(cJSON_ArrayCursorNext(&cursor));
+    CU_ASSERT_PTR_NOT_NULL(cJSON_GetPackedNumbers(series, NULL));
+    CU_ASSERT_TRUE(cJSON_UnpackArray(series));
+    CU_ASSERT_PTR_NULL(cJSON_GetPackedNumbers(series, NULL));
+    CU_ASSERT_TRUE(cJSON_ArrayCursorInit(&cursor, series));
+    cJSON *first = cJSON_ArrayCursorNext(&cursor);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(first);
+    CU_ASSERT_DOUBLE_EQUAL(first->valuedouble, 1.0, 0.0);
+    CU_ASSERT_DOUBLE_EQUAL(cJSON_GetArrayItem(series, 1)->valuedouble, -2.5, 0.0);
+
+    // Changes by position unpack it first and work as on any array
+    const double small[] = { 1, 2, 3 };
+    cJSON *replaced = cJSON_CreatePackedArray(small, 3);
+    CU_ASSERT_TRUE(cJSON_ReplaceItemInArray(replaced, 1, cJSON_CreateString("two")));
+    CU_ASSERT_TRUE(cJSON_InsertItemInArray(replaced, 0, cJSON_CreateNumber(0)));
+    cJSON_DeleteItemFromArray(replaced, 3);
+    printed = cJSON_PrintUnformatted(replaced);
+    CU_ASSERT_STRING_EQUAL(printed, "[0,1,\"two\"]");
+    cJSON_free(printed);
+    cJSON_Delete(replaced);
+    cJSON_AddItemToArray(cJSON_GetArrayItem(cJSON_GetObjectItem(root, "nested"), 0), cJSON_CreateString("x"));
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(cJSON_GetArrayItem(cJSON_GetObjectItem(root, "nested"), 0)), 3);
+    cJSON_Delete(root);
+
+    // Built from numbers, and parsed into a context with the numbers and items unpacked from it
+    const double values[] = { 1, 2.25, -3 };
+    cJSON *packed = cJSON_CreatePackedArray(values, 3);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(cJSON_GetPackedNumbers(packed, NULL));
+    cJSON_Context *context = cJSON_CreateContext();
+    cJSON *pooled = cJSON_ParseWithContext(context, "[1, 2.25, -3]", 13, NULL, CJSON_PARSE_PACK_NUMBERS);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(cJSON_GetPackedNumbers(pooled, NULL));
+    CU_ASSERT_TRUE(cJSON_Compare(packed, pooled, 1));
+    CU_ASSERT_TRUE(cJSON_UnpackArray(pooled));
+    CU_ASSERT_TRUE(cJSON_GetArrayItem(pooled, 2)->type & cJSON_IsPooled);
+    CU_ASSERT_TRUE(cJSON_Compare(packed, pooled, 1));
+    cJSON_DeleteContext(context);
+    cJSON_Delete(packed);
+    cJSON *empty = cJSON_CreatePackedArray(values, 0);
+    CU_ASSERT_EQUAL(cJSON_GetArraySize(empty), 0);
+    CU_ASSERT_PTR_NULL(cJSON_GetPackedNumbers(empty, NULL));
+    cJSON_Delete(empty);
+
+    cJSON_Delete(expected);
+}
+
+// Collects the pieces of a streamed print and counts them
+typedef struct {
+    char text[4096];
+    size_t length;
+    int pieces;
+} PrintSink;
+
+static cJSON_bool collectPiece(void *target, const char *text, size_t length) {
+    PrintSink *sink = target;
+    if (sink->length + length >= sizeof(sink->text)) return 0;
+    memcpy(sink->text + sink->length, text, length);
+    sink->length += length;
+    sink->text[sink->length] = '\0';
+    sink->pieces++;
+    return 1;
+}
+
+static cJSON_bool failPiece(void *target, const char *text, size_t length) {
+    (void)target;
+    (void)text;
+    (void)length;
+    return 0;
+}
+
+// Read back a whole temporary file
+static char *readStream(FILE *file) {
+    fflush(file);
+    long size = ftell(file);
+    char *text = malloc((size_t)size + 1);
+    rewind(file);
+    text[fread(text, 1, (size_t)size, file)] = '\0';
+    return text;
+}
+
+void test_printStreamed(void) {
+    const char *text = "{\"people\": [{\"id\": 1, \"name\": \"Jane \\\"JD\\\" Doe\", \"salary\": 30000.5, \"tags\": [\"a\", []]},"
+                       " {\"id\": 2, \"note\": \"a string that is longer than the whole sixteen byte buffer\", \"series\": [1, 2.5, 3]}]}";
+    cJSON *root = cJSON_ParseWithFlags(text, strlen(text) + 1, NULL, CJSON_PARSE_PACK_NUMBERS);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(root);
+
+    // In pieces of a small buffer the text is the same as printed at once, formatted or not
+    for (int format = 0; format < 2; ++format) {
+        char *expected = format ? cJSON_Print(root) : cJSON_PrintUnformatted(root);
+        PrintSink sink = { "", 0, 0 };
+        CU_ASSERT_TRUE(cJSON_PrintStreamed(root, format, 16, collectPiece, &sink));
+        CU_ASSERT_STRING_EQUAL(sink.text, expected);
+        CU_ASSERT_TRUE(sink.pieces > 5);
+        cJSON_free(expected);
+    }
+
+    // A failing writer stops the print
+    CU_ASSERT_FALSE(cJSON_PrintStreamed(root, 1, 16, failPiece, NULL));
+    CU_ASSERT_FALSE(cJSON_PrintStreamed(root, 1, 1, collectPiece, NULL));
+
+    // Into a file and a file descriptor
+    char *expected = cJSON_Print(root);
+    FILE *file = tmpfile();
+    CU_ASSERT_PTR_NOT_NULL_FATAL(file);
+    CU_ASSERT_TRUE(cJSON_PrintToFile(root, file, 1));
+    char *written = readStream(file);
+    CU_ASSERT_STRING_EQUAL(written, expected);
+    free(written);
+    fclose(file);
+
+    file = tmpfile();
+    CU_ASSERT_PTR_NOT_NULL_FATAL(file);
+    CU_ASSERT_TRUE(cJSON_PrintToFd(root, fileno(file), 1));
+    fseek(file, 0, SEEK_END);
+    written = readStream(file);
+    CU_ASSERT_STRING_EQUAL(written, expected);
+    free(written);
+    fclose(file);
+    CU_ASSERT_FALSE(cJSON_PrintToFd(root, -1, 1));
+
+    cJSON_free(expected);
+    cJSON_Delete(root);
+}
+
+void test_parseJsonIndexed(void) {
+    const char *documents[] = {
+        "{\"people\": [{\"id\": 1, \"name\": \"Jane Doe\", \"salary\": 30000.5}]}",
+        "[1, -2.5e3, true, false, null, \"\", [], {}, [[{\"a\": []}]]]",
+        // escaped quotes and backslash runs, some of them across a 64 byte block edge
+        "{\"s\": \"a\\\"b\\\\\", \"t\": \"..............................................\\\\\\\"}\"}",
+        "[\"\\u00e9\\ud83d\\ude00\\n\\/\"]",
+        "\xEF\xBB\xBF  \"bom\"  ",
+        "  42  "
+    };
+    const char *invalid[] = {
+        "", "   ", "{", "[1,]", "{\"a\" 1}", "{\"a\": 1,}", "[1 2]", "\"open",
+        "[\"a\"x]", "[tru]", "[01x]", "[\"\\q\"]", "[\"\\ud800\"]", "{} {}", "]"
+    };
+    int levels = cJSON_GetSimdLevel() + 1;
+
+    // Every SIMD level builds the same tree as cJSON
+    for (int level = 0; level < levels; ++level) {
+        cJSON_SetSimdLevel(level);
+        for (size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); ++i) {
+            size_t error_offset = 0;
+            cJSON *expected = cJSON_Parse(documents[i]);
+            cJSON *actual = parseJsonIndexed(documents[i], strlen(documents[i]), &error_offset);
+            CU_ASSERT_PTR_NOT_NULL_FATAL(expected);
+            CU_ASSERT_PTR_NOT_NULL_FATAL(actual);
+            CU_ASSERT_TRUE(cJSON_Compare(expected, actual, 1));
+            cJSON_Delete(expected);
+            cJSON_Delete(actual);
+        }
+        for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+            size_t error_offset = 0;
+            CU_ASSERT_PTR_NULL(parseJsonIndexed(invalid[i], strlen(invalid[i]), &error_offset));
+            CU_ASSERT_TRUE(error_offset <= strlen(invalid[i]));
+        }
+    }
+    cJSON_SetSimdLevel(CJSON_SIMD_AUTO);
+
+    // Stage 1 alone: the offsets of every token, strings are found by their opening quote
+    const char *json = "{\"a\": [1, \"x,\\\"]\"], \"b\": null}";
+    const uint32_t expected_positions[] = { 0, 1, 4, 6, 7, 8, 10, 17, 18, 20, 23, 25, 29 };
+    size_t count = sizeof(expected_positions) / sizeof(expected_positions[0]);
+    size_t error_offset = 0;
+    JsonIndex index;
+    CU_ASSERT_TRUE_FATAL(buildJsonIndex(json, strlen(json), &index, &error_offset));
+    CU_ASSERT_EQUAL_FATAL(index.count, count);
+    for (size_t i = 0; i < count; ++i) {
+        CU_ASSERT_EQUAL(index.positions[i], expected_positions[i]);
+    }
+    freeJsonIndex(&index);
+
+    // An unterminated string is caught by stage 1
+    CU_ASSERT_FALSE(buildJsonIndex("[\"abc]", 6, &index, &error_offset));
+    CU_ASSERT_EQUAL(error_offset, 6);
+}
+
+void test_parseValueText(void) {
+    Value value;
+
+    CU_ASSERT_EQUAL(parseValueText("42", &value), 1);
+    CU_ASSERT_EQUAL(value.type, VALUE_INT);
+    CU_ASSERT_EQUAL(value.as.integer, 42);
+
+    // Integers are exact up to 2^53, beyond that they are doubles like the numbers cJSON parses
+    CU_ASSERT_EQUAL(parseValueText("-9007199254740992", &value), 1);
+    CU_ASSERT_EQUAL(value.type, VALUE_INT);
+    CU_ASSERT_EQUAL(value.as.integer, -9007199254740992LL);
+    CU_ASSERT_EQUAL(parseValueText("9007199254740993", &value), 1);
+    CU_ASSERT_EQUAL(value.type, VALUE_DOUBLE);
+    CU_ASSERT_EQUAL(numberValue(9007199254740992.0).type, VALUE_INT);
+    CU_ASSERT_EQUAL(numberValue(1e17).type, VALUE_DOUBLE);
+
+    CU_ASSERT_EQUAL(parseValueText("-0.5", &value), 1);
+    CU_ASSERT_EQUAL(value.type, VALUE_DOUBLE);
+    CU_ASSERT_DOUBLE_EQUAL(value.as.number, -0.5, 0.0);
+
+    CU_ASSERT_EQUAL(parseValueText("true", &value), 1);
+    CU_ASSERT_EQUAL(value.type, VALUE_BOOL);
+    CU_ASSERT_EQUAL(value.as.boolean, 1);
+
+    CU_ASSERT_EQUAL(parseValueText("null", &value), 1);
+    CU_ASSERT_EQUAL(value.type, VALUE_NULL);
+
+    // Anything that is not completely a number stays text
+    CU_ASSERT_EQUAL(parseValueText("21abc", &value), 1);
+    CU_ASSERT_EQUAL(value.type, VALUE_STRING);
+    CU_ASSERT_STRING_EQUAL(value.as.string, "21abc");
+    freeValue(&value);
+    CU_ASSERT_EQUAL(value.type, VALUE_NULL);
+}
+
+
+// Value stored under key, the test fails when it is missing
+static Value *findTestValue(KeyValueList *list, const char *key) {
+    KeyValue *kv = findKeyValue(list, findKeyID(key));
+    if (!kv) {
+        CU_FAIL_FATAL("key not found");
+        return NULL;
+    }
+    return &kv->value;
+}
+
+void test_typedValues(void) {
+    // Every JSON type survives a load/save/load cycle
+    const char *filename = "test_typed.json";
+    FILE *fp = fopen(filename, "w");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(fp);
+    fprintf(fp, "{\"people\": [{\"id\": 1, \"tags\": [\"a\", 1], \"ok\": true, \"none\": null, \"pi\": 3.25, \"n\": 7, \"s\": \"x\", "
+                "\"series\": [1.5, 2, -300]}]}");
+    fclose(fp);
+
+    for (int round = 0; round < 2; ++round) {
+        int num_people = 0;
+        Person *people = loadData(filename, &num_people);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+        CU_ASSERT_EQUAL_FATAL(num_people, 1);
+
+        Value *value = findTestValue(&people[0].data, "s");
+        CU_ASSERT_EQUAL_FATAL(value->type, VALUE_STRING);
+        CU_ASSERT_STRING_EQUAL(value->as.string, "x");
+        value = findTestValue(&people[0].data, "n");
+        CU_ASSERT_EQUAL(value->type, VALUE_INT);
+        CU_ASSERT_EQUAL(value->as.integer, 7);
+        value = findTestValue(&people[0].data, "pi");
+        CU_ASSERT_EQUAL(value->type, VALUE_DOUBLE);
+        CU_ASSERT_DOUBLE_EQUAL(value->as.number, 3.25, 0.0);
+        value = findTestValue(&people[0].data, "none");
+        CU_ASSERT_EQUAL(value->type, VALUE_NULL);
+        value = findTestValue(&people[0].data, "ok");
+        CU_ASSERT_EQUAL(value->type, VALUE_BOOL);
+        CU_ASSERT_EQUAL(value->as.boolean, 1);
+        value = findTestValue(&people[0].data, "tags");
+        CU_ASSERT_EQUAL_FATAL(value->type, VALUE_JSON);
+        CU_ASSERT_EQUAL(cJSON_GetArraySize(value->as.json), 2);
+        value = findTestValue(&people[0].data, "series");
+        CU_ASSERT_EQUAL_FATAL(value->type, VALUE_JSON);
+        // The loaders do not pack numbers, so callers can walk the items of the array
+        CU_ASSERT_PTR_NULL(cJSON_GetPackedNumbers(value->as.json, NULL));
+        CU_ASSERT_PTR_NOT_NULL_FATAL(value->as.json->child);
+        CU_ASSERT_EQUAL(cJSON_GetArraySize(value->as.json), 3);
+        CU_ASSERT_DOUBLE_EQUAL(cJSON_GetArrayItem(value->as.json, 2)->valuedouble, -300.0, 0.0);
+
+        saveData(filename, people, num_people);
+        freePeople(people, num_people);
+    }
+    remove(filename);
+}
+
+
 void test_addNewData() {
     int num_people = 0;
 
     // Initialize test data
     Person *people = loadData("./tests/testLoadData.json", &num_people);
+    PersonIndex index = { NULL, 0, 0, 0 };
+    buildPersonIndex(&index, people, num_people);
 
     // Fake user input in terminals
-    provideInput("Most\nwaiter\n21000\ngaming\n21\nJames\n");
+    provideInput("James\n21\ngaming\n21000\nwaiter\nMost\n");
 
     // Call the function
-    addNewData(&people, &num_people);
+    addNewData(&people, &num_people, &index);
 
     // Verify the result
     CU_ASSERT_EQUAL(num_people, 3);
     CU_ASSERT_PTR_NOT_NULL(people);
-    CU_ASSERT_PTR_NOT_NULL(people[2].data);   
+    CU_ASSERT_EQUAL(people[2].data.count, 6);   
     
     // Verify keys
-    CU_ASSERT_STRING_EQUAL(people[2].data->key, "name");
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->key, "age");
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->next->key, "hobby");
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->next->next->key, "salary");
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->next->next->next->key, "job");
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->next->next->next->next->key, "address");
+    CU_ASSERT_STRING_EQUAL(keyName(people[2].data.items[0].key_id), "name");
+    CU_ASSERT_STRING_EQUAL(keyName(people[2].data.items[1].key_id), "age");
+    CU_ASSERT_STRING_EQUAL(keyName(people[2].data.items[2].key_id), "hobby");
+    CU_ASSERT_STRING_EQUAL(keyName(people[2].data.items[3].key_id), "salary");
+    CU_ASSERT_STRING_EQUAL(keyName(people[2].data.items[4].key_id), "job");
+    CU_ASSERT_STRING_EQUAL(keyName(people[2].data.items[5].key_id), "address");
 
     // Verify values
-    CU_ASSERT_STRING_EQUAL(people[2].data->value, "James");
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->value, "21");
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->next->value, "gaming");
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->next->next->value, "21000");
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->next->next->next->value, "waiter");
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->next->next->next->next->value, "Most");
-
-    for (int i = 0; i < num_people; ++i) {
-        freeKeyValueList(&(people[i].data));
-    }
-    free(people);
+    CU_ASSERT_STRING_EQUAL(people[2].data.items[0].value.as.string, "James");
+    CU_ASSERT_EQUAL(people[2].data.items[1].value.type, VALUE_INT);
+    CU_ASSERT_EQUAL(people[2].data.items[1].value.as.integer, 21);
+    CU_ASSERT_STRING_EQUAL(people[2].data.items[2].value.as.string, "gaming");
+    CU_ASSERT_EQUAL(people[2].data.items[3].value.type, VALUE_INT);
+    CU_ASSERT_EQUAL(people[2].data.items[3].value.as.integer, 21000);
+    CU_ASSERT_STRING_EQUAL(people[2].data.items[4].value.as.string, "waiter");
+    CU_ASSERT_STRING_EQUAL(people[2].data.items[5].value.as.string, "Most");
+
+    freePersonIndex(&index);
+    freePeople(people, num_people);
 }
 
 
@@ -158,48 +1388,55 @@ void test_modifyDataBasedOnID() {
     }
     for (int i = 0; i < num_people; ++i) {
         people[i].id = i + 1;
-        people[i].data = NULL;
+        memset(&people[i].data, 0, sizeof(people[i].data));
+        people[i].arena = NULL;
         addKeyValue(&(people[i].data), "Name", "John");
         addKeyValue(&(people[i].data), "Age", "30");
         addKeyValue(&(people[i].data), "City", "Brno");
     }
+    PersonIndex index = { NULL, 0, 0, 0 };
+    buildPersonIndex(&index, people, num_people);
 
     provideInput("1\n2\nName\nJane\n");
-    modifyDataBasedOnID(people, num_people);
+    modifyDataBasedOnID(people, num_people, &index);
 
     provideInput("2\n2\nAge\n31\n");
-    modifyDataBasedOnID(people, num_people);
+    modifyDataBasedOnID(people, num_people, &index);
 
     provideInput("3\n2\nCity\nPraha\n");
-    modifyDataBasedOnID(people, num_people);
+    modifyDataBasedOnID(people, num_people, &index);
 
     provideInput("4\n1\n5\n");
-    modifyDataBasedOnID(people, num_people);    
+    modifyDataBasedOnID(people, num_people, &index);
 
-    CU_ASSERT_STRING_EQUAL(people[0].data->next->next->value, "Jane");
-    CU_ASSERT_STRING_EQUAL(people[0].data->next->value, "30");
-    CU_ASSERT_STRING_EQUAL(people[0].data->value, "Brno");
+    CU_ASSERT_STRING_EQUAL(people[0].data.items[0].value.as.string, "Jane");
+    CU_ASSERT_STRING_EQUAL(people[0].data.items[1].value.as.string, "30");
+    CU_ASSERT_STRING_EQUAL(people[0].data.items[2].value.as.string, "Brno");
     CU_ASSERT_EQUAL(people[0].id, 1);
 
-    CU_ASSERT_STRING_EQUAL(people[1].data->next->next->value, "John");
-    CU_ASSERT_STRING_EQUAL(people[1].data->next->value, "31");
-    CU_ASSERT_STRING_EQUAL(people[1].data->value, "Brno");
+    CU_ASSERT_STRING_EQUAL(people[1].data.items[0].value.as.string, "John");
+    CU_ASSERT_EQUAL(people[1].data.items[1].value.type, VALUE_INT);
+    CU_ASSERT_EQUAL(people[1].data.items[1].value.as.integer, 31);
+    CU_ASSERT_STRING_EQUAL(people[1].data.items[2].value.as.string, "Brno");
     CU_ASSERT_EQUAL(people[1].id, 2);
 
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->next->value, "John");
-    CU_ASSERT_STRING_EQUAL(people[2].data->next->value, "30");
-    CU_ASSERT_STRING_EQUAL(people[2].data->value, "Praha");
+    CU_ASSERT_STRING_EQUAL(people[2].data.items[0].value.as.string, "John");
+    CU_ASSERT_STRING_EQUAL(people[2].data.items[1].value.as.string, "30");
+    CU_ASSERT_STRING_EQUAL(people[2].data.items[2].value.as.string, "Praha");
     CU_ASSERT_EQUAL(people[2].id, 3);
 
-    CU_ASSERT_STRING_EQUAL(people[3].data->next->next->value, "John");
-    CU_ASSERT_STRING_EQUAL(people[3].data->next->value, "30");
-    CU_ASSERT_STRING_EQUAL(people[3].data->value, "Brno");
+    CU_ASSERT_STRING_EQUAL(people[3].data.items[0].value.as.string, "John");
+    CU_ASSERT_STRING_EQUAL(people[3].data.items[1].value.as.string, "30");
+    CU_ASSERT_STRING_EQUAL(people[3].data.items[2].value.as.string, "Brno");
     CU_ASSERT_EQUAL(people[3].id, 5);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 4), -1);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 5), 3);
 
 
     for (int i = 0; i < num_people; ++i) {
         freeKeyValueList(&(people[i].data));
     }
+    freePersonIndex(&index);
     free(people);
 }
 
@@ -211,8 +1448,10 @@ void test_saveData() {
 
     // Initialize test data
     Person *people = loadData("./tests/testLoadData.json", &num_people);
+    PersonIndex index = { NULL, 0, 0, 0 };
+    buildPersonIndex(&index, people, num_people);
     provideInput("2\n2\nname\nJames\n");
-    modifyDataBasedOnID(people, num_people);
+    modifyDataBasedOnID(people, num_people, &index);
 
     // Call the function
     saveData(filename, people, num_people);
@@ -260,6 +1499,85 @@ void test_saveData() {
     // Clean up
     free(buffer);
     free(expected_buffer);
+    freePersonIndex(&index);
+    freePeople(people, num_people);
+}
+
+
+// What saveData wrote before it had writePeopleJSON: cJSON_Print of a tree of valueToJSON items
+static char *printPeopleTree(const Person *people, int num_people) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON *array = cJSON_AddArrayToObject(root, "people");
+    for (int i = 0; i < num_people; ++i) {
+        cJSON *person_json = cJSON_CreateObject();
+        cJSON_AddNumberToObject(person_json, "id", people[i].id);
+        for (int j = 0; j < people[i].data.count; ++j) {
+            cJSON_AddItemToObjectCS(person_json, keyName(people[i].data.items[j].key_id),
+                                    valueToJSON(&people[i].data.items[j].value));
+        }
+        cJSON_AddItemToArray(array, person_json);
+    }
+    char *text = cJSON_Print(root);
+    cJSON_Delete(root);
+    return text;
+}
+
+void test_writePeopleJSON(void) {
+    Person people[2];
+    memset(people, 0, sizeof(people));
+    people[0].id = 7;
+    people[1].id = -3;
+
+    Value value;
+    stringValue("Jane \"JD\" Doe \\ \n\t\x01\x1f \xc3\xa9", &value);
+    addTypedKeyValue(&people[0].data, "name", value);
+    const int64_t integers[] = { 42, -2147483647 - 1, 5000000000LL };
+    for (int i = 0; i < 3; ++i) {
+        value.type = VALUE_INT;
+        value.as.integer = integers[i];
+        addTypedKeyValue(&people[0].data, i == 0 ? "age" : i == 1 ? "min" : "big", value);
+    }
+    const double doubles[] = { 0.1, 1e300, 3.0, -2.5e-7 };
+    for (int i = 0; i < 4; ++i) {
+        value.type = VALUE_DOUBLE;
+        value.as.number = doubles[i];
+        addTypedKeyValue(&people[1].data, i == 0 ? "a" : i == 1 ? "b" : i == 2 ? "c" : "d", value);
+    }
+    value.type = VALUE_BOOL;
+    value.as.boolean = 1;
+    addTypedKeyValue(&people[1].data, "we\"ird key", value);
+    value.type = VALUE_NULL;
+    addTypedKeyValue(&people[1].data, "nothing", value);
+
+    // Nested objects are indented for their depth, packed arrays print as arrays
+    const char *nested = "{\"list\": [1, {\"b\": \"x\"}, []], \"empty\": {}, \"series\": [1.5, 2]}";
+    value.type = VALUE_JSON;
+    value.as.json = cJSON_ParseWithFlags(nested, strlen(nested) + 1, NULL, CJSON_PARSE_PACK_NUMBERS);
+    addTypedKeyValue(&people[1].data, "nested", value);
+    value.as.json = cJSON_Parse("[true, {\"deep\": {\"er\": null}}]");
+    addTypedKeyValue(&people[0].data, "array", value);
+
+    // The same text as the tree printed by cJSON, with and without people, and the same echo
+    for (int num_people = 0; num_people <= 2; num_people += 2) {
+        char *expected = printPeopleTree(people, num_people);
+        FILE *file = tmpfile();
+        FILE *echo = tmpfile();
+        CU_ASSERT_PTR_NOT_NULL_FATAL(file);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(echo);
+        CU_ASSERT_TRUE(writePeopleJSON(file, echo, people, num_people));
+        char *written = readStream(file);
+        char *echoed = readStream(echo);
+        CU_ASSERT_STRING_EQUAL(written, expected);
+        CU_ASSERT_STRING_EQUAL(echoed, expected);
+        free(written);
+        free(echoed);
+        fclose(file);
+        fclose(echo);
+        cJSON_free(expected);
+    }
+
+    freeKeyValueList(&people[0].data);
+    freeKeyValueList(&people[1].data);
 }
 
 
@@ -275,12 +1593,15 @@ void test_deletePersonByID() {
     // Initialize test data
     for (int i = 0; i < num_people; ++i) {
         people[i].id = i + 1;
-        people[i].data = NULL; // Add your test data here
+        memset(&people[i].data, 0, sizeof(people[i].data)); // Add your test data here
+        people[i].arena = NULL;
     }
+    PersonIndex index = { NULL, 0, 0, 0 };
+    buildPersonIndex(&index, people, num_people);
 
     // Call the function to delete a person with ID 2
     int id_to_delete = 2;
-    deletePersonByID(people, &num_people, id_to_delete);
+    deletePersonByID(people, &num_people, &index, id_to_delete);
 
     // Person with ID 2 is deleted
     int found = 0;
@@ -294,7 +1615,11 @@ void test_deletePersonByID() {
     // There are two people left
     CU_ASSERT_EQUAL(num_people, 2);
 
+    CU_ASSERT_EQUAL(findPersonSlot(&index, id_to_delete), -1);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 3), 1);
+
     // Clean up
+    freePersonIndex(&index);
     free(people);
 }
 
@@ -304,13 +1629,13 @@ void test_printPersonData() {
     // Initialize test data
     Person person;
     person.id = 1;
-    person.data = (KeyValue *)malloc(sizeof(KeyValue));
-    person.data->key = strdup("Name");
-    person.data->value = strdup("John");
-    person.data->next = (KeyValue *)malloc(sizeof(KeyValue));
-    person.data->next->key = strdup("Age");
-    person.data->next->value = strdup("25");
-    person.data->next->next = NULL;
+    person.arena = NULL;
+    memset(&person.data, 0, sizeof(person.data));
+    addKeyValue(&person.data, "Name", "John");
+    Value age;
+    age.type = VALUE_INT;
+    age.as.integer = 25;
+    addTypedKeyValue(&person.data, "Age", age);
 
     FILE *output_file = freopen("test_printPersonData.txt", "w", stdout);
     if (output_file == NULL) {
@@ -344,12 +1669,223 @@ void test_printPersonData() {
     CU_ASSERT_STRING_EQUAL(buffer, "  Age: 25\n");
 
     fclose(fp);
-    
+    freeKeyValueList(&person.data);
+}
+
+
+void test_arena() {
+    size_t baseline = memTrackLiveBytes();
+
+    Arena *arena = arenaCreate();
+    CU_ASSERT_PTR_NOT_NULL_FATAL(arena);
+
+    // Small blocks are aligned and do not overlap
+    char *text = arenaStrdup(arena, "abc");
+    int64_t *number = arenaAlloc(arena, sizeof(int64_t));
+    CU_ASSERT_PTR_NOT_NULL_FATAL(text);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(number);
+    CU_ASSERT_EQUAL((uintptr_t)number % 8, 0);
+    *number = 42;
+    CU_ASSERT_STRING_EQUAL(text, "abc");
+
+    // Many blocks and one bigger than a chunk
+    int allocated = 1;
+    for (int i = 0; i < 100000; ++i) {
+        allocated = allocated && arenaAlloc(arena, 24) != NULL;
+    }
+    CU_ASSERT(allocated);
+    char *big = arenaAlloc(arena, 8 * 1024 * 1024);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(big);
+    memset(big, 1, 8 * 1024 * 1024);
+    CU_ASSERT_EQUAL(*number, 42);
+
+    // Trees handed to the arena are deleted with it
+    CU_ASSERT_EQUAL(arenaAdoptTree(arena, cJSON_Parse("[1, {\"a\": \"b\"}]")), 1);
+    arenaDestroy(arena);
+    CU_ASSERT_EQUAL(memTrackLiveBytes(), baseline);
+
+    // Loaded people share one arena, which lives as long as one of them
+    int num_people = 0;
+    Person *people = loadData("./tests/testLoadData.json", &num_people);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+    CU_ASSERT_PTR_NOT_NULL(people[0].arena);
+    CU_ASSERT_PTR_EQUAL(people[0].arena, people[1].arena);
+    PersonIndex index = { NULL, 0, 0, 0 };
+    buildPersonIndex(&index, people, num_people);
+
+    // Changed values go to the arena as well
+    provideInput("1\n2\nname\nJames\n");
+    modifyDataBasedOnID(people, num_people, &index);
+    CU_ASSERT_STRING_EQUAL(findTestValue(&people[0].data, "name")->as.string, "James");
+
+    deletePersonByID(people, &num_people, &index, 1);
+    CU_ASSERT_STRING_EQUAL(findTestValue(&people[0].data, "name")->as.string, "John Doe");
+    deletePersonByID(people, &num_people, &index, 2);
+    CU_ASSERT_EQUAL(num_people, 0);
+    freePersonIndex(&index);
+    freePeople(people, num_people);
+}
+
+
+void test_keyTable() {
+    // The same key always gets the same id, different keys different ids
+    int name = internKey("name");
+    CU_ASSERT(name >= 0);
+    CU_ASSERT_EQUAL(internKey("name"), name);
+    CU_ASSERT_NOT_EQUAL(internKey("Name"), name);
+    CU_ASSERT_STRING_EQUAL(keyName(name), "name");
+    CU_ASSERT_EQUAL(findKeyID("name"), name);
+    CU_ASSERT_EQUAL(findKeyID("no record uses this key"), -1);
+    CU_ASSERT_PTR_NULL(keyName(-1));
+    CU_ASSERT_PTR_NULL(keyName(keyCount()));
+
+    // Enough keys to grow the table several times
+    char key[32];
+    int first = keyCount();
+    for (int i = 0; i < 1000; ++i) {
+        sprintf(key, "generated_%d", i);
+        CU_ASSERT_EQUAL(internKey(key), first + i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        sprintf(key, "generated_%d", i);
+        CU_ASSERT_EQUAL(findKeyID(key), first + i);
+    }
+    CU_ASSERT_EQUAL(internKey("name"), name);
+
+    // All people share the stored key
+    int num_people = 0;
+    Person *people = loadData("./tests/testLoadData.json", &num_people);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+    CU_ASSERT_EQUAL(people[0].data.items[0].key_id, people[1].data.items[0].key_id);
+    freePeople(people, num_people);
+}
+
+
+void test_memoryCycles() {
+    // Everything a load allocates must be gone again after freePeople. The key table is
+    // shared and kept between loads, so it is filled once before the baseline is taken.
+    int num_warmup = 0;
+    Person *warmup = loadData("./tests/testLoadData.json", &num_warmup);
+    freePeople(warmup, num_warmup);
+    size_t baseline = memTrackLiveBytes();
+
+    for (int cycle = 0; cycle < 3; ++cycle) {
+        int num_people = 0;
+        Person *people = loadData("./tests/testLoadData.json", &num_people);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+        CU_ASSERT(memTrackLiveBytes() > baseline);
+
+        // Edits and appends are owned by the dataset as well
+        PersonIndex index = { NULL, 0, 0, 0 };
+        buildPersonIndex(&index, people, num_people);
+        provideInput("1\n2\nname\nJames\n");
+        modifyDataBasedOnID(people, num_people, &index);
+        provideInput("James\n21\ngaming\n21000\nwaiter\nMost\n");
+        addNewData(&people, &num_people, &index);
+        deletePersonByID(people, &num_people, &index, 2);
+
+        freePersonIndex(&index);
+        freePeople(people, num_people);
+        CU_ASSERT_EQUAL(memTrackLiveBytes(), baseline);
+
+        people = loadDataStreaming("./tests/testLoadData.json", &num_people);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+        freePeople(people, num_people);
+        CU_ASSERT_EQUAL(memTrackLiveBytes(), baseline);
+
+        LoadOptions options = { LOAD_INPUT_READ, LOAD_ENGINE_CJSON };
+        people = loadDataWithOptions("./tests/testLoadData.json", &num_people, &options);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+        freePeople(people, num_people);
+        CU_ASSERT_EQUAL(memTrackLiveBytes(), baseline);
+    }
+
+    // Failed loads leave nothing behind either
+    int num_people = 0;
+    CU_ASSERT_PTR_NULL(loadData("./tests/does_not_exist.json", &num_people));
+    CU_ASSERT_EQUAL(memTrackLiveBytes(), baseline);
+
+    memTrackReport(stderr, "after load/free cycles");
+}
+
+
+void test_findPersonSlot() {
+    int num_people = 0;
+    Person *people = loadData("./tests/testLoadData.json", &num_people);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(people);
+    PersonIndex index = { NULL, 0, 0, 0 };
+    CU_ASSERT_TRUE_FATAL(buildPersonIndex(&index, people, num_people));
+
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 1), 0);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 2), 1);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 3), -1);
+
+    // Changing an ID re-keys the index
+    provideInput("2\n1\n7\n");
+    modifyDataBasedOnID(people, num_people, &index);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 2), -1);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 7), 1);
+
+    // Deleting swaps the last person into the hole
+    deletePersonByID(people, &num_people, &index, 1);
+    CU_ASSERT_EQUAL(num_people, 1);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 1), -1);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 7), 0);
+
+    // New people are appended to the index
+    provideInput("James\n21\ngaming\n21000\nwaiter\nMost\n");
+    addNewData(&people, &num_people, &index);
+    CU_ASSERT_EQUAL(num_people, 2);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 2), 1);
+
+    freePersonIndex(&index);
+    freePeople(people, num_people);
+
+    // Every array has its own index, a new array at any address starts with a fresh one.
+    // Appends grow the table, deletes leave tombstones, and every miss stays a miss.
+    int count = 0;
+    Person *many = NULL;
+    index = (PersonIndex){ NULL, 0, 0, 0 };
+    for (int i = 0; i < 100; ++i) {
+        addNewData(&many, &count, &index); // no keys yet, so nothing is asked
+        CU_ASSERT_EQUAL(findPersonSlot(&index, i + 1), i);
+    }
+    for (int id = 2; id <= 100; id += 2) {
+        deletePersonByID(many, &count, &index, id);
+    }
+    CU_ASSERT_EQUAL(count, 50);
+    for (int id = 1; id <= 100; ++id) {
+        int slot = findPersonSlot(&index, id);
+        if (id % 2 == 0) {
+            CU_ASSERT_EQUAL(slot, -1);
+        } else {
+            CU_ASSERT_TRUE_FATAL(slot >= 0 && slot < count);
+            CU_ASSERT_EQUAL(many[slot].id, id);
+        }
+    }
+
+    // A shared ID gives the lowest slot, like a scan from the front, and deleting one
+    // of the two leaves the other findable
+    int slot3 = findPersonSlot(&index, 3), slot5 = findPersonSlot(&index, 5);
+    provideInput("3\n1\n5\n");
+    modifyDataBasedOnID(many, count, &index);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 3), -1);
+    CU_ASSERT_EQUAL(findPersonSlot(&index, 5), slot3 < slot5 ? slot3 : slot5);
+    deletePersonByID(many, &count, &index, 5);
+    int slot = findPersonSlot(&index, 5);
+    CU_ASSERT_TRUE_FATAL(slot >= 0 && slot < count);
+    CU_ASSERT_EQUAL(many[slot].id, 5);
+
+    freePersonIndex(&index);
+    freePeople(many, count);
 }
 
 
 // Main function that runs the tests
 int main() {
+    // Count cJSON's allocations too, before anything is parsed
+    memTrackInstallHooks();
+
     CU_initialize_registry();
 
     // Add a suite to the registry
@@ -363,17 +1899,43 @@ int main() {
     CU_add_test(suite, "test_addKeyValue", test_addKeyValue);
     CU_add_test(suite, "test_freeKeyValueList", test_freeKeyValueList);  
     CU_add_test(suite, "test_loadData", test_loadData); 
+    CU_add_test(suite, "test_loadDataWithOptions", test_loadDataWithOptions);
+    CU_add_test(suite, "test_loadDataStreaming", test_loadDataStreaming);
+    CU_add_test(suite, "test_loadDataParallel", test_loadDataParallel);
+    CU_add_test(suite, "test_loadDataColumnar", test_loadDataColumnar);
+    CU_add_test(suite, "test_arrayCursor", test_arrayCursor);
+    CU_add_test(suite, "test_parseStringSimd", test_parseStringSimd);
+    CU_add_test(suite, "test_parseNumber", test_parseNumber);
+    CU_add_test(suite, "test_printNumber", test_printNumber);
+    CU_add_test(suite, "test_printStringSimd", test_printStringSimd);
+    CU_add_test(suite, "test_minifySimd", test_minifySimd);
+    CU_add_test(suite, "test_parseStrictUtf8", test_parseStrictUtf8);
+    CU_add_test(suite, "test_parseContext", test_parseContext);
+    CU_add_test(suite, "test_parseInSitu", test_parseInSitu);
+    CU_add_test(suite, "test_objectIndex", test_objectIndex);
+    CU_add_test(suite, "test_arrayIndex", test_arrayIndex);
+    CU_add_test(suite, "test_packedArray", test_packedArray);
+    CU_add_test(suite, "test_printStreamed", test_printStreamed);
+    CU_add_test(suite, "test_parseJsonIndexed", test_parseJsonIndexed);
+    CU_add_test(suite, "test_parseValueText", test_parseValueText);
+    CU_add_test(suite, "test_typedValues", test_typedValues);
     CU_add_test(suite, "test_addNewData", test_addNewData);
     CU_add_test(suite, "test_modifyDataBasedOnID", test_modifyDataBasedOnID);
     CU_add_test(suite, "test_saveData", test_saveData);
+    CU_add_test(suite, "test_writePeopleJSON", test_writePeopleJSON);
     CU_add_test(suite, "test_deletePersonByID", test_deletePersonByID);
     CU_add_test(suite, "test_printPersonData", test_printPersonData);
+    CU_add_test(suite, "test_findPersonSlot", test_findPersonSlot);
+    CU_add_test(suite, "test_arena", test_arena);
+    CU_add_test(suite, "test_keyTable", test_keyTable);
+    CU_add_test(suite, "test_memoryCycles", test_memoryCycles);
 
     // Run all tests using the basic interface
     CU_basic_set_mode(CU_BRM_VERBOSE);
     CU_basic_run_tests();
 
     CU_cleanup_registry();
+    freeKeyTable();
 
     return CU_get_error();
 }
\ No newline at end of file